@@ -0,0 +1,71 @@
+#ifdef ENABLE_BENCHMARK
+#    include "StubFFX.hpp"
+
+#    include "Upscaler/FSR_Upscaler.hpp"
+
+#    include <ffx_upscale.h>
+
+uint64_t StubFFX::contextsCreated{};
+uint64_t StubFFX::dispatches{};
+
+ffxReturnCode_t StubFFX::createContext(ffxContext* context, ffxCreateContextDescHeader* desc, const ffxAllocationCallbacks* /*unused*/) {
+    if (context == nullptr || desc == nullptr) return FFX_API_RETURN_ERROR_PARAMETER;
+    *context = new uint64_t{++contextsCreated};
+    return FFX_API_RETURN_OK;
+}
+
+ffxReturnCode_t StubFFX::destroyContext(ffxContext* context, const ffxAllocationCallbacks* /*unused*/) {
+    if (context == nullptr || *context == nullptr) return FFX_API_RETURN_ERROR_PARAMETER;
+    delete static_cast<uint64_t*>(*context);
+    *context = nullptr;
+    return FFX_API_RETURN_OK;
+}
+
+ffxReturnCode_t StubFFX::configure(ffxContext* context, const ffxConfigureDescHeader* desc) {
+    if (context == nullptr || desc == nullptr) return FFX_API_RETURN_ERROR_PARAMETER;
+    return FFX_API_RETURN_OK;
+}
+
+ffxReturnCode_t StubFFX::query(ffxContext* /*unused*/, ffxQueryDescHeader* desc) {
+    if (desc == nullptr) return FFX_API_RETURN_ERROR_PARAMETER;
+    switch (desc->type) {
+        case FFX_API_QUERY_DESC_TYPE_UPSCALE_GETRENDERRESOLUTIONFROMQUALITYMODE: {
+            const auto& query = *reinterpret_cast<ffxQueryDescUpscaleGetRenderResolutionFromQualityMode*>(desc);
+            float ratio{1.0F};
+            switch (query.qualityMode) {
+                case FFX_UPSCALE_QUALITY_MODE_NATIVEAA: ratio = 1.0F; break;
+                case FFX_UPSCALE_QUALITY_MODE_QUALITY: ratio = 1.5F; break;
+                case FFX_UPSCALE_QUALITY_MODE_BALANCED: ratio = 1.7F; break;
+                case FFX_UPSCALE_QUALITY_MODE_PERFORMANCE: ratio = 2.0F; break;
+                case FFX_UPSCALE_QUALITY_MODE_ULTRA_PERFORMANCE: ratio = 3.0F; break;
+                default: return FFX_API_RETURN_ERROR_PARAMETER;
+            }
+            if (query.pOutRenderWidth != nullptr) *query.pOutRenderWidth = static_cast<uint32_t>(static_cast<float>(query.displayWidth) / ratio);
+            if (query.pOutRenderHeight != nullptr) *query.pOutRenderHeight = static_cast<uint32_t>(static_cast<float>(query.displayHeight) / ratio);
+            return FFX_API_RETURN_OK;
+        }
+        case FFX_API_QUERY_DESC_TYPE_UPSCALE_GPU_MEMORY_USAGE: {
+            // Roughly what a 1080p context costs, so that the context cache budget is exercised.
+            *reinterpret_cast<ffxQueryDescUpscaleGetGPUMemoryUsage*>(desc)->gpuMemoryUsageUpscaler = {.totalUsageInBytes = 96ULL * 1024ULL * 1024ULL, .aliasableUsageInBytes = 0U};
+            return FFX_API_RETURN_OK;
+        }
+        default: return FFX_API_RETURN_ERROR_UNKNOWN_DESCTYPE;
+    }
+}
+
+ffxReturnCode_t StubFFX::dispatch(ffxContext* context, const ffxDispatchDescHeader* desc) {
+    if (context == nullptr || *context == nullptr || desc == nullptr) return FFX_API_RETURN_ERROR_PARAMETER;
+    ++dispatches;
+    return FFX_API_RETURN_OK;
+}
+
+void StubFFX::install() {
+    FSR_Upscaler::api.ffxCreateContext  = &createContext;
+    FSR_Upscaler::api.ffxDestroyContext = &destroyContext;
+    FSR_Upscaler::api.ffxConfigure      = &configure;
+    FSR_Upscaler::api.ffxQuery          = &query;
+    FSR_Upscaler::api.ffxDispatch       = &dispatch;
+    FSR_Upscaler::loaded                = true;
+    FSR_Upscaler::attempted             = true;
+}
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+#ifdef ENABLE_BENCHMARK
+#    include <ffx_api.h>
+
+#    include <cstdint>
+
+/// A do-nothing FidelityFX API provider. It answers the queries the plugin makes and accepts every context and dispatch,
+/// so that timings measure the plugin's own overhead rather than the SDK's.
+class StubFFX {
+    static ffxReturnCode_t createContext(ffxContext* context, ffxCreateContextDescHeader* desc, const ffxAllocationCallbacks* memCb);
+    static ffxReturnCode_t destroyContext(ffxContext* context, const ffxAllocationCallbacks* memCb);
+    static ffxReturnCode_t configure(ffxContext* context, const ffxConfigureDescHeader* desc);
+    static ffxReturnCode_t query(ffxContext* context, ffxQueryDescHeader* desc);
+    static ffxReturnCode_t dispatch(ffxContext* context, const ffxDispatchDescHeader* desc);
+
+public:
+    StubFFX()                          = delete;
+    StubFFX(const StubFFX&)            = delete;
+    StubFFX(StubFFX&&)                 = delete;
+    StubFFX& operator=(const StubFFX&) = delete;
+    StubFFX& operator=(StubFFX&&)      = delete;
+    ~StubFFX()                         = delete;
+
+    static uint64_t contextsCreated;
+    static uint64_t dispatches;
+
+    static void install();
+};
+#endif
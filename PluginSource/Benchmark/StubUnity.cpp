@@ -0,0 +1,508 @@
+#ifdef ENABLE_BENCHMARK
+#    include "StubUnity.hpp"
+
+#    include <algorithm>
+#    include <array>
+#    include <cstdio>
+#    include <cstring>
+
+PFN_vkGetInstanceProcAddr                    StubUnity::vkGetInstanceProcAddr{VK_NULL_HANDLE};
+PFN_vkGetDeviceProcAddr                      StubUnity::vkGetDeviceProcAddr{VK_NULL_HANDLE};
+PFN_vkDestroyInstance                        StubUnity::vkDestroyInstance{VK_NULL_HANDLE};
+PFN_vkEnumeratePhysicalDevices               StubUnity::vkEnumeratePhysicalDevices{VK_NULL_HANDLE};
+PFN_vkGetPhysicalDeviceProperties            StubUnity::vkGetPhysicalDeviceProperties{VK_NULL_HANDLE};
+PFN_vkGetPhysicalDeviceMemoryProperties      StubUnity::vkGetPhysicalDeviceMemoryProperties{VK_NULL_HANDLE};
+PFN_vkGetPhysicalDeviceQueueFamilyProperties StubUnity::vkGetPhysicalDeviceQueueFamilyProperties{VK_NULL_HANDLE};
+PFN_vkDestroyDevice                          StubUnity::vkDestroyDevice{VK_NULL_HANDLE};
+PFN_vkDeviceWaitIdle                         StubUnity::vkDeviceWaitIdle{VK_NULL_HANDLE};
+PFN_vkGetDeviceQueue                         StubUnity::vkGetDeviceQueue{VK_NULL_HANDLE};
+PFN_vkCreateImage                            StubUnity::vkCreateImage{VK_NULL_HANDLE};
+PFN_vkDestroyImage                           StubUnity::vkDestroyImage{VK_NULL_HANDLE};
+PFN_vkGetImageMemoryRequirements             StubUnity::vkGetImageMemoryRequirements{VK_NULL_HANDLE};
+PFN_vkAllocateMemory                         StubUnity::vkAllocateMemory{VK_NULL_HANDLE};
+PFN_vkFreeMemory                             StubUnity::vkFreeMemory{VK_NULL_HANDLE};
+PFN_vkBindImageMemory                        StubUnity::vkBindImageMemory{VK_NULL_HANDLE};
+PFN_vkCreateCommandPool                      StubUnity::vkCreateCommandPool{VK_NULL_HANDLE};
+PFN_vkDestroyCommandPool                     StubUnity::vkDestroyCommandPool{VK_NULL_HANDLE};
+PFN_vkAllocateCommandBuffers                 StubUnity::vkAllocateCommandBuffers{VK_NULL_HANDLE};
+PFN_vkResetCommandPool                       StubUnity::vkResetCommandPool{VK_NULL_HANDLE};
+PFN_vkBeginCommandBuffer                     StubUnity::vkBeginCommandBuffer{VK_NULL_HANDLE};
+PFN_vkEndCommandBuffer                       StubUnity::vkEndCommandBuffer{VK_NULL_HANDLE};
+PFN_vkCmdPipelineBarrier                     StubUnity::vkCmdPipelineBarrier{VK_NULL_HANDLE};
+PFN_vkCreateFence                            StubUnity::vkCreateFence{VK_NULL_HANDLE};
+PFN_vkDestroyFence                           StubUnity::vkDestroyFence{VK_NULL_HANDLE};
+PFN_vkWaitForFences                          StubUnity::vkWaitForFences{VK_NULL_HANDLE};
+PFN_vkResetFences                            StubUnity::vkResetFences{VK_NULL_HANDLE};
+PFN_vkQueueSubmit                            StubUnity::vkQueueSubmit{VK_NULL_HANDLE};
+PFN_vkCreateSwapchainKHR                     StubUnity::vkCreateSwapchainKHR{VK_NULL_HANDLE};
+PFN_vkDestroySwapchainKHR                    StubUnity::vkDestroySwapchainKHR{VK_NULL_HANDLE};
+PFN_vkQueuePresentKHR                        StubUnity::vkQueuePresentKHR{VK_NULL_HANDLE};
+PFN_vkGetInstanceProcAddr                    StubUnity::driverGetInstanceProcAddr{VK_NULL_HANDLE};
+PFN_vkGetDeviceProcAddr                      StubUnity::driverGetDeviceProcAddr{VK_NULL_HANDLE};
+uint64_t                                     StubUnity::nextSwapchain{};
+
+IUnityInterfaces       StubUnity::interfaces{};
+IUnityLog              StubUnity::log{};
+IUnityGraphics         StubUnity::graphics{};
+IUnityGraphicsVulkanV2 StubUnity::vulkan{};
+
+UnityVulkanInitCallback           StubUnity::interceptInitialization{nullptr};
+void*                             StubUnity::interceptUserData{nullptr};
+IUnityGraphicsDeviceEventCallback StubUnity::deviceEventCallback{nullptr};
+
+UnityVulkanInstance   StubUnity::instance{};
+VkCommandPool         StubUnity::commandPool{VK_NULL_HANDLE};
+VkCommandBuffer       StubUnity::commandBuffer{VK_NULL_HANDLE};
+VkFence               StubUnity::fence{VK_NULL_HANDLE};
+unsigned long long    StubUnity::frameNumber{};
+bool                  StubUnity::recording{};
+std::vector<StubUnity::Texture*> StubUnity::textures{};
+
+IUnityInterface* StubUnity::getInterfaceSplit(const unsigned long long guidHigh, const unsigned long long guidLow) {
+    return getInterface(UnityInterfaceGUID(guidHigh, guidLow));
+}
+
+IUnityInterface* StubUnity::getInterface(const UnityInterfaceGUID guid) {
+    if (guid == UNITY_GET_INTERFACE_GUID(IUnityLog)) return &log;
+    if (guid == UNITY_GET_INTERFACE_GUID(IUnityGraphics)) return &graphics;
+    if (guid == UNITY_GET_INTERFACE_GUID(IUnityGraphicsVulkanV2)) return &vulkan;
+    return nullptr;
+}
+
+void StubUnity::registerInterfaceSplit(unsigned long long /*unused*/, unsigned long long /*unused*/, IUnityInterface* /*unused*/) {}
+
+void StubUnity::registerInterface(UnityInterfaceGUID /*unused*/, IUnityInterface* /*unused*/) {}
+
+void StubUnity::logMessage(const UnityLogType type, const char* message, const char* fileName, const int /*unused*/) {
+    const char* prefix = "Log";
+    switch (type) {
+        case kUnityLogTypeError: prefix = "Error"; break;
+        case kUnityLogTypeWarning: prefix = "Warning"; break;
+        case kUnityLogTypeException: prefix = "Exception"; break;
+        default: break;
+    }
+    std::fprintf(stderr, "[%s] %s: %s\n", prefix, fileName, message);
+}
+
+UnityGfxRenderer StubUnity::getRenderer() {
+    return kUnityGfxRendererVulkan;
+}
+
+void StubUnity::registerDeviceEventCallback(const IUnityGraphicsDeviceEventCallback callback) {
+    deviceEventCallback = callback;
+}
+
+void StubUnity::unregisterDeviceEventCallback(const IUnityGraphicsDeviceEventCallback callback) {
+    if (deviceEventCallback == callback) deviceEventCallback = nullptr;
+}
+
+int StubUnity::reserveEventIDRange(const int /*unused*/) {
+    return 0;
+}
+
+bool StubUnity::addInterceptInitialization(const UnityVulkanInitCallback func, void* userdata, const int /*unused*/) {
+    interceptInitialization = func;
+    interceptUserData       = userdata;
+    return true;
+}
+
+bool StubUnity::removeInterceptInitialization(const UnityVulkanInitCallback func) {
+    if (interceptInitialization != func) return false;
+    interceptInitialization = nullptr;
+    interceptUserData       = nullptr;
+    return true;
+}
+
+UnityVulkanInstance StubUnity::getInstance() {
+    return instance;
+}
+
+bool StubUnity::commandRecordingState(UnityVulkanRecordingState* outCommandRecordingState, UnityVulkanGraphicsQueueAccess /*unused*/) {
+    if (!recording) return false;
+    outCommandRecordingState->commandBuffer      = commandBuffer;
+    outCommandRecordingState->commandBufferLevel = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    outCommandRecordingState->renderPass         = VK_NULL_HANDLE;
+    outCommandRecordingState->framebuffer        = VK_NULL_HANDLE;
+    outCommandRecordingState->subPassIndex       = -1;
+    outCommandRecordingState->currentFrameNumber = frameNumber;
+    outCommandRecordingState->safeFrameNumber    = frameNumber == 0 ? 0 : frameNumber - 1;
+    return true;
+}
+
+bool StubUnity::accessTexture(void* nativeTexture, const VkImageSubresource* /*unused*/, const VkImageLayout layout, const VkPipelineStageFlags pipelineStageFlags, const VkAccessFlags accessFlags, const UnityVulkanResourceAccessMode accessMode, UnityVulkanImage* outImage) {
+    const auto it = std::ranges::find(textures, static_cast<Texture*>(nativeTexture));
+    if (it == textures.end()) return false;
+    Texture& texture = **it;
+    if (accessMode == kUnityVulkanResourceAccess_PipelineBarrier && recording) {
+        const VkImageMemoryBarrier barrier {
+            .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext               = nullptr,
+            .srcAccessMask       = texture.access,
+            .dstAccessMask       = accessFlags,
+            .oldLayout           = texture.layout,
+            .newLayout           = layout,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image               = texture.image,
+            .subresourceRange    = {texture.aspect, 0U, 1U, 0U, 1U}
+        };
+        vkCmdPipelineBarrier(commandBuffer, texture.stage, pipelineStageFlags, 0U, 0U, nullptr, 0U, nullptr, 1U, &barrier);
+        texture.layout = layout;
+        texture.stage  = pipelineStageFlags;
+        texture.access = accessFlags;
+    }
+    outImage->memory.memory = texture.memory;
+    outImage->image         = texture.image;
+    outImage->layout        = texture.layout;
+    outImage->aspect        = texture.aspect;
+    outImage->usage         = texture.usage;
+    outImage->format        = texture.format;
+    outImage->extent        = texture.extent;
+    outImage->tiling        = VK_IMAGE_TILING_OPTIMAL;
+    outImage->type          = VK_IMAGE_TYPE_2D;
+    outImage->samples       = VK_SAMPLE_COUNT_1_BIT;
+    outImage->layers        = 1;
+    outImage->mipCount      = 1;
+    return true;
+}
+
+void StubUnity::ensureOutsideRenderPass() {}
+
+uint32_t StubUnity::findMemoryType(const uint32_t typeBits, const VkMemoryPropertyFlags properties) {
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    vkGetPhysicalDeviceMemoryProperties(instance.physicalDevice, &memoryProperties);
+    for (uint32_t i{}; i < memoryProperties.memoryTypeCount; ++i)
+        if ((typeBits & 1U << i) != 0U && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) return i;
+    return 0U;
+}
+
+IUnityInterfaces* StubUnity::getInterfaces() {
+    interfaces.GetInterface                  = &getInterface;
+    interfaces.RegisterInterface             = &registerInterface;
+    interfaces.GetInterfaceSplit             = &getInterfaceSplit;
+    interfaces.RegisterInterfaceSplit        = &registerInterfaceSplit;
+    log.Log                                  = &logMessage;
+    graphics.GetRenderer                     = &getRenderer;
+    graphics.RegisterDeviceEventCallback     = &registerDeviceEventCallback;
+    graphics.UnregisterDeviceEventCallback   = &unregisterDeviceEventCallback;
+    graphics.ReserveEventIDRange             = &reserveEventIDRange;
+    vulkan.AddInterceptInitialization        = &addInterceptInitialization;
+    vulkan.RemoveInterceptInitialization     = &removeInterceptInitialization;
+    vulkan.Instance                          = &getInstance;
+    vulkan.CommandRecordingState             = &commandRecordingState;
+    vulkan.AccessTexture                     = &accessTexture;
+    vulkan.EnsureOutsideRenderPass           = &ensureOutsideRenderPass;
+    return &interfaces;
+}
+
+PFN_vkVoidFunction StubUnity::getInstanceProcAddr(VkInstance instance, const char* name) {
+    if (std::strcmp(name, "vkGetDeviceProcAddr") == 0) {
+        driverGetDeviceProcAddr = reinterpret_cast<PFN_vkGetDeviceProcAddr>(driverGetInstanceProcAddr(instance, name));
+        return reinterpret_cast<PFN_vkVoidFunction>(&getDeviceProcAddr);
+    }
+    return driverGetInstanceProcAddr(instance, name);
+}
+
+PFN_vkVoidFunction StubUnity::getDeviceProcAddr(VkDevice device, const char* name) {
+    if (std::strcmp(name, "vkCreateSwapchainKHR") == 0) return reinterpret_cast<PFN_vkVoidFunction>(&stubCreateSwapchainKHR);
+    if (std::strcmp(name, "vkDestroySwapchainKHR") == 0) return reinterpret_cast<PFN_vkVoidFunction>(&stubDestroySwapchainKHR);
+    if (std::strcmp(name, "vkQueuePresentKHR") == 0) return reinterpret_cast<PFN_vkVoidFunction>(&stubQueuePresentKHR);
+    return driverGetDeviceProcAddr(device, name);
+}
+
+VkResult StubUnity::stubCreateSwapchainKHR(VkDevice /*unused*/, const VkSwapchainCreateInfoKHR* /*unused*/, const VkAllocationCallbacks* /*unused*/, VkSwapchainKHR* pSwapchain) {
+    // Handles only have to be unique and non-null; they are never dereferenced.
+    *pSwapchain = reinterpret_cast<VkSwapchainKHR>(++nextSwapchain * 64U);
+    return VK_SUCCESS;
+}
+
+void StubUnity::stubDestroySwapchainKHR(VkDevice /*unused*/, VkSwapchainKHR /*unused*/, const VkAllocationCallbacks* /*unused*/) {}
+
+VkResult StubUnity::stubQueuePresentKHR(VkQueue /*unused*/, const VkPresentInfoKHR* pPresentInfo) {
+    if (pPresentInfo->pResults != nullptr) std::fill_n(pPresentInfo->pResults, pPresentInfo->swapchainCount, VK_SUCCESS);
+    return VK_SUCCESS;
+}
+
+bool StubUnity::initialize(const PFN_vkGetInstanceProcAddr loaderGetInstanceProcAddr) {
+    // Mirror Unity: give the plugin a chance to wrap vkGetInstanceProcAddr, then create everything through the result.
+    driverGetInstanceProcAddr = loaderGetInstanceProcAddr;
+    vkGetInstanceProcAddr = interceptInitialization != nullptr ? interceptInitialization(&getInstanceProcAddr, interceptUserData) : &getInstanceProcAddr;
+    instance.getInstanceProcAddr = vkGetInstanceProcAddr;
+
+    const auto vkCreateInstance = reinterpret_cast<PFN_vkCreateInstance>(vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkCreateInstance"));
+    constexpr VkApplicationInfo applicationInfo {
+        .sType              = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+        .pNext              = nullptr,
+        .pApplicationName   = "GfxPluginUpscaler Benchmark",
+        .applicationVersion = 1U,
+        .pEngineName        = "StubUnity",
+        .engineVersion      = 1U,
+        .apiVersion         = VK_API_VERSION_1_3
+    };
+    const VkInstanceCreateInfo instanceCreateInfo {
+        .sType                   = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+        .pNext                   = nullptr,
+        .flags                   = 0U,
+        .pApplicationInfo        = &applicationInfo,
+        .enabledLayerCount       = 0U,
+        .ppEnabledLayerNames     = nullptr,
+        .enabledExtensionCount   = 0U,
+        .ppEnabledExtensionNames = nullptr
+    };
+    if (vkCreateInstance == VK_NULL_HANDLE || vkCreateInstance(&instanceCreateInfo, nullptr, &instance.instance) != VK_SUCCESS) return false;
+
+    vkDestroyInstance                        = reinterpret_cast<PFN_vkDestroyInstance>(vkGetInstanceProcAddr(instance.instance, "vkDestroyInstance"));
+    vkEnumeratePhysicalDevices               = reinterpret_cast<PFN_vkEnumeratePhysicalDevices>(vkGetInstanceProcAddr(instance.instance, "vkEnumeratePhysicalDevices"));
+    vkGetPhysicalDeviceProperties            = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties>(vkGetInstanceProcAddr(instance.instance, "vkGetPhysicalDeviceProperties"));
+    vkGetPhysicalDeviceMemoryProperties      = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties>(vkGetInstanceProcAddr(instance.instance, "vkGetPhysicalDeviceMemoryProperties"));
+    vkGetPhysicalDeviceQueueFamilyProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceQueueFamilyProperties>(vkGetInstanceProcAddr(instance.instance, "vkGetPhysicalDeviceQueueFamilyProperties"));
+
+    // Prefer a CPU implementation (lavapipe) so that results do not depend on the GPU in the build machine.
+    uint32_t physicalDeviceCount{};
+    vkEnumeratePhysicalDevices(instance.instance, &physicalDeviceCount, nullptr);
+    std::vector<VkPhysicalDevice> physicalDevices(physicalDeviceCount);
+    vkEnumeratePhysicalDevices(instance.instance, &physicalDeviceCount, physicalDevices.data());
+    if (physicalDevices.empty()) return false;
+    instance.physicalDevice = physicalDevices.front();
+    for (VkPhysicalDevice physicalDevice : physicalDevices) {
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        if (properties.deviceType != VK_PHYSICAL_DEVICE_TYPE_CPU) continue;
+        instance.physicalDevice = physicalDevice;
+        break;
+    }
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(instance.physicalDevice, &properties);
+    std::fprintf(stderr, "Running on '%s'.\n", properties.deviceName);
+
+    uint32_t queueFamilyCount{};
+    vkGetPhysicalDeviceQueueFamilyProperties(instance.physicalDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(instance.physicalDevice, &queueFamilyCount, queueFamilies.data());
+    const auto family = std::ranges::find_if(queueFamilies, [](const VkQueueFamilyProperties& properties) { return (properties.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT); });
+    if (family == queueFamilies.end()) return false;
+    instance.queueFamilyIndex = static_cast<uint32_t>(std::distance(queueFamilies.begin(), family));
+
+    constexpr float                 priority{1.0F};
+    const VkDeviceQueueCreateInfo queueCreateInfo {
+        .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+        .pNext            = nullptr,
+        .flags            = 0U,
+        .queueFamilyIndex = instance.queueFamilyIndex,
+        .queueCount       = 1U,
+        .pQueuePriorities = &priority
+    };
+    const VkDeviceCreateInfo deviceCreateInfo {
+        .sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+        .pNext                   = nullptr,
+        .flags                   = 0U,
+        .queueCreateInfoCount    = 1U,
+        .pQueueCreateInfos       = &queueCreateInfo,
+        .enabledLayerCount       = 0U,
+        .ppEnabledLayerNames     = nullptr,
+        .enabledExtensionCount   = 0U,
+        .ppEnabledExtensionNames = nullptr,
+        .pEnabledFeatures        = nullptr
+    };
+    const auto vkCreateDevice = reinterpret_cast<PFN_vkCreateDevice>(vkGetInstanceProcAddr(instance.instance, "vkCreateDevice"));
+    if (vkCreateDevice(instance.physicalDevice, &deviceCreateInfo, nullptr, &instance.device) != VK_SUCCESS) return false;
+
+    vkGetDeviceProcAddr          = reinterpret_cast<PFN_vkGetDeviceProcAddr>(vkGetInstanceProcAddr(instance.instance, "vkGetDeviceProcAddr"));
+    vkDestroyDevice              = reinterpret_cast<PFN_vkDestroyDevice>(vkGetDeviceProcAddr(instance.device, "vkDestroyDevice"));
+    vkDeviceWaitIdle             = reinterpret_cast<PFN_vkDeviceWaitIdle>(vkGetDeviceProcAddr(instance.device, "vkDeviceWaitIdle"));
+    vkGetDeviceQueue             = reinterpret_cast<PFN_vkGetDeviceQueue>(vkGetDeviceProcAddr(instance.device, "vkGetDeviceQueue"));
+    vkCreateImage                = reinterpret_cast<PFN_vkCreateImage>(vkGetDeviceProcAddr(instance.device, "vkCreateImage"));
+    vkDestroyImage               = reinterpret_cast<PFN_vkDestroyImage>(vkGetDeviceProcAddr(instance.device, "vkDestroyImage"));
+    vkGetImageMemoryRequirements = reinterpret_cast<PFN_vkGetImageMemoryRequirements>(vkGetDeviceProcAddr(instance.device, "vkGetImageMemoryRequirements"));
+    vkAllocateMemory             = reinterpret_cast<PFN_vkAllocateMemory>(vkGetDeviceProcAddr(instance.device, "vkAllocateMemory"));
+    vkFreeMemory                 = reinterpret_cast<PFN_vkFreeMemory>(vkGetDeviceProcAddr(instance.device, "vkFreeMemory"));
+    vkBindImageMemory            = reinterpret_cast<PFN_vkBindImageMemory>(vkGetDeviceProcAddr(instance.device, "vkBindImageMemory"));
+    vkCreateCommandPool          = reinterpret_cast<PFN_vkCreateCommandPool>(vkGetDeviceProcAddr(instance.device, "vkCreateCommandPool"));
+    vkDestroyCommandPool         = reinterpret_cast<PFN_vkDestroyCommandPool>(vkGetDeviceProcAddr(instance.device, "vkDestroyCommandPool"));
+    vkAllocateCommandBuffers     = reinterpret_cast<PFN_vkAllocateCommandBuffers>(vkGetDeviceProcAddr(instance.device, "vkAllocateCommandBuffers"));
+    vkResetCommandPool           = reinterpret_cast<PFN_vkResetCommandPool>(vkGetDeviceProcAddr(instance.device, "vkResetCommandPool"));
+    vkBeginCommandBuffer         = reinterpret_cast<PFN_vkBeginCommandBuffer>(vkGetDeviceProcAddr(instance.device, "vkBeginCommandBuffer"));
+    vkEndCommandBuffer           = reinterpret_cast<PFN_vkEndCommandBuffer>(vkGetDeviceProcAddr(instance.device, "vkEndCommandBuffer"));
+    vkCmdPipelineBarrier         = reinterpret_cast<PFN_vkCmdPipelineBarrier>(vkGetDeviceProcAddr(instance.device, "vkCmdPipelineBarrier"));
+    vkCreateFence                = reinterpret_cast<PFN_vkCreateFence>(vkGetDeviceProcAddr(instance.device, "vkCreateFence"));
+    vkDestroyFence               = reinterpret_cast<PFN_vkDestroyFence>(vkGetDeviceProcAddr(instance.device, "vkDestroyFence"));
+    vkWaitForFences              = reinterpret_cast<PFN_vkWaitForFences>(vkGetDeviceProcAddr(instance.device, "vkWaitForFences"));
+    vkResetFences                = reinterpret_cast<PFN_vkResetFences>(vkGetDeviceProcAddr(instance.device, "vkResetFences"));
+    vkQueueSubmit                = reinterpret_cast<PFN_vkQueueSubmit>(vkGetDeviceProcAddr(instance.device, "vkQueueSubmit"));
+    vkCreateSwapchainKHR         = reinterpret_cast<PFN_vkCreateSwapchainKHR>(vkGetDeviceProcAddr(instance.device, "vkCreateSwapchainKHR"));
+    vkDestroySwapchainKHR        = reinterpret_cast<PFN_vkDestroySwapchainKHR>(vkGetDeviceProcAddr(instance.device, "vkDestroySwapchainKHR"));
+    vkQueuePresentKHR            = reinterpret_cast<PFN_vkQueuePresentKHR>(vkGetDeviceProcAddr(instance.device, "vkQueuePresentKHR"));
+    // Unity resolves these through the hooks as well, which is how the plugin learns about them.
+    for (const char* name : {"vkCreateImageView", "vkDestroyImageView"}) vkGetDeviceProcAddr(instance.device, name);
+
+    vkGetDeviceQueue(instance.device, instance.queueFamilyIndex, 0U, &instance.graphicsQueue);
+
+    const VkCommandPoolCreateInfo commandPoolCreateInfo {
+        .sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .pNext            = nullptr,
+        .flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        .queueFamilyIndex = instance.queueFamilyIndex
+    };
+    if (vkCreateCommandPool(instance.device, &commandPoolCreateInfo, nullptr, &commandPool) != VK_SUCCESS) return false;
+    const VkCommandBufferAllocateInfo commandBufferAllocateInfo {
+        .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .pNext              = nullptr,
+        .commandPool        = commandPool,
+        .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1U
+    };
+    if (vkAllocateCommandBuffers(instance.device, &commandBufferAllocateInfo, &commandBuffer) != VK_SUCCESS) return false;
+    constexpr VkFenceCreateInfo fenceCreateInfo {
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0U
+    };
+    if (vkCreateFence(instance.device, &fenceCreateInfo, nullptr, &fence) != VK_SUCCESS) return false;
+
+    if (deviceEventCallback != nullptr) deviceEventCallback(kUnityGfxDeviceEventInitialize);
+    return true;
+}
+
+void StubUnity::shutdown() {
+    if (instance.device != VK_NULL_HANDLE) vkDeviceWaitIdle(instance.device);
+    if (deviceEventCallback != nullptr) deviceEventCallback(kUnityGfxDeviceEventShutdown);
+    while (!textures.empty()) destroyTexture(textures.back());
+    if (fence != VK_NULL_HANDLE) vkDestroyFence(instance.device, fence, nullptr);
+    if (commandPool != VK_NULL_HANDLE) vkDestroyCommandPool(instance.device, commandPool, nullptr);
+    if (instance.device != VK_NULL_HANDLE) vkDestroyDevice(instance.device, nullptr);
+    if (instance.instance != VK_NULL_HANDLE) vkDestroyInstance(instance.instance, nullptr);
+    fence         = VK_NULL_HANDLE;
+    commandPool   = VK_NULL_HANDLE;
+    commandBuffer = VK_NULL_HANDLE;
+    instance      = {};
+}
+
+void* StubUnity::createTexture(const VkFormat format, const VkExtent2D extent, const VkImageUsageFlags usage) {
+    auto* texture = new Texture {
+        .format = format,
+        .extent = {extent.width, extent.height, 1U},
+        .usage  = usage,
+        .aspect = (usage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0U ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT
+    };
+    const VkImageCreateInfo imageCreateInfo {
+        .sType                 = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .pNext                 = nullptr,
+        .flags                 = 0U,
+        .imageType             = VK_IMAGE_TYPE_2D,
+        .format                = format,
+        .extent                = texture->extent,
+        .mipLevels             = 1U,
+        .arrayLayers           = 1U,
+        .samples               = VK_SAMPLE_COUNT_1_BIT,
+        .tiling                = VK_IMAGE_TILING_OPTIMAL,
+        .usage                 = usage,
+        .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0U,
+        .pQueueFamilyIndices   = nullptr,
+        .initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED
+    };
+    if (vkCreateImage(instance.device, &imageCreateInfo, nullptr, &texture->image) != VK_SUCCESS) {
+        delete texture;
+        return nullptr;
+    }
+    VkMemoryRequirements requirements{};
+    vkGetImageMemoryRequirements(instance.device, texture->image, &requirements);
+    const VkMemoryAllocateInfo allocateInfo {
+        .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext           = nullptr,
+        .allocationSize  = requirements.size,
+        .memoryTypeIndex = findMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+    };
+    vkAllocateMemory(instance.device, &allocateInfo, nullptr, &texture->memory);
+    vkBindImageMemory(instance.device, texture->image, texture->memory, 0U);
+    textures.push_back(texture);
+    return texture;
+}
+
+void StubUnity::destroyTexture(void* texture) {
+    const auto it = std::ranges::find(textures, static_cast<Texture*>(texture));
+    if (it == textures.end()) return;
+    vkDestroyImage(instance.device, (*it)->image, nullptr);
+    vkFreeMemory(instance.device, (*it)->memory, nullptr);
+    delete *it;
+    textures.erase(it);
+}
+
+void StubUnity::beginFrame() {
+    vkResetCommandPool(instance.device, commandPool, 0U);
+    constexpr VkCommandBufferBeginInfo beginInfo {
+        .sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext            = nullptr,
+        .flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        .pInheritanceInfo = nullptr
+    };
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    recording = true;
+}
+
+void StubUnity::endFrame() {
+    vkEndCommandBuffer(commandBuffer);
+    recording = false;
+    const VkSubmitInfo submitInfo {
+        .sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .pNext                = nullptr,
+        .waitSemaphoreCount   = 0U,
+        .pWaitSemaphores      = nullptr,
+        .pWaitDstStageMask    = nullptr,
+        .commandBufferCount   = 1U,
+        .pCommandBuffers      = &commandBuffer,
+        .signalSemaphoreCount = 0U,
+        .pSignalSemaphores    = nullptr
+    };
+    vkQueueSubmit(instance.graphicsQueue, 1U, &submitInfo, fence);
+    vkWaitForFences(instance.device, 1U, &fence, VK_TRUE, UINT64_MAX);
+    vkResetFences(instance.device, 1U, &fence);
+    ++frameNumber;
+}
+
+VkSwapchainKHR StubUnity::createSwapchain() {
+    const VkSwapchainCreateInfoKHR createInfo {
+        .sType                 = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
+        .pNext                 = nullptr,
+        .flags                 = 0U,
+        .surface               = reinterpret_cast<VkSurfaceKHR>(++nextSwapchain * 64U),
+        .minImageCount         = 3U,
+        .imageFormat           = VK_FORMAT_B8G8R8A8_UNORM,
+        .imageColorSpace       = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR,
+        .imageExtent           = {1920U, 1080U},
+        .imageArrayLayers      = 1U,
+        .imageUsage            = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+        .imageSharingMode      = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0U,
+        .pQueueFamilyIndices   = nullptr,
+        .preTransform          = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR,
+        .compositeAlpha        = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
+        .presentMode           = VK_PRESENT_MODE_FIFO_KHR,
+        .clipped               = VK_TRUE,
+        .oldSwapchain          = VK_NULL_HANDLE
+    };
+    VkSwapchainKHR swapchain{VK_NULL_HANDLE};
+    vkCreateSwapchainKHR(instance.device, &createInfo, nullptr, &swapchain);
+    return swapchain;
+}
+
+void StubUnity::destroySwapchain(VkSwapchainKHR swapchain) {
+    vkDestroySwapchainKHR(instance.device, swapchain, nullptr);
+}
+
+VkResult StubUnity::present(const std::span<const VkSwapchainKHR> swapchains, const bool hooked) {
+    constexpr std::array<uint32_t, 8> imageIndices{};
+    std::array<VkResult, 8>           results{};
+    const VkPresentInfoKHR presentInfo {
+        .sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+        .pNext              = nullptr,
+        .waitSemaphoreCount = 0U,
+        .pWaitSemaphores    = nullptr,
+        .swapchainCount     = static_cast<uint32_t>(std::min(swapchains.size(), imageIndices.size())),
+        .pSwapchains        = swapchains.data(),
+        .pImageIndices      = imageIndices.data(),
+        .pResults           = results.data()
+    };
+    return (hooked ? vkQueuePresentKHR : &stubQueuePresentKHR)(instance.graphicsQueue, &presentInfo);
+}
+#endif
@@ -0,0 +1,138 @@
+#pragma once
+#ifdef ENABLE_BENCHMARK
+#    include <IUnityGraphics.h>
+#    include <IUnityGraphicsVulkan.h>
+#    include <IUnityInterface.h>
+#    include <IUnityLog.h>
+
+#    include <vulkan/vulkan.h>
+
+#    include <cstdint>
+#    include <span>
+#    include <vector>
+
+/// Stands in for the Unity player. Exposes `IUnityInterfaces`, `IUnityLog`, `IUnityGraphics` and `IUnityGraphicsVulkanV2`
+/// backed by a real (ideally software, i.e. lavapipe) Vulkan device that is created through the plugin's intercept hooks.
+class StubUnity {
+    struct Texture {
+        VkImage        image{VK_NULL_HANDLE};
+        VkDeviceMemory memory{VK_NULL_HANDLE};
+        VkFormat       format{VK_FORMAT_UNDEFINED};
+        VkExtent3D     extent{};
+        VkImageUsageFlags    usage{};
+        VkImageAspectFlags   aspect{};
+        VkImageLayout        layout{VK_IMAGE_LAYOUT_UNDEFINED};
+        VkPipelineStageFlags stage{VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT};
+        VkAccessFlags        access{VK_ACCESS_NONE};
+    };
+
+    static PFN_vkGetInstanceProcAddr                 vkGetInstanceProcAddr;
+    static PFN_vkGetDeviceProcAddr                   vkGetDeviceProcAddr;
+    static PFN_vkDestroyInstance                     vkDestroyInstance;
+    static PFN_vkEnumeratePhysicalDevices            vkEnumeratePhysicalDevices;
+    static PFN_vkGetPhysicalDeviceProperties         vkGetPhysicalDeviceProperties;
+    static PFN_vkGetPhysicalDeviceMemoryProperties   vkGetPhysicalDeviceMemoryProperties;
+    static PFN_vkGetPhysicalDeviceQueueFamilyProperties vkGetPhysicalDeviceQueueFamilyProperties;
+    static PFN_vkDestroyDevice                       vkDestroyDevice;
+    static PFN_vkDeviceWaitIdle                      vkDeviceWaitIdle;
+    static PFN_vkGetDeviceQueue                      vkGetDeviceQueue;
+    static PFN_vkCreateImage                         vkCreateImage;
+    static PFN_vkDestroyImage                        vkDestroyImage;
+    static PFN_vkGetImageMemoryRequirements          vkGetImageMemoryRequirements;
+    static PFN_vkAllocateMemory                      vkAllocateMemory;
+    static PFN_vkFreeMemory                          vkFreeMemory;
+    static PFN_vkBindImageMemory                     vkBindImageMemory;
+    static PFN_vkCreateCommandPool                   vkCreateCommandPool;
+    static PFN_vkDestroyCommandPool                  vkDestroyCommandPool;
+    static PFN_vkAllocateCommandBuffers              vkAllocateCommandBuffers;
+    static PFN_vkResetCommandPool                    vkResetCommandPool;
+    static PFN_vkBeginCommandBuffer                  vkBeginCommandBuffer;
+    static PFN_vkEndCommandBuffer                    vkEndCommandBuffer;
+    static PFN_vkCmdPipelineBarrier                  vkCmdPipelineBarrier;
+    static PFN_vkCreateFence                         vkCreateFence;
+    static PFN_vkDestroyFence                        vkDestroyFence;
+    static PFN_vkWaitForFences                       vkWaitForFences;
+    static PFN_vkResetFences                         vkResetFences;
+    static PFN_vkQueueSubmit                         vkQueueSubmit;
+    /// The plugin's swapchain hooks, resolved the way Unity resolves them.
+    static PFN_vkCreateSwapchainKHR                  vkCreateSwapchainKHR;
+    static PFN_vkDestroySwapchainKHR                 vkDestroySwapchainKHR;
+    static PFN_vkQueuePresentKHR                     vkQueuePresentKHR;
+
+    /// The loader's entry points. The plugin is handed wrappers that replace the swapchain entry points with stubs, so
+    /// that the swapchain hooks can be exercised without a window or a presentation engine.
+    static PFN_vkGetInstanceProcAddr driverGetInstanceProcAddr;
+    static PFN_vkGetDeviceProcAddr   driverGetDeviceProcAddr;
+    static uint64_t                  nextSwapchain;
+
+    static IUnityInterfaces       interfaces;
+    static IUnityLog              log;
+    static IUnityGraphics         graphics;
+    static IUnityGraphicsVulkanV2 vulkan;
+
+    static UnityVulkanInitCallback            interceptInitialization;
+    static void*                              interceptUserData;
+    static IUnityGraphicsDeviceEventCallback  deviceEventCallback;
+
+    static UnityVulkanInstance instance;
+    static VkCommandPool       commandPool;
+    static VkCommandBuffer     commandBuffer;
+    static VkFence             fence;
+    static unsigned long long  frameNumber;
+    static bool                recording;
+    static std::vector<Texture*> textures;
+
+    static IUnityInterface* UNITY_INTERFACE_API getInterfaceSplit(unsigned long long guidHigh, unsigned long long guidLow);
+    static IUnityInterface* UNITY_INTERFACE_API getInterface(UnityInterfaceGUID guid);
+    static void UNITY_INTERFACE_API             registerInterfaceSplit(unsigned long long guidHigh, unsigned long long guidLow, IUnityInterface* ptr);
+    static void UNITY_INTERFACE_API             registerInterface(UnityInterfaceGUID guid, IUnityInterface* ptr);
+
+    static void UNITY_INTERFACE_API             logMessage(UnityLogType type, const char* message, const char* fileName, int fileLine);
+
+    static UnityGfxRenderer UNITY_INTERFACE_API getRenderer();
+    static void UNITY_INTERFACE_API             registerDeviceEventCallback(IUnityGraphicsDeviceEventCallback callback);
+    static void UNITY_INTERFACE_API             unregisterDeviceEventCallback(IUnityGraphicsDeviceEventCallback callback);
+    static int UNITY_INTERFACE_API              reserveEventIDRange(int count);
+
+    static bool UNITY_INTERFACE_API                addInterceptInitialization(UnityVulkanInitCallback func, void* userdata, int priority);
+    static bool UNITY_INTERFACE_API                removeInterceptInitialization(UnityVulkanInitCallback func);
+    static UnityVulkanInstance UNITY_INTERFACE_API getInstance();
+    static bool UNITY_INTERFACE_API                commandRecordingState(UnityVulkanRecordingState* outCommandRecordingState, UnityVulkanGraphicsQueueAccess queueAccess);
+    static bool UNITY_INTERFACE_API                accessTexture(void* nativeTexture, const VkImageSubresource* subResource, VkImageLayout layout, VkPipelineStageFlags pipelineStageFlags, VkAccessFlags accessFlags, UnityVulkanResourceAccessMode accessMode, UnityVulkanImage* outImage);
+    static void UNITY_INTERFACE_API                ensureOutsideRenderPass();
+
+    static uint32_t findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties);
+
+    static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL getInstanceProcAddr(VkInstance instance, const char* name);
+    static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL getDeviceProcAddr(VkDevice device, const char* name);
+    static VKAPI_ATTR VkResult VKAPI_CALL           stubCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInfoKHR* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkSwapchainKHR* pSwapchain);
+    static VKAPI_ATTR void VKAPI_CALL               stubDestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks* pAllocator);
+    static VKAPI_ATTR VkResult VKAPI_CALL           stubQueuePresentKHR(VkQueue queue, const VkPresentInfoKHR* pPresentInfo);
+
+public:
+    StubUnity()                            = delete;
+    StubUnity(const StubUnity&)            = delete;
+    StubUnity(StubUnity&&)                 = delete;
+    StubUnity& operator=(const StubUnity&) = delete;
+    StubUnity& operator=(StubUnity&&)      = delete;
+    ~StubUnity()                           = delete;
+
+    static IUnityInterfaces* getInterfaces();
+
+    static bool initialize(PFN_vkGetInstanceProcAddr loaderGetInstanceProcAddr);
+    static void shutdown();
+
+    static void* createTexture(VkFormat format, VkExtent2D extent, VkImageUsageFlags usage);
+    static void  destroyTexture(void* texture);
+
+    static void beginFrame();
+    static void endFrame();
+
+    /// Creates a stand-in swapchain through the plugin's hooks. No images exist behind it.
+    static VkSwapchainKHR createSwapchain();
+    static void           destroySwapchain(VkSwapchainKHR swapchain);
+    /// Presents image 0 of each swapchain, through the plugin's present hook if `hooked` is set or straight to the stub
+    /// otherwise.
+    static VkResult present(std::span<const VkSwapchainKHR> swapchains, bool hooked);
+};
+#endif
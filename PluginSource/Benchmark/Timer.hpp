@@ -0,0 +1,44 @@
+#pragma once
+#ifdef ENABLE_BENCHMARK
+#    include <algorithm>
+#    include <chrono>
+#    include <cstdint>
+#    include <cstdio>
+#    include <string_view>
+#    include <type_traits>
+#    include <vector>
+
+/// Collects the wall-clock duration of every call made through it on the calling thread and prints a one-line summary.
+class Timer {
+    std::string_view      name;
+    std::vector<uint64_t> samples;
+
+public:
+    explicit Timer(const std::string_view name, const std::size_t expectedSamples = 0) : name(name) { samples.reserve(expectedSamples); }
+
+    template<typename Function> decltype(auto) measure(Function&& function) {
+        const auto start = std::chrono::steady_clock::now();
+        if constexpr (std::is_void_v<std::invoke_result_t<Function>>) {
+            function();
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        } else {
+            decltype(auto) result = function();
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            return result;
+        }
+    }
+
+    static void header() {
+        std::printf("%-32s %10s %12s %12s %12s %12s %12s\n", "call", "count", "min (us)", "mean (us)", "p50 (us)", "p99 (us)", "max (us)");
+    }
+
+    void report() {
+        if (samples.empty()) return (void)std::printf("%-32.*s %10u\n", static_cast<int>(name.size()), name.data(), 0U);
+        std::ranges::sort(samples);
+        uint64_t total{};
+        for (const uint64_t sample : samples) total += sample;
+        const auto at = [this](const double percentile) { return static_cast<double>(samples[static_cast<std::size_t>(percentile * static_cast<double>(samples.size() - 1))]) / 1000.0; };
+        std::printf("%-32.*s %10zu %12.3f %12.3f %12.3f %12.3f %12.3f\n", static_cast<int>(name.size()), name.data(), samples.size(), at(0.0), static_cast<double>(total) / static_cast<double>(samples.size()) / 1000.0, at(0.5), at(0.99), at(1.0));
+    }
+};
+#endif
@@ -0,0 +1,192 @@
+#ifdef ENABLE_BENCHMARK
+#    include "StubFFX.hpp"
+#    include "StubUnity.hpp"
+#    include "Timer.hpp"
+
+#    include "Upscaler/FSR_Upscaler.hpp"
+#    include "Upscaler/UpscaleData.hpp"
+#    include "Utilities/FrameRing.hpp"
+#    include "Utilities/ResolutionController.hpp"
+
+#    include <array>
+#    include <cstdio>
+#    include <cstdlib>
+#    include <cstring>
+#    include <fstream>
+#    include <string_view>
+#    include <vector>
+
+// The loader is linked directly; the plugin itself is built with VK_NO_PROTOTYPES.
+extern "C" VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetInstanceProcAddr(VkInstance instance, const char* pName);
+
+extern "C" {
+void UNITY_INTERFACE_API UnityPluginLoad(IUnityInterfaces* unityInterfaces);
+void UNITY_INTERFACE_API UnityPluginUnload();
+
+UnityRenderingEventAndData UNITY_INTERFACE_API GetUpscaleCallbackFidelityFXSuperResolution();
+FSR_Upscaler* UNITY_INTERFACE_API              CreateContextFidelityFXSuperResolution();
+Upscaler::Status UNITY_INTERFACE_API           UpdateContextFidelityFXSuperResolution(FSR_Upscaler* upscaler, Upscaler::Resolution resolution, enum Upscaler::Quality mode, Upscaler::Flags flags);
+Upscaler::Status UNITY_INTERFACE_API           SetImagesFidelityFXSuperResolution(FSR_Upscaler* upscaler, void* color, void* depth, void* motion, void* output, void* reactive, void* opaque, bool autoReactive);
+Upscaler::Resolution UNITY_INTERFACE_API       GetRecommendedResolution(const Upscaler* upscaler);
+void UNITY_INTERFACE_API                       DestroyContext(const Upscaler* upscaler);
+FrameRing* UNITY_INTERFACE_API                 CreateFrameRing(uint32_t size, uint32_t slots);
+void* UNITY_INTERFACE_API                      BeginFrameData(FrameRing* ring);
+uint32_t UNITY_INTERFACE_API                   EndFrameData(FrameRing* ring);
+void UNITY_INTERFACE_API                       DestroyFrameRing(const FrameRing* ring);
+uint32_t UNITY_INTERFACE_API                   ReplayDynamicResolution(const float* trace, uint32_t count, const ResolutionController::Settings* settings, ResolutionController::Resolution minimum, ResolutionController::Resolution maximum, uint32_t latency, float fixedShare, ResolutionController::State* states);
+}
+
+// Replays a recorded trace of GPU frame times, one per line in milliseconds at the full input resolution, through the
+// dynamic resolution controller and prints what it did.
+static int replay(const char* const path, const float target) {
+    std::ifstream      file(path);
+    std::vector<float> trace;
+    for (float time{}; file >> time;) trace.push_back(time);
+    if (trace.empty()) {
+        std::fprintf(stderr, "No frame times could be read from %s.\n", path);
+        return EXIT_FAILURE;
+    }
+    constexpr ResolutionController::Resolution minimum{960U, 540U};
+    constexpr ResolutionController::Resolution maximum{1920U, 1080U};
+    const ResolutionController::Settings       settings{target, 0.1F, 0.3F, 0.05F, 0.02F, 0.04F};
+    std::vector<ResolutionController::State>   states(trace.size());
+    const uint32_t overruns = ReplayDynamicResolution(trace.data(), static_cast<uint32_t>(trace.size()), &settings, minimum, maximum, 5U, 0.2F, states.data());
+    double         scale{};
+    uint32_t       changes{};
+    for (size_t frame{}; frame < states.size(); ++frame) {
+        scale += states[frame].scale;
+        if (frame != 0 && states[frame].resolution != states[frame - 1].resolution) ++changes;
+    }
+    std::printf("%zu frames against a %.2f ms budget: %u over budget, %u resolution changes, %.3f mean per-axis scale.\n", trace.size(), static_cast<double>(target), overruns, changes, scale / static_cast<double>(states.size()));
+    return EXIT_SUCCESS;
+}
+
+int main(const int argc, char** argv) {
+    if (argc > 2 && std::string_view(argv[1]) == "replay") return replay(argv[2], argc > 3 ? std::strtof(argv[3], nullptr) : 16.6F);
+    const uint32_t frames{argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 10000U};
+    const uint32_t settingsInterval{argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 500U};
+    constexpr Upscaler::Resolution outputResolution{1920U, 1080U};
+    constexpr std::array qualities{Upscaler::Quality, Upscaler::Balanced, Upscaler::Performance, Upscaler::UltraPerformance};
+
+    UnityPluginLoad(StubUnity::getInterfaces());
+    if (!StubUnity::initialize(&vkGetInstanceProcAddr)) {
+        std::fprintf(stderr, "Failed to create a Vulkan device. Is lavapipe (mesa-vulkan-drivers) installed?\n");
+        StubUnity::shutdown();
+        UnityPluginUnload();
+        return EXIT_FAILURE;
+    }
+    StubFFX::install();
+
+    constexpr VkExtent2D extent{outputResolution.width, outputResolution.height};
+    constexpr VkImageUsageFlags colorUsage{VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT};
+    void* color    = StubUnity::createTexture(VK_FORMAT_R16G16B16A16_SFLOAT, extent, colorUsage);
+#    ifdef ENABLE_PREPROCESSING
+    // The camera's own images, which the preprocessing pass copies into the bound ones every frame.
+    void* cameraDepth  = StubUnity::createTexture(VK_FORMAT_D32_SFLOAT, extent, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+    void* cameraMotion = StubUnity::createTexture(VK_FORMAT_R16G16_SFLOAT, extent, colorUsage);
+    void* cameraOpaque = StubUnity::createTexture(VK_FORMAT_R16G16B16A16_SFLOAT, extent, colorUsage);
+    void* depth        = StubUnity::createTexture(VK_FORMAT_R32_SFLOAT, extent, colorUsage);
+#    else
+    void* depth    = StubUnity::createTexture(VK_FORMAT_D32_SFLOAT, extent, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+#    endif
+    void* motion   = StubUnity::createTexture(VK_FORMAT_R16G16_SFLOAT, extent, colorUsage);
+    void* output   = StubUnity::createTexture(VK_FORMAT_R16G16B16A16_SFLOAT, extent, colorUsage);
+    void* reactive = StubUnity::createTexture(VK_FORMAT_R8_UNORM, extent, colorUsage);
+    void* opaque   = StubUnity::createTexture(VK_FORMAT_R16G16B16A16_SFLOAT, extent, colorUsage);
+
+    Timer create{"CreateContext"};
+    Timer update{"UpdateContext", frames / std::max(settingsInterval, 1U) + 1};
+    Timer setImages{"SetImages", frames + 1};
+    Timer publish{"PublishFrameData", frames};
+    Timer upscale{"UpscaleCallback", frames};
+    Timer destroy{"DestroyContext"};
+
+    StubUnity::beginFrame();
+    FSR_Upscaler* upscaler = create.measure([] { return CreateContextFidelityFXSuperResolution(); });
+    Upscaler::Status status = update.measure([&] { return UpdateContextFidelityFXSuperResolution(upscaler, outputResolution, qualities.front(), Upscaler::None); });
+    status = status == Upscaler::Success ? setImages.measure([&] { return SetImagesFidelityFXSuperResolution(upscaler, color, depth, motion, output, reactive, opaque, true); }) : status;
+    StubUnity::endFrame();
+    if (status != Upscaler::Success) {
+        std::fprintf(stderr, "Failed to set up the AMD FidelityFX Super Resolution context (status %u).\n", static_cast<unsigned>(status));
+        DestroyContext(upscaler);
+        StubUnity::shutdown();
+        UnityPluginUnload();
+        return EXIT_FAILURE;
+    }
+
+    const UnityRenderingEventAndData callback = GetUpscaleCallbackFidelityFXSuperResolution();
+    FrameRing* ring = CreateFrameRing(sizeof(FidelityFXSuperResolutionUpscaleData), FrameRing::MinSlots);
+    FidelityFXSuperResolutionUpscaleData data {
+        .handle            = upscaler,
+        .frameTime         = 16.6F,
+        .sharpness         = 0.5F,
+        .reactiveValue     = 0.9F,
+        .reactiveScale     = 1.0F,
+        .reactiveThreshold = 0.2F,
+        .farPlane          = 1000.0F,
+        .nearPlane         = 0.1F,
+        .verticalFOV       = 60.0F,
+        .jitter            = {},
+        .inputResolution   = GetRecommendedResolution(upscaler),
+        .options           = 0U,
+        .depthSource       = nullptr,
+        .motionSource      = nullptr,
+        .opaqueSource      = nullptr
+    };
+#    ifdef ENABLE_PREPROCESSING
+    data.depthSource  = cameraDepth;
+    data.motionSource = cameraMotion;
+    data.opaqueSource = cameraOpaque;
+#    endif
+
+    for (uint32_t frame{}; frame < frames; ++frame) {
+        StubUnity::beginFrame();
+        if (settingsInterval != 0 && frame != 0 && frame % settingsInterval == 0) {
+            update.measure([&] { return UpdateContextFidelityFXSuperResolution(upscaler, outputResolution, qualities.at(frame / settingsInterval % qualities.size()), Upscaler::None); });
+            data.inputResolution = GetRecommendedResolution(upscaler);
+            data.options |= 0x2U;
+        }
+        setImages.measure([&] { return SetImagesFidelityFXSuperResolution(upscaler, color, depth, motion, output, reactive, opaque, true); });
+        data.jitter = {static_cast<float>(frame % 8U) / 8.0F - 0.5F, static_cast<float>(frame % 3U) / 3.0F - 0.5F};
+        uint32_t published{};
+        void*    slot = publish.measure([&] {
+            void* payload = BeginFrameData(ring);
+            std::memcpy(payload, &data, sizeof(data));
+            published = EndFrameData(ring);
+            return payload;
+        });
+        upscale.measure([&] { callback(static_cast<int>(published), slot); });
+        data.options &= ~0x2U;
+        StubUnity::endFrame();
+    }
+
+    destroy.measure([&] { DestroyContext(upscaler); });
+    DestroyFrameRing(ring);
+
+    // The swapchain entry points behind the plugin's hooks are stubs, so the difference between these two timers is
+    // the cost of the present hook itself.
+    const std::array swapchains{StubUnity::createSwapchain(), StubUnity::createSwapchain()};
+    Timer presentStub{"vkQueuePresentKHR (stub)", frames};
+    Timer presentHooked{"vkQueuePresentKHR (hooked)", frames};
+    for (uint32_t frame{}; frame < frames; ++frame) {
+        presentStub.measure([&] { return StubUnity::present(swapchains, false); });
+        presentHooked.measure([&] { return StubUnity::present(swapchains, true); });
+    }
+    for (const VkSwapchainKHR swapchain : swapchains) StubUnity::destroySwapchain(swapchain);
+
+    std::printf("%u frames, settings changed every %u frames, %llu contexts created, %llu dispatches.\n", frames, settingsInterval, static_cast<unsigned long long>(StubFFX::contextsCreated), static_cast<unsigned long long>(StubFFX::dispatches));
+    Timer::header();
+    create.report();
+    update.report();
+    setImages.report();
+    publish.report();
+    upscale.report();
+    destroy.report();
+    presentStub.report();
+    presentHooked.report();
+
+    StubUnity::shutdown();
+    UnityPluginUnload();
+    return EXIT_SUCCESS;
+}
+#endif
@@ -13,15 +13,19 @@
 
 #include <vector>
 
-ffxContext FSR_FrameGenerator::swapchainContext {nullptr};
-ffxContext FSR_FrameGenerator::context {nullptr};
-std::array<FfxApiResource, 2> FSR_FrameGenerator::hudlessColorResource {};
-FfxApiResource FSR_FrameGenerator::depthResource {};
-FfxApiResource FSR_FrameGenerator::motionResource {};
-
 FSR_FrameGenerator::QueueData FSR_FrameGenerator::asyncCompute{}, FSR_FrameGenerator::present{}, FSR_FrameGenerator::imageAcquire{};
 bool FSR_FrameGenerator::asyncComputeSupported{false};
-FSR_FrameGenerator::CallbackContext FSR_FrameGenerator::callbackContext{&FSR_FrameGenerator::context, false};
+std::atomic<uint32_t> FSR_FrameGenerator::instances{0};
+
+FSR_FrameGenerator::FSR_FrameGenerator() {
+    ++instances;
+    Plugin::frameGenerationProvider = Plugin::FSR;
+}
+
+FSR_FrameGenerator::~FSR_FrameGenerator() {
+    destroySwapchain();
+    if (--instances == 0) Plugin::frameGenerationProvider = Plugin::None;
+}
 
 void FSR_FrameGenerator::useQueues(std::vector<VqsQueueSelection> selection) {
     if (selection.size() >= 2) {
@@ -51,8 +55,8 @@ void FSR_FrameGenerator::createSwapchain(VkSwapchainKHR* pSwapchain, const VkSwa
       .presentQueue      = {Vulkan::getQueue(present.family, present.index), present.family, nullptr},
       .imageAcquireQueue = {Vulkan::getQueue(imageAcquire.family, imageAcquire.index), imageAcquire.family, nullptr},
     };
-    if (FSR_Upscaler::ffxCreateContext(&swapchainContext, &createContextDescFrameGenerationSwapChainVk.header, nullptr) != FFX_API_RETURN_OK)
-        return Plugin::log(kUnityLogTypeError, "Failed to create swapchain context.");
+    if (FSR_Upscaler::api.ffxCreateContext(&swapchainContext, &createContextDescFrameGenerationSwapChainVk.header, nullptr) != FFX_API_RETURN_OK)
+        return Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Failed to create swapchain context.");
 
     ffxCreateBackendVKDesc createBackendVkDesc{
       .header = {
@@ -73,10 +77,14 @@ void FSR_FrameGenerator::createSwapchain(VkSwapchainKHR* pSwapchain, const VkSwa
       .maxRenderSize    = {pCreateInfo->imageExtent.width, pCreateInfo->imageExtent.height},
       .backBufferFormat = ffxApiGetSurfaceFormatVK(pCreateInfo->imageFormat),
     };
-    if (FSR_Upscaler::ffxCreateContext(&context, &createContextDescFrameGeneration.header, nullptr) != FFX_API_RETURN_OK || context == nullptr)
-        return Plugin::log(kUnityLogTypeError, "Failed to create frame generation context.");
+    if (FSR_Upscaler::api.ffxCreateContext(&context, &createContextDescFrameGeneration.header, nullptr) != FFX_API_RETURN_OK || context == nullptr)
+        return Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Failed to create frame generation context.");
 
     swapchain.vulkan = *pSwapchain;
+    Stats::add(Stats::FrameGenerationSwapchainCreations);
+    pacing.reset();
+    governor.reset();
+    if (tuned && !applyPacingTuning()) Plugin::log(LogQueue::Warning, LogQueue::FrameGeneration, "Failed to apply frame pacing tuning.");
 
     ffxQueryDescSwapchainReplacementFunctionsVK replacementFunctionsVk{
       .header = {
@@ -84,8 +92,8 @@ void FSR_FrameGenerator::createSwapchain(VkSwapchainKHR* pSwapchain, const VkSwa
         .pNext = nullptr
       }
     };
-    if (FSR_Upscaler::ffxQuery(&swapchainContext, &replacementFunctionsVk.header) != FFX_API_RETURN_OK)
-        return Plugin::log(kUnityLogTypeError, "Failed to query swapchain functions.");
+    if (FSR_Upscaler::api.ffxQuery(&swapchainContext, &replacementFunctionsVk.header) != FFX_API_RETURN_OK)
+        return Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Failed to query swapchain functions.");
     if (pCreate != VK_NULL_HANDLE) *pCreate = replacementFunctionsVk.pOutCreateSwapchainFFXAPI;
     if (pDestroy != VK_NULL_HANDLE) *pDestroy = replacementFunctionsVk.pOutDestroySwapchainFFXAPI;
     if (pGet != VK_NULL_HANDLE) *pGet = replacementFunctionsVk.pOutGetSwapchainImagesKHR;
@@ -115,46 +123,85 @@ void FSR_FrameGenerator::destroySwapchain() {
           .generationRect                     = {0, 0, 0, 0},
           .frameID                            = 0,
         };
-        if (FSR_Upscaler::ffxConfigure(&context, &configureDescFrameGeneration.header) != FFX_API_RETURN_OK)
-            Plugin::log(kUnityLogTypeError, "Failed to configure frame generation.");
+        if (FSR_Upscaler::api.ffxConfigure(&context, &configureDescFrameGeneration.header) != FFX_API_RETURN_OK)
+            Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Failed to configure frame generation.");
     }
-    if (swapchainContext != nullptr) FSR_Upscaler::ffxDestroyContext(&swapchainContext, nullptr);
+    if (swapchainContext != nullptr) FSR_Upscaler::api.ffxDestroyContext(&swapchainContext, nullptr);
     swapchainContext = nullptr;
-    if (context != nullptr) FSR_Upscaler::ffxDestroyContext(&context, nullptr);
+    if (context != nullptr) FSR_Upscaler::api.ffxDestroyContext(&context, nullptr);
     context          = nullptr;
     swapchain.vulkan = VK_NULL_HANDLE;
+    timestamps.release();
 }
 
-void FSR_FrameGenerator::useImages(VkImage color0, VkImage color1, VkImage depth, VkImage motion) {
-    UnityVulkanImage image{};
-    Vulkan::getGraphicsInterface()->AccessTexture(color0, UnityVulkanWholeImage, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, kUnityVulkanResourceAccess_PipelineBarrier, &image);
-    hudlessColorResource.at(0).resource    = image.image;
-    hudlessColorResource.at(0).description = {
-      .type     = FFX_API_RESOURCE_TYPE_TEXTURE2D,
-      .format   = ffxApiGetSurfaceFormatVK(image.format),
-      .width    = image.extent.width,
-      .height   = image.extent.height,
-      .depth    = image.extent.depth,
-      .mipCount = 1U,
-      .flags    = FFX_API_RESOURCE_FLAGS_ALIASABLE,
-      .usage    = static_cast<uint32_t>(FFX_API_RESOURCE_USAGE_READ_ONLY),
+bool FSR_FrameGenerator::applyPacingTuning() {
+    ffxConfigureDescFrameGenerationSwapChainKeyValueVK configureDescKeyValue{
+      .header = {
+        .type  = FFX_API_CONFIGURE_DESC_TYPE_FRAMEGENERATIONSWAPCHAIN_KEYVALUE_VK,
+        .pNext = nullptr
+      },
+      .key = FFX_API_CONFIGURE_FG_SWAPCHAIN_KEY_FRAMEPACINGTUNING_VK,
+      .u64 = 0U,
+      .ptr = &pacingTuning,
     };
-    hudlessColorResource.at(0).state = static_cast<uint32_t>(FFX_API_RESOURCE_STATE_PIXEL_COMPUTE_READ);
-    Vulkan::getGraphicsInterface()->AccessTexture(color1, UnityVulkanWholeImage, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, kUnityVulkanResourceAccess_PipelineBarrier, &image);
-    hudlessColorResource.at(1).resource    = image.image;
-    hudlessColorResource.at(1).description = {
-      .type     = FFX_API_RESOURCE_TYPE_TEXTURE2D,
-      .format   = ffxApiGetSurfaceFormatVK(image.format),
-      .width    = image.extent.width,
-      .height   = image.extent.height,
-      .depth    = image.extent.depth,
-      .mipCount = 1U,
-      .flags    = FFX_API_RESOURCE_FLAGS_ALIASABLE,
-      .usage    = static_cast<uint32_t>(FFX_API_RESOURCE_USAGE_READ_ONLY),
+    return FSR_Upscaler::api.ffxConfigure(&swapchainContext, &configureDescKeyValue.header) == FFX_API_RETURN_OK;
+}
+
+bool FSR_FrameGenerator::setPacingTuning(const FfxApiSwapchainFramePacingTuning& tuning) {
+    pacingTuning = tuning;
+    tuned        = true;
+    return swapchainContext == nullptr || applyPacingTuning();
+}
+
+bool FSR_FrameGenerator::registerUiResource(const FfxApiResource& resource, const uint32_t flags) {
+    ffxConfigureDescFrameGenerationSwapChainRegisterUiResourceVK configureDescUiResource{
+      .header = {
+        .type  = FFX_API_CONFIGURE_DESC_TYPE_FGSWAPCHAIN_REGISTERUIRESOURCE_VK,
+        .pNext = nullptr
+      },
+      .uiResource = resource,
+      .flags      = flags,
     };
-    hudlessColorResource.at(1).state = static_cast<uint32_t>(FFX_API_RESOURCE_STATE_PIXEL_COMPUTE_READ);
+    return FSR_Upscaler::api.ffxConfigure(&swapchainContext, &configureDescUiResource.header) == FFX_API_RETURN_OK;
+}
+
+void FSR_FrameGenerator::useUiImage(VkImage ui, const bool premultipliedAlpha) {
+    Stats::add(Stats::ImageRebinds);
+    // The swapchain copies the UI before each present, so the application can render the next frame's UI right away.
+    uiFlags.store(FFX_FRAMEGENERATION_UI_COMPOSITION_FLAG_ENABLE_INTERNAL_UI_DOUBLE_BUFFERING | (premultipliedAlpha ? FFX_FRAMEGENERATION_UI_COMPOSITION_FLAG_USE_PREMUL_ALPHA : 0U), std::memory_order_relaxed);
+    uiTexture.store(ui, std::memory_order_release);
+}
+
+void FSR_FrameGenerator::useImages(const std::span<const VkImage> colors, VkImage depth, VkImage motion) {
+    Stats::add(Stats::ImageRebinds);
+    UnityVulkanImage image{};
+    {
+        const std::lock_guard lock{staging};
+        for (uint32_t index{}; index < HudlessRing::MaxDepth; ++index) {
+            image = {};
+            if (index < colors.size()) Vulkan::getGraphicsInterface()->AccessTexture(colors[index], UnityVulkanWholeImage, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, kUnityVulkanResourceAccess_PipelineBarrier, &image);
+            stagedHudlessColorResource.at(index).resource    = image.image;
+            stagedHudlessColorResource.at(index).description = {
+              .type     = FFX_API_RESOURCE_TYPE_TEXTURE2D,
+              .format   = ffxApiGetSurfaceFormatVK(image.format),
+              .width    = image.extent.width,
+              .height   = image.extent.height,
+              .depth    = image.extent.depth,
+              .mipCount = 1U,
+              .flags    = FFX_API_RESOURCE_FLAGS_ALIASABLE,
+              .usage    = static_cast<uint32_t>(FFX_API_RESOURCE_USAGE_READ_ONLY),
+            };
+            stagedHudlessColorResource.at(index).state = static_cast<uint32_t>(FFX_API_RESOURCE_STATE_PIXEL_COMPUTE_READ);
+        }
+        // The render thread may still be interpolating from the current images, so it swaps them in itself.
+        hudless.resize(static_cast<uint32_t>(colors.size()));
+    }
+    // The HUD-less colors are read at present time, outside any command buffer that the plugin records, so Unity keeps
+    // tracking them. Depth and motion are only read by the prepare dispatch, so they are just looked up here and their
+    // transitions are batched around that dispatch in `evaluate`.
     image                            = {};
-    Vulkan::getGraphicsInterface()->AccessTexture(depth, UnityVulkanWholeImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, kUnityVulkanResourceAccess_PipelineBarrier, &image);
+    depthTexture                     = depth;
+    Vulkan::getGraphicsInterface()->AccessTexture(depth, UnityVulkanWholeImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0x0U, kUnityVulkanResourceAccess_ObserveOnly, &image);
     depthResource.resource    = image.image;
     depthResource.description = {
       .type     = FFX_API_RESOURCE_TYPE_TEXTURE2D,
@@ -168,7 +215,8 @@ void FSR_FrameGenerator::useImages(VkImage color0, VkImage color1, VkImage depth
     };
     depthResource.state = static_cast<uint32_t>(FFX_API_RESOURCE_STATE_PIXEL_COMPUTE_READ);
     image               = {};
-    Vulkan::getGraphicsInterface()->AccessTexture(motion, UnityVulkanWholeImage, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, kUnityVulkanResourceAccess_PipelineBarrier, &image);
+    motionTexture       = motion;
+    Vulkan::getGraphicsInterface()->AccessTexture(motion, UnityVulkanWholeImage, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0x0U, kUnityVulkanResourceAccess_ObserveOnly, &image);
     motionResource.resource    = image.image;
     motionResource.description = {
       .type     = FFX_API_RESOURCE_TYPE_TEXTURE2D,
@@ -183,9 +231,48 @@ void FSR_FrameGenerator::useImages(VkImage color0, VkImage color1, VkImage depth
     motionResource.state = static_cast<uint32_t>(FFX_API_RESOURCE_STATE_PIXEL_COMPUTE_READ);
 }
 
-void FSR_FrameGenerator::evaluate(bool enable, FfxApiRect2D generationRect, const float cameraPosition[3], const float cameraUp[3], const float cameraRight[3], const float cameraForward[3], FfxApiFloatCoords2D renderSize, FfxApiFloatCoords2D jitter, float frameTime, float farPlane, float nearPlane, float verticalFOV, unsigned index, unsigned options) {
+void FSR_FrameGenerator::evaluate(const bool enable, FfxApiRect2D generationRect, const float cameraPosition[3], const float cameraUp[3], const float cameraRight[3], const float cameraForward[3], FfxApiFloatCoords2D renderSize, FfxApiFloatCoords2D jitter, float frameTime, float farPlane, float nearPlane, float verticalFOV, const uint32_t ticket, unsigned options, void* depthSource, void* motionSource) {
     if (context == nullptr) return;
-    callbackContext.reset = (options & 0x40U) != 0U;
+    UnityVulkanRecordingState state{};
+    Vulkan::getGraphicsInterface()->CommandRecordingState(&state, kUnityVulkanGraphicsQueueAccess_DontCare);
+    if (hudless.applyResize(state.currentFrameNumber)) {
+        const std::lock_guard lock{staging};
+        hudlessColorResource = stagedHudlessColorResource;
+    }
+    void* const    ui   = uiTexture.load(std::memory_order_acquire);
+    const uint32_t slot = ui != nullptr ? HudlessRing::Unavailable : hudless.consume(ticket, state.currentFrameNumber, state.safeFrameNumber);
+    // Frames that got no HUD-less image are still configured, with generation off, so the previous image is not reused.
+    const bool hasImage = ui != nullptr || slot != HudlessRing::Unavailable;
+    if (!hasImage && ticket != HudlessRing::Unavailable) Plugin::log(LogQueue::Warning, LogQueue::FrameGeneration, "Skipped frame generation for an unknown HUD-less image.");
+    const bool generate = governor.decide(enable) && hasImage;
+    // The frames from before generation last stopped are unrelated to the current ones, so do not interpolate from them.
+    reset.store((options & 0x40U) != 0U || (generate && !generated), std::memory_order_relaxed);
+    generated = generate;
+    // Each application present carries one interpolated frame as well, unless only the interpolated ones are shown.
+    pacing.expect(generate && (options & 0x10U) == 0U ? 2U : 1U);
+
+    // FFX expects the UI resource to be registered again for every frame. Its layout is transitioned here as well,
+    // because the application renders into it every frame.
+    if (ui != nullptr) {
+        UnityVulkanImage image{};
+        Vulkan::getGraphicsInterface()->AccessTexture(ui, UnityVulkanWholeImage, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, kUnityVulkanResourceAccess_PipelineBarrier, &image);
+        const FfxApiResource uiResource{
+          .resource    = image.image,
+          .description = {
+            .type     = FFX_API_RESOURCE_TYPE_TEXTURE2D,
+            .format   = ffxApiGetSurfaceFormatVK(image.format),
+            .width    = image.extent.width,
+            .height   = image.extent.height,
+            .depth    = image.extent.depth,
+            .mipCount = 1U,
+            .flags    = FFX_API_RESOURCE_FLAGS_NONE,
+            .usage    = static_cast<uint32_t>(FFX_API_RESOURCE_USAGE_READ_ONLY),
+          },
+          .state = static_cast<uint32_t>(FFX_API_RESOURCE_STATE_PIXEL_COMPUTE_READ),
+        };
+        if (!registerUiResource(uiResource, uiFlags.load(std::memory_order_relaxed))) Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Failed to register the UI resource.");
+    } else if (composed && !registerUiResource({}, 0U)) Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Failed to unregister the UI resource.");
+    composed = ui != nullptr;
 
     ffxConfigureDescFrameGeneration configureDescFrameGeneration{
       .header = {
@@ -195,16 +282,16 @@ void FSR_FrameGenerator::evaluate(bool enable, FfxApiRect2D generationRect, cons
       .swapChain                  = swapchain.vulkan,
       .presentCallback            = nullptr,
       .presentCallbackUserContext = nullptr,
-      .frameGenerationCallback    = [](ffxDispatchDescFrameGeneration* params, void*) -> ffxReturnCode_t {
-          static uint32_t frameNumber;
-          params->reset |= callbackContext.reset;
-          params->frameID = ++frameNumber;
-          return FSR_Upscaler::ffxDispatch(callbackContext.context, &params->header);
+      .frameGenerationCallback    = [](ffxDispatchDescFrameGeneration* params, void* self) -> ffxReturnCode_t {
+          auto* generator = static_cast<FSR_FrameGenerator*>(self);
+          params->reset |= generator->reset.load(std::memory_order_relaxed);
+          params->frameID = ++generator->frameNumber;
+          return FSR_Upscaler::api.ffxDispatch(&generator->context, &params->header);
       },
-      .frameGenerationCallbackUserContext = nullptr,
-      .frameGenerationEnabled             = enable,
+      .frameGenerationCallbackUserContext = this,
+      .frameGenerationEnabled             = generate,
       .allowAsyncWorkloads                = (options & 0x20U) != 0U && asyncComputeSupported,
-      .HUDLessColor                       = hudlessColorResource.at(index),
+      .HUDLessColor                       = ui != nullptr || slot == HudlessRing::Unavailable ? FfxApiResource{} : hudlessColorResource.at(slot),
       .flags                              = ((options & 0x1U) != 0U ? FFX_FRAMEGENERATION_FLAG_DRAW_DEBUG_VIEW : 0U) |
                                             ((options & 0x2U) != 0U ? FFX_FRAMEGENERATION_FLAG_DRAW_DEBUG_TEAR_LINES : 0U) |
                                             ((options & 0x4U) != 0U ? FFX_FRAMEGENERATION_FLAG_DRAW_DEBUG_RESET_INDICATORS : 0U) |
@@ -213,12 +300,37 @@ void FSR_FrameGenerator::evaluate(bool enable, FfxApiRect2D generationRect, cons
       .generationRect                     = generationRect,
       .frameID                            = 0,  // This can be set to zero because it is later assigned above.
     };
-    if (FSR_Upscaler::ffxConfigure(&context, &configureDescFrameGeneration.header) != FFX_API_RETURN_OK)
-        Plugin::log(kUnityLogTypeError, "Failed to configure frame generation.");
+    if (FSR_Upscaler::api.ffxConfigure(&context, &configureDescFrameGeneration.header) != FFX_API_RETURN_OK)
+        Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Failed to configure frame generation.");
 
     if (configureDescFrameGeneration.frameGenerationEnabled) {
-        UnityVulkanRecordingState state{};
+        Vulkan::getGraphicsInterface()->EnsureOutsideRenderPass();
         Vulkan::getGraphicsInterface()->CommandRecordingState(&state, kUnityVulkanGraphicsQueueAccess_DontCare);
+        UnityVulkanImage image{};
+        barriers.clear();
+#ifdef ENABLE_PREPROCESSING
+        // FFX's frame generation has no option for Unity's bottom-up images, so they are flipped on the way in. The copies'
+        // destinations stay in the general layout that the copy writes them in.
+        const Vulkan::Preprocess::Copies copies{{
+          {depthSource, depthTexture, true, true},
+          {motionSource, motionTexture, true, true},
+          {nullptr, nullptr, false, false},
+        }};
+        if (!Vulkan::Preprocess::add(barriers, copies))
+            return Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Unity provided a `VK_NULL_HANDLE` image to preprocess.");
+#else
+        if (depthSource != nullptr || motionSource != nullptr)
+            return Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "The plugin was built without preprocessing, so Unity must flip the depth and motion vector images itself.");
+#endif
+        if ((depthSource == nullptr && !barriers.add(depthTexture, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_ACCESS_2_SHADER_READ_BIT, image)) || (motionSource == nullptr && !barriers.add(motionTexture, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, VK_ACCESS_2_SHADER_READ_BIT, image)))
+            return Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Unity provided a `VK_NULL_HANDLE` image.");
+        barriers.record(state.commandBuffer);
+#ifdef ENABLE_PREPROCESSING
+        if (!Vulkan::Preprocess::record(state.commandBuffer, copies)) {
+            barriers.restore(state.commandBuffer);
+            return Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Failed to preprocess the depth and motion vector images.");
+        }
+#endif
 
         ffxDispatchDescFrameGenerationPrepareCameraInfo dispatchDescFrameGenerationPrepareCameraInfo{
           .header = {
@@ -250,12 +362,21 @@ void FSR_FrameGenerator::evaluate(bool enable, FfxApiRect2D generationRect, cons
           .depth                   = depthResource,
           .motionVectors           = motionResource,
         };
-        if (FSR_Upscaler::ffxDispatch(&context, &dispatchDescFrameGenerationPrepare.header) != FFX_API_RETURN_OK)
-            Plugin::log(kUnityLogTypeError, "Failed to dispatch frame generation prepare command.");
+        timestamps.begin(state.commandBuffer, timings);
+        if (FSR_Upscaler::api.ffxDispatch(&context, &dispatchDescFrameGenerationPrepare.header) != FFX_API_RETURN_OK) {
+            Stats::add(Stats::FailedDispatches);
+            Plugin::log(LogQueue::Error, LogQueue::FrameGeneration, "Failed to dispatch frame generation prepare command.");
+        }
+        timestamps.end(state.commandBuffer);
+        barriers.restore(state.commandBuffer);
     }
 }
 
 ffxContext* FSR_FrameGenerator::getContext() {
     return &swapchainContext;
 }
+
+Timings::Summary FSR_FrameGenerator::getTimings() const {
+    return timings.summarize();
+}
 #endif
\ No newline at end of file
@@ -3,48 +3,97 @@
 #include "FrameGenerator.hpp"
 
 #ifdef ENABLE_VULKAN
+#    include "GraphicsAPI/Vulkan.hpp"
+
 #    include <vk/ffx_api_vk.h>
 
 #    include <vulkan/vulkan.h>
 #endif
 
+#include "Utilities/Timings.hpp"
+
 #include <ffx_api.h>
 
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <span>
 
 #ifdef ENABLE_VULKAN
 struct VqsQueueSelection;
 #endif
 
-class FSR_FrameGenerator final : protected FrameGenerator {
-    static ffxContext swapchainContext;
-    static ffxContext context;
-    static std::array<FfxApiResource, 2> hudlessColorResource;
-    static FfxApiResource depthResource;
-    static FfxApiResource motionResource;
+class FSR_FrameGenerator final : public FrameGenerator {
+    ffxContext swapchainContext{nullptr};
+    ffxContext context{nullptr};
+    std::array<FfxApiResource, HudlessRing::MaxDepth> hudlessColorResource{};
+    /// The HUD-less images last set by the game thread. `evaluate` copies them into `hudlessColorResource` when it
+    /// applies the matching resize of the ring.
+    std::array<FfxApiResource, HudlessRing::MaxDepth> stagedHudlessColorResource{};
+    std::mutex                                        staging;
+    FfxApiResource depthResource{};
+    FfxApiResource motionResource{};
+    void*          depthTexture{nullptr};
+    void*          motionTexture{nullptr};
+    Vulkan::BarrierBatch barriers{};
+    Vulkan::TimestampRing timestamps{};
+    Timings               timings{};
+    /// Read by FFX's frame generation callback, which runs on its own thread behind the present.
+    std::atomic<bool> reset{false};
+    uint32_t          frameNumber{};
+    /// Whether the previous `evaluate` generated a frame.
+    bool generated{false};
+    /// The texture that the swapchain composites over every presented frame, or `nullptr` to use the HUD-less ring.
+    /// Written by the game thread, read by `evaluate` on the render thread.
+    std::atomic<void*>    uiTexture{nullptr};
+    std::atomic<uint32_t> uiFlags{0U};
+    /// Whether the previous `evaluate` registered a UI resource with the swapchain.
+    bool composed{false};
+    /// Applied to every swapchain context this generator creates, once set.
+    FfxApiSwapchainFramePacingTuning pacingTuning{};
+    bool                             tuned{false};
+
+    bool applyPacingTuning();
+    bool registerUiResource(const FfxApiResource& resource, uint32_t flags);
 
     static struct alignas(8) QueueData {
         uint32_t family{}, index{};
     } asyncCompute, present, imageAcquire;
     static bool asyncComputeSupported;
-    static struct alignas(16) CallbackContext {
-        ffxContext* context;
-        bool reset;
-    } callbackContext;
+    /// The number of live instances. FFX stays loaded while any exist. Generators are created on the game thread and
+    /// deleted on the render thread.
+    static std::atomic<uint32_t> instances;
 
 public:
+    FSR_FrameGenerator();
+    FSR_FrameGenerator(const FSR_FrameGenerator&)            = delete;
+    FSR_FrameGenerator(FSR_FrameGenerator&&)                 = delete;
+    FSR_FrameGenerator& operator=(const FSR_FrameGenerator&) = delete;
+    FSR_FrameGenerator& operator=(FSR_FrameGenerator&&)      = delete;
+    ~FSR_FrameGenerator() override;
+
 #ifdef ENABLE_VULKAN
     static void useQueues(std::vector<VqsQueueSelection> selection);
 #endif
 
-    static void createSwapchain(VkSwapchainKHR* pSwapchain, const VkSwapchainCreateInfoKHR* pCreateInfo, VkAllocationCallbacks* pAllocator, PFN_vkCreateSwapchainFFXAPI* pCreate, PFN_vkDestroySwapchainFFXAPI* pDestroy, PFN_vkGetSwapchainImagesKHR* pGet, PFN_vkAcquireNextImageKHR* pAcquire, PFN_vkQueuePresentKHR* pPresent, PFN_vkSetHdrMetadataEXT* pSet, PFN_getLastPresentCountFFXAPI* pCount);
+    void createSwapchain(VkSwapchainKHR* pSwapchain, const VkSwapchainCreateInfoKHR* pCreateInfo, VkAllocationCallbacks* pAllocator, PFN_vkCreateSwapchainFFXAPI* pCreate, PFN_vkDestroySwapchainFFXAPI* pDestroy, PFN_vkGetSwapchainImagesKHR* pGet, PFN_vkAcquireNextImageKHR* pAcquire, PFN_vkQueuePresentKHR* pPresent, PFN_vkSetHdrMetadataEXT* pSet, PFN_getLastPresentCountFFXAPI* pCount);
+
+    void destroySwapchain();
 
-    static void destroySwapchain();
+    /// Replaces FFX's frame pacing parameters, now and for every swapchain created after this.
+    bool setPacingTuning(const FfxApiSwapchainFramePacingTuning& tuning);
 
-    static void useImages(VkImage color0, VkImage color1, VkImage depth, VkImage motion);
+    void useImages(std::span<const VkImage> colors, VkImage depth, VkImage motion);
+    /// Has the swapchain composite `ui` over the real and the interpolated frames, so that the application renders its
+    /// UI there instead of providing HUD-less copies of the back buffer. `nullptr` goes back to the HUD-less ring.
+    void useUiImage(VkImage ui, bool premultipliedAlpha);
 
-    static void evaluate(bool enable, FfxApiRect2D generationRect, const float cameraPosition[], const float cameraUp[], const float cameraRight[], const float cameraForward[], FfxApiFloatCoords2D renderSize, FfxApiFloatCoords2D jitter, float frameTime, float farPlane, float nearPlane, float verticalFOV, unsigned index, unsigned options);
+    /// `depthSource` and `motionSource` are the camera's own images, which are copied flipped into the images given to
+    /// `useImages` before the prepare dispatch, or `nullptr` if Unity already filled those images.
+    void evaluate(bool enable, FfxApiRect2D generationRect, const float cameraPosition[], const float cameraUp[], const float cameraRight[], const float cameraForward[], FfxApiFloatCoords2D renderSize, FfxApiFloatCoords2D jitter, float frameTime, float farPlane, float nearPlane, float verticalFOV, uint32_t ticket, unsigned options, void* depthSource, void* motionSource);
 
-    static ffxContext* getContext();
+    ffxContext* getContext();
+    /// GPU time spent in the prepare dispatch. The frame interpolation itself runs behind the present and is not timed.
+    Timings::Summary getTimings() const;
 };
-#endif
\ No newline at end of file
+#endif
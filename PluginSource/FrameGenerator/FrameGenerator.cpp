@@ -1,72 +1,182 @@
+#ifdef ENABLE_FRAME_GENERATION
 #include "FrameGenerator.hpp"
 
-#include <ranges>
-
 #ifdef ENABLE_FSR
 #include "FSR_FrameGenerator.hpp"
 #endif
 
-std::unordered_map<HWND, VkSurfaceKHR> FrameGenerator::HWNDToSurface{};
-std::unordered_map<VkSurfaceKHR, VkSwapchainKHR> FrameGenerator::SurfaceToSwapchain{};
-std::unordered_map<VkSwapchainKHR, UnityRenderingExtTextureFormat> FrameGenerator::swapchainToBackbufferFormat{};
-FrameGenerator::Swapchain FrameGenerator::swapchain{};
+#include <algorithm>
 
-void FrameGenerator::addMapping(HWND hWnd, VkSurfaceKHR surface) {
-    HWNDToSurface[hWnd] = surface;
+std::mutex FrameGenerator::registry{};
+HandleMap<HWND, VkSurfaceKHR, FrameGenerator::MaxSwapchains> FrameGenerator::HWNDToSurface{};
+HandleMap<VkSurfaceKHR, HWND, FrameGenerator::MaxSwapchains> FrameGenerator::surfaceToHWND{};
+HandleMap<VkSurfaceKHR, VkSwapchainKHR, FrameGenerator::MaxSwapchains> FrameGenerator::surfaceToSwapchain{};
+HandleMap<VkSwapchainKHR, FrameGenerator::SwapchainState, FrameGenerator::MaxSwapchains> FrameGenerator::swapchains{};
+HandleMap<HWND, FrameGenerator*, FrameGenerator::MaxSwapchains> FrameGenerator::HWNDToGenerator{};
+
+void FrameGenerator::HudlessRing::resize(const uint32_t count) {
+    pendingDepth.store(std::clamp(count, MinDepth, MaxDepth), std::memory_order_release);
 }
 
-void FrameGenerator::addMapping(VkSurfaceKHR surface, VkSwapchainKHR swapchain, UnityRenderingExtTextureFormat format) {
-    swapchainToBackbufferFormat[swapchain] = format;
-    SurfaceToSwapchain[surface] = swapchain;
+bool FrameGenerator::HudlessRing::applyResize(const uint64_t frame) {
+    uint32_t count = pendingDepth.load(std::memory_order_acquire);
+    if (count == 0U) return false;
+    depth = count;
+    for (Slot& slot : slots) {
+        slot.ticket.store(0U, std::memory_order_relaxed);
+        slot.freeAfter.store(frame, std::memory_order_relaxed);
+    }
+    // If the game thread asked for another resize in the meantime, that one is applied with the next frame instead.
+    pendingDepth.compare_exchange_strong(count, 0U, std::memory_order_release, std::memory_order_relaxed);
+    return true;
 }
 
-void FrameGenerator::removeMapping(VkSurfaceKHR surface) {
-    for (auto [hWnd, surf] : HWNDToSurface) {
-        if (surface == surf) {
-            HWNDToSurface.erase(hWnd);
-            break;
+uint32_t FrameGenerator::HudlessRing::acquire(uint32_t& ticket) {
+    ticket = Unavailable;
+    if (pendingDepth.load(std::memory_order_acquire) != 0U) return Unavailable;
+    const uint64_t safe = safeFrame.load(std::memory_order_acquire);
+    uint32_t       best{Unavailable};
+    uint64_t       bestFreeAfter{UINT64_MAX};
+    for (uint32_t index{}; index < depth; ++index) {
+        const uint64_t freeAfter = slots[index].freeAfter.load(std::memory_order_acquire);
+        // Slots that are acquired (`UINT64_MAX`) or that the GPU may still read are never handed out.
+        if (freeAfter > safe) continue;
+        if (best == Unavailable || freeAfter < bestFreeAfter) {
+            best          = index;
+            bestFreeAfter = freeAfter;
         }
     }
+    if (best == Unavailable) return Unavailable;
+    // Zero marks a slot that was never acquired and `Unavailable` a frame without one, so both are skipped on wrap.
+    if (++nextTicket == Unavailable) nextTicket = 1U;
+    ticket = nextTicket;
+    slots[best].ticket.store(ticket, std::memory_order_relaxed);
+    slots[best].freeAfter.store(UINT64_MAX, std::memory_order_release);
+    return best;
 }
 
-void FrameGenerator::removeMapping(VkSwapchainKHR swapchain) {
-    swapchainToBackbufferFormat.erase(swapchain);
-    for (auto [surf, swap] : SurfaceToSwapchain) {
-        if (swapchain == swap) {
-            SurfaceToSwapchain.erase(surf);
-            break;
-        }
+uint32_t FrameGenerator::HudlessRing::consume(const uint32_t ticket, const uint64_t frame, const uint64_t safe) {
+    safeFrame.store(safe, std::memory_order_release);
+    if (ticket == Unavailable) return Unavailable;
+    uint32_t found{Unavailable};
+    for (uint32_t index{}; index < depth; ++index) {
+        if (slots[index].freeAfter.load(std::memory_order_acquire) != UINT64_MAX) continue;
+        const uint32_t slotTicket = slots[index].ticket.load(std::memory_order_relaxed);
+        if (slotTicket == ticket) found = index;
+        // Frames whose generate event never ran leave their acquisition behind; release it so the slot is not lost.
+        else if (static_cast<int32_t>(ticket - slotTicket) > 0) slots[index].freeAfter.store(frame + 1U, std::memory_order_release);
     }
+    if (found != Unavailable) slots[found].freeAfter.store(frame + 1U, std::memory_order_release);
+    return found;
+}
+
+void FrameGenerator::retarget(HWND hWnd, FrameGenerator* target) {
+    if (SwapchainState* state = swapchains.find(getSwapchain(hWnd)); state != nullptr) state->target = target;
+}
+
+FrameGenerator::~FrameGenerator() {
+    setWindow(nullptr);
+}
+
+bool FrameGenerator::setWindow(HWND window) {
+    const std::lock_guard lock{registry};
+    if (window == hWnd) return true;
+    if (window != nullptr) {
+        FrameGenerator** entry = HWNDToGenerator.insert(window);
+        if (entry == nullptr || *entry != nullptr) return false;
+        *entry = this;
+    }
+    if (hWnd != nullptr) {
+        HWNDToGenerator.erase(hWnd);
+        retarget(hWnd, nullptr);
+    }
+    retarget(window, this);
+    hWnd = window;
+    return true;
+}
+
+void FrameGenerator::release(FrameGenerator* generator) {
+    if (generator == nullptr) return;
+    generator->setWindow(nullptr);
+    generator->released = true;
+    collect(generator);
+}
+
+bool FrameGenerator::collect(FrameGenerator* generator) {
+    if (!generator->released || generator->swapchain.vulkan != VK_NULL_HANDLE) return false;
+    delete generator;
+    return true;
 }
 
-VkSurfaceKHR FrameGenerator::getSurface(HWND hWnd) {
-    const auto it = HWNDToSurface.find(hWnd);
-    if (it == HWNDToSurface.end()) return VK_NULL_HANDLE;
-    return it->second;
+uint32_t FrameGenerator::acquireHudless(uint32_t& ticket) {
+    return hudless.acquire(ticket);
+}
+
+bool FrameGenerator::owns(VkSwapchainKHR swapchain) const {
+    return this->swapchain.vulkan != VK_NULL_HANDLE && swapchain == this->swapchain.vulkan;
+}
+
+void FrameGenerator::addMapping(HWND hWnd, VkSurfaceKHR surface) {
+    const std::lock_guard lock{registry};
+    if (VkSurfaceKHR* entry = HWNDToSurface.insert(hWnd); entry != nullptr) *entry = surface;
+    if (HWND* entry = surfaceToHWND.insert(surface); entry != nullptr) *entry = hWnd;
+}
+
+void FrameGenerator::addMapping(VkSwapchainKHR swapchain, SwapchainState state) {
+    const std::lock_guard lock{registry};
+    if (VkSwapchainKHR* entry = surfaceToSwapchain.insert(state.surface); entry != nullptr) *entry = swapchain;
+    state.target = findTarget(state.surface);
+    if (SwapchainState* entry = swapchains.insert(swapchain); entry != nullptr) *entry = state;
+}
+
+void FrameGenerator::removeMapping(VkSurfaceKHR surface) {
+    const std::lock_guard lock{registry};
+    if (const HWND* hWnd = surfaceToHWND.find(surface); hWnd != nullptr) {
+        if (const VkSurfaceKHR* surf = HWNDToSurface.find(*hWnd); surf != nullptr && *surf == surface) HWNDToSurface.erase(*hWnd);
+        surfaceToHWND.erase(surface);
+    }
+    surfaceToSwapchain.erase(surface);
+}
+
+void FrameGenerator::removeMapping(VkSwapchainKHR swapchain) {
+    const std::lock_guard lock{registry};
+    const SwapchainState* state = swapchains.find(swapchain);
+    if (state == nullptr) return;
+    if (const VkSwapchainKHR* swap = surfaceToSwapchain.find(state->surface); swap != nullptr && *swap == swapchain) surfaceToSwapchain.erase(state->surface);
+    swapchains.erase(swapchain);
 }
 
 VkSwapchainKHR FrameGenerator::getSwapchain(HWND hWnd) {
-    const auto it = HWNDToSurface.find(hWnd);
-    if (it == HWNDToSurface.end()) return VK_NULL_HANDLE;
-    const auto it1 = SurfaceToSwapchain.find(it->second);
-    if (it1 == SurfaceToSwapchain.end()) return VK_NULL_HANDLE;
-    return it1->second;
+    const VkSurfaceKHR* surface = HWNDToSurface.find(hWnd);
+    if (surface == nullptr) return VK_NULL_HANDLE;
+    const VkSwapchainKHR* swapchain = surfaceToSwapchain.find(*surface);
+    return swapchain == nullptr ? VK_NULL_HANDLE : *swapchain;
 }
 
-VkSwapchainKHR FrameGenerator::getSwapchain(VkSurfaceKHR surface) {
-    const auto it = SurfaceToSwapchain.find(surface);
-    if (it == SurfaceToSwapchain.end()) return VK_NULL_HANDLE;
-    return it->second;
+FrameGenerator* FrameGenerator::findTarget(VkSurfaceKHR surface) {
+    const HWND* hWnd = surfaceToHWND.find(surface);
+    if (hWnd == nullptr) return nullptr;
+    FrameGenerator* const* generator = HWNDToGenerator.find(*hWnd);
+    return generator == nullptr ? nullptr : *generator;
 }
 
 UnityRenderingExtTextureFormat FrameGenerator::getBackBufferFormat(HWND hWnd) {
     if (hWnd == nullptr) return kUnityRenderingExtFormatNone;
-    VkSwapchainKHR swapchain = getSwapchain(hWnd);
-    const auto it = swapchainToBackbufferFormat.find(swapchain);
-    if (it == swapchainToBackbufferFormat.end()) return kUnityRenderingExtFormatNone;
-    return it->second;
+    const std::lock_guard lock{registry};
+    const SwapchainState* state = swapchains.find(getSwapchain(hWnd));
+    return state == nullptr ? kUnityRenderingExtFormatNone : state->format;
 }
 
-bool FrameGenerator::ownsSwapchain(VkSwapchainKHR swapchain) {
-    return FrameGenerator::swapchain.vulkan != VK_NULL_HANDLE && swapchain == FrameGenerator::swapchain.vulkan;
-}
\ No newline at end of file
+bool FrameGenerator::getState(VkSwapchainKHR swapchain, SwapchainState& state) {
+    const std::lock_guard lock{registry};
+    const SwapchainState* entry = swapchains.find(swapchain);
+    if (entry == nullptr) return false;
+    state = *entry;
+    return true;
+}
+
+FrameGenerator* FrameGenerator::getTarget(VkSurfaceKHR surface) {
+    const std::lock_guard lock{registry};
+    return findTarget(surface);
+}
+#endif
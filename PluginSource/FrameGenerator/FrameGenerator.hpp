@@ -1,26 +1,126 @@
 #pragma once
 
-#include <vcruntime.h>
-
 #include <IUnityRenderingExtensions.h>
 #ifdef ENABLE_FRAME_GENERATION
 #    ifdef ENABLE_VULKAN
 #        include <vulkan/vulkan.h>
 #    endif
+#    ifdef ENABLE_FSR
+#        include <vk/ffx_api_vk.h>
+#    endif
 
-#    include <unordered_map>
+#    include "Utilities/FrameGenerationGovernor.hpp"
+#    include "Utilities/HandleMap.hpp"
+#    include "Utilities/PacingMonitor.hpp"
+
+#    include <array>
+#    include <atomic>
+#    include <mutex>
 
 class FrameGenerator {
+public:
+    /// The most swapchains (and surfaces, and windows) that are tracked at once. Presents that name more swapchains than
+    /// this are passed straight through.
+    static constexpr uint32_t MaxSwapchains{32U};
+
+#    ifdef ENABLE_FSR
+    /// The replacement entry points that FFX hands out for the swapchains it creates.
+    struct Proxies {
+        PFN_vkCreateSwapchainFFXAPI   create;
+        PFN_vkDestroySwapchainFFXAPI  destroy;
+        PFN_vkGetSwapchainImagesKHR   getImages;
+        PFN_vkAcquireNextImageKHR     acquire;
+        PFN_vkQueuePresentKHR         present;
+        PFN_vkSetHdrMetadataEXT       setHdrMetadata;
+        PFN_getLastPresentCountFFXAPI lastPresentCount;
+    };
+#    endif
+
+    /// Everything the swapchain hooks need to know about one swapchain, found with a single lookup.
+    struct SwapchainState {
+        VkSurfaceKHR                   surface;
+        UnityRenderingExtTextureFormat format;
+        /// The frame generator that created the swapchain, or `nullptr` if the driver did.
+        FrameGenerator* owner;
+        /// The frame generator configured for the swapchain's window, or `nullptr` if there is none. The swapchain is
+        /// reported out of date until it is recreated by this generator, so `owner` and `target` only differ briefly.
+        FrameGenerator* target;
+#    ifdef ENABLE_FSR
+        Proxies proxies;
+#    endif
+    };
+
+    /// The HUD-less color images of one frame generator. The game thread acquires a slot for every frame that it
+    /// records and writes that slot's image; the render thread then consumes the acquisition by its ticket. A slot is
+    /// handed out again only once Unity reports that the GPU has finished the frame after the one that read it, because
+    /// the interpolation that reads it runs behind that frame's present. Tickets rather than indices cross the API, so a
+    /// stale or forged ticket can never make the interpolation read an image that is being written. The game thread may
+    /// swap the images at any time, but the slots are only reset on the render thread, between two frames.
+    class HudlessRing {
+    public:
+        static constexpr uint32_t MinDepth{2U};
+        static constexpr uint32_t MaxDepth{4U};
+        static constexpr uint32_t Unavailable{~0U};
+
+    private:
+        struct Slot {
+            /// The ticket of the acquisition that last handed out this slot.
+            std::atomic<uint32_t> ticket{0U};
+            /// The slot may be reused once Unity's safe frame number reaches this. `UINT64_MAX` while acquired.
+            std::atomic<uint64_t> freeAfter{0U};
+        };
+
+        std::array<Slot, MaxDepth> slots{};
+        /// Only written by the render thread while `pendingDepth` keeps the game thread from acquiring.
+        uint32_t                   depth{MinDepth};
+        uint32_t                   nextTicket{0U};
+        std::atomic<uint64_t>      safeFrame{0U};
+        /// The depth requested by the last `resize` that the render thread has not applied yet, or zero.
+        std::atomic<uint32_t>      pendingDepth{0U};
+
+    public:
+        /// Asks the render thread to start over with `count` images, clamped to [`MinDepth`, `MaxDepth`]. Nothing is
+        /// acquired until it has. Game thread only.
+        void resize(uint32_t count);
+        /// Applies the last `resize`, if any, and returns whether it did. Outstanding tickets become invalid, and the
+        /// slots are held until the GPU has finished `frame`, since the old images may be the new ones. Render thread only.
+        bool applyResize(uint64_t frame);
+        /// Picks the least recently used slot that the GPU is done with. Returns its index and stores the acquisition's
+        /// ticket in `ticket`, or returns `Unavailable` (and stores it in `ticket`) if every slot is still in flight or a
+        /// resize is pending. Game thread only.
+        uint32_t acquire(uint32_t& ticket);
+        /// Resolves `ticket` to its slot on the render thread and marks that slot as read by `frame`. Acquisitions older
+        /// than `ticket` that were never consumed are released too. Returns `Unavailable` for unknown tickets. Frames that
+        /// got no slot pass `Unavailable` as their ticket, which only publishes `safe` for later acquisitions.
+        uint32_t consume(uint32_t ticket, uint64_t frame, uint64_t safe);
+    };
+
 protected:
-    static std::unordered_map<HWND, VkSurfaceKHR> HWNDToSurface;
-    static std::unordered_map<VkSurfaceKHR, VkSwapchainKHR> SurfaceToSwapchain;
-    static std::unordered_map<VkSwapchainKHR, UnityRenderingExtTextureFormat> swapchainToBackbufferFormat;
+    /// Guards the maps below and every generator's `hWnd`. The game thread points generators at windows while the
+    /// swapchain hooks look swapchains up on the render thread, so the hooks only ever work on copies of the entries.
+    /// Generators are only deleted on the render thread, so the generators that a copy names stay valid there.
+    static std::mutex                                               registry;
+    static HandleMap<HWND, VkSurfaceKHR, MaxSwapchains>             HWNDToSurface;
+    static HandleMap<VkSurfaceKHR, HWND, MaxSwapchains>             surfaceToHWND;
+    static HandleMap<VkSurfaceKHR, VkSwapchainKHR, MaxSwapchains>   surfaceToSwapchain;
+    static HandleMap<VkSwapchainKHR, SwapchainState, MaxSwapchains> swapchains;
+    static HandleMap<HWND, FrameGenerator*, MaxSwapchains>          HWNDToGenerator;
 
-    static union Swapchain {
+    /// The window this generator interpolates, and the swapchain it created for that window.
+    HWND hWnd{nullptr};
+    union Swapchain {
 #    ifdef ENABLE_VULKAN
         VkSwapchainKHR vulkan{VK_NULL_HANDLE};
 #    endif
     } swapchain;
+    /// Set once the application is done with this generator. It is deleted as soon as its swapchain is gone.
+    bool released{false};
+    HudlessRing hudless;
+
+    /// The helpers below expect `registry` to be locked already.
+    static void            retarget(HWND hWnd, FrameGenerator* target);
+    static VkSwapchainKHR  getSwapchain(HWND hWnd);
+    static FrameGenerator* findTarget(VkSurfaceKHR surface);
 
 public:
     FrameGenerator()                                 = default;
@@ -28,16 +128,36 @@ public:
     FrameGenerator(FrameGenerator&&)                 = delete;
     FrameGenerator& operator=(const FrameGenerator&) = delete;
     FrameGenerator& operator=(FrameGenerator&&)      = delete;
-    virtual ~FrameGenerator()                        = default;
+    virtual ~FrameGenerator();
+
+    /// Fed by the present hook for every present of this generator's swapchain.
+    PacingMonitor pacing;
+    /// Fed by the present hook as well; decides whether `evaluate` actually generates frames.
+    FrameGenerationGovernor governor;
+
+    /// Points this generator at `hWnd`, or at no window if it is `nullptr`. Fails if another generator already owns
+    /// the window. The window's swapchain is reported out of date until it has been recreated by this generator.
+    bool setWindow(HWND hWnd);
+    /// Detaches this generator from its window and deletes it once the swapchain it created has been destroyed. Runs on
+    /// the render thread behind every generate event that names `generator`, like the swapchain hooks that collect it.
+    static void release(FrameGenerator* generator);
+    /// Deletes `generator` if it has been released and no longer has a swapchain. Returns whether it was deleted. Only
+    /// called on the render thread.
+    static bool collect(FrameGenerator* generator);
+    [[nodiscard]] bool owns(VkSwapchainKHR swapchain) const;
+    /// Picks the HUD-less image that the next frame should write. See `HudlessRing::acquire`.
+    uint32_t acquireHudless(uint32_t& ticket);
 
-    static void                           addMapping(HWND hWnd, VkSurfaceKHR surface);
-    static void                           addMapping(VkSurfaceKHR surface, VkSwapchainKHR swapchain, UnityRenderingExtTextureFormat format);
+    static void addMapping(HWND hWnd, VkSurfaceKHR surface);
+    /// Registers a swapchain created for `state.surface`. Its `target` is filled in from the window's configuration.
+    /// Swapchains that do not fit into the registry are left to the driver.
+    static void                           addMapping(VkSwapchainKHR swapchain, SwapchainState state);
     static void                           removeMapping(VkSurfaceKHR surface);
     static void                           removeMapping(VkSwapchainKHR swapchain);
-    static VkSurfaceKHR                   getSurface(HWND hWnd);
-    static VkSwapchainKHR                 getSwapchain(HWND hWnd);
-    static VkSwapchainKHR                 getSwapchain(VkSurfaceKHR hWnd);
     static UnityRenderingExtTextureFormat getBackBufferFormat(HWND hWnd);
-    static bool                           ownsSwapchain(VkSwapchainKHR swapchain);
+    /// Copies the state of `swapchain` into `state`. Returns `false` if the swapchain is not registered.
+    static bool                           getState(VkSwapchainKHR swapchain, SwapchainState& state);
+    /// Returns the frame generator configured for the window that `surface` presents to, if any.
+    static FrameGenerator*                getTarget(VkSurfaceKHR surface);
 };
-#endif
\ No newline at end of file
+#endif
@@ -1,11 +1,37 @@
 #ifdef ENABLE_DX12
 #    include "DX12.hpp"
 
+#    include "Utilities/PipelineCache.hpp"
+
 #    include <d3d12compatibility.h>
+#    include <dxgi1_4.h>
 
 #    include <IUnityGraphicsD3D12.h>
 
+#    include <utility>
+
 IUnityGraphicsD3D12v7* DX12::graphicsInterface{nullptr};
+ID3D12PipelineLibrary* DX12::pipelineLibrary{nullptr};
+std::vector<char>      DX12::pipelineLibraryData{};
+std::string            DX12::pipelineLibraryKey{};
+std::mutex             DX12::pipelineLibraryMutex{};
+
+std::string DX12::deviceKey() {
+    const LUID     luid    = graphicsInterface->GetDevice()->GetAdapterLuid();
+    IDXGIFactory4* factory = nullptr;
+    IDXGIAdapter1* adapter = nullptr;
+    DXGI_ADAPTER_DESC1 description{};
+    LARGE_INTEGER      driverVersion{};
+    if (SUCCEEDED(CreateDXGIFactory1(IID_PPV_ARGS(&factory)))) {
+        if (SUCCEEDED(factory->EnumAdapterByLuid(luid, IID_PPV_ARGS(&adapter)))) {
+            adapter->GetDesc1(&description);
+            adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion);
+            adapter->Release();
+        }
+        factory->Release();
+    }
+    return PipelineCache::key(description.VendorId, description.DeviceId, driverVersion.QuadPart);
+}
 
 bool DX12::registerUnityInterfaces(IUnityInterfaces* t_unityInterfaces) {
     graphicsInterface = t_unityInterfaces->Get<IUnityGraphicsD3D12v7>();
@@ -16,6 +42,33 @@ IUnityGraphicsD3D12v7* DX12::getGraphicsInterface() {
     return graphicsInterface;
 }
 
+ID3D12PipelineLibrary* DX12::getPipelineLibrary() {
+    const std::lock_guard lock{pipelineLibraryMutex};
+    if (pipelineLibrary != nullptr) return pipelineLibrary;
+    ID3D12Device1* device = nullptr;
+    if (FAILED(graphicsInterface->GetDevice()->QueryInterface(IID_PPV_ARGS(&device)))) return nullptr;
+    pipelineLibraryKey = deviceKey();
+    // The library references this blob for as long as it lives, so it is kept alongside it.
+    pipelineLibraryData = PipelineCache::read(pipelineLibraryKey);
+    if (FAILED(device->CreatePipelineLibrary(pipelineLibraryData.data(), pipelineLibraryData.size(), IID_PPV_ARGS(&pipelineLibrary))) && !pipelineLibraryData.empty()) {
+        pipelineLibraryData.clear();
+        device->CreatePipelineLibrary(nullptr, 0U, IID_PPV_ARGS(&pipelineLibrary));
+    }
+    device->Release();
+    return pipelineLibrary;
+}
+
+void DX12::savePipelineLibrary() {
+    const std::lock_guard lock{pipelineLibraryMutex};
+    if (pipelineLibrary == nullptr) return;
+    std::vector<char> data(pipelineLibrary->GetSerializedSize());
+    if (FAILED(pipelineLibrary->Serialize(data.data(), data.size()))) data.clear();
+    pipelineLibrary->Release();
+    pipelineLibrary = nullptr;
+    pipelineLibraryData.clear();
+    PipelineCache::write(pipelineLibraryKey, std::move(data));
+}
+
 bool DX12::unregisterUnityInterfaces() {
     graphicsInterface = nullptr;
     return true;
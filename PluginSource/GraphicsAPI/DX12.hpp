@@ -2,10 +2,22 @@
 #ifdef ENABLE_DX12
 #    include "GraphicsAPI.hpp"
 
+#    include <mutex>
+#    include <string>
+#    include <vector>
+
 struct IUnityGraphicsD3D12v7;
+struct ID3D12PipelineLibrary;
 
 class DX12 final : public GraphicsAPI {
     static IUnityGraphicsD3D12v7* graphicsInterface;
+    static ID3D12PipelineLibrary* pipelineLibrary;
+    static std::vector<char>      pipelineLibraryData;
+    static std::string            pipelineLibraryKey;
+    /// Contexts are created on the workers of asynchronous context updates as well as on the game thread.
+    static std::mutex             pipelineLibraryMutex;
+
+    static std::string deviceKey();
 
 public:
     DX12()                       = delete;
@@ -17,6 +29,8 @@ public:
 
     static bool                   registerUnityInterfaces(IUnityInterfaces* t_unityInterfaces);
     static IUnityGraphicsD3D12v7* getGraphicsInterface();
+    static ID3D12PipelineLibrary* getPipelineLibrary();
+    static void                   savePipelineLibrary();
     static bool                   unregisterUnityInterfaces();
 };
 #endif
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Plugin.hpp"
 #include "Upscaler/Upscaler.hpp"
+#include "Utilities/ContextUpdate.hpp"
+#include "Utilities/PipelineCache.hpp"
 
 #ifdef ENABLE_VULKAN
 #    include "Vulkan.hpp"
@@ -38,7 +40,6 @@ void GraphicsAPI::initialize(const UnityGfxRenderer renderer) {
         case kUnityGfxRendererD3D12: {
             type = DX12;
             Upscaler::useGraphicsAPI(type);
-            Upscaler::load(DX12);
             break;
         }
 #endif
@@ -46,7 +47,6 @@ void GraphicsAPI::initialize(const UnityGfxRenderer renderer) {
         case kUnityGfxRendererD3D11: {
             type = DX11;
             Upscaler::useGraphicsAPI(type);
-            Upscaler::load(DX11);
             break;
         }
 #endif
@@ -59,9 +59,27 @@ void GraphicsAPI::initialize(const UnityGfxRenderer renderer) {
 }
 
 void GraphicsAPI::shutdown() {
+    // Updates that are still building contexts may be using the pipeline cache that is about to be saved and destroyed.
+    ContextUpdate::reap(true);
 #ifdef ENABLE_DLSS
     DLSS_Upscaler::shutdown();
 #endif
+    switch (type) {
+#ifdef ENABLE_VULKAN
+        case VULKAN:
+#    ifdef ENABLE_PREPROCESSING
+            Vulkan::Preprocess::destroy();
+#    endif
+            Vulkan::savePipelineCache();
+            Vulkan::destroyImageViews();
+            Vulkan::destroyTimestampPool();
+            break;
+#endif
+#ifdef ENABLE_DX12
+        case DX12: DX12::savePipelineLibrary(); break;
+#endif
+        default: break;
+    }
     type = NONE;
 }
 
@@ -94,6 +112,8 @@ bool GraphicsAPI::unregisterUnityInterfaces() {
 #ifdef ENABLE_DX11
     result &= DX11::unregisterUnityInterfaces();
 #endif
+    ContextUpdate::reap(true);
     Upscaler::unload();
+    PipelineCache::wait();
     return result;
 }
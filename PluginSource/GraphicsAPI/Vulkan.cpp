@@ -1,6 +1,7 @@
 #ifdef ENABLE_VULKAN
 #    include "Vulkan.hpp"
 
+#    include <FrameGenerator/FrameGenerator.hpp>
 #    include <Upscaler/Upscaler.hpp>
 #    ifdef ENABLE_DLSS
 #        include <Upscaler/DLSS_Upscaler.hpp>
@@ -13,10 +14,23 @@
 #        include "Upscaler/XeSS_Upscaler.hpp"
 #    endif
 
+#    include "Utilities/PipelineCache.hpp"
+#    include "Utilities/Stats.hpp"
+#    include "Utilities/Timings.hpp"
+#    include "Utilities/Trace.hpp"
+
 #    include <IUnityGraphicsVulkan.h>
 
-#    define VQS_IMPLEMENTATION
-#    include <vk_queue_selector.h>
+#    ifdef ENABLE_FRAME_GENERATION
+#        define VQS_IMPLEMENTATION
+#        include <vk_queue_selector.h>
+#    endif
+
+#    include <algorithm>
+#    include <array>
+#    include <cstring>
+#    include <utility>
+#    include <vector>
 
 PFN_vkGetInstanceProcAddr    Vulkan::m_vkGetInstanceProcAddr{VK_NULL_HANDLE};
 PFN_vkCreateInstance         Vulkan::m_vkCreateInstance{VK_NULL_HANDLE};
@@ -28,16 +42,10 @@ PFN_vkGetSwapchainImagesKHR  Vulkan::m_vkGetSwapchainImagesKHR{VK_NULL_HANDLE};
 PFN_vkAcquireNextImageKHR    Vulkan::m_vkAcquireNextImageKHR{VK_NULL_HANDLE};
 PFN_vkQueuePresentKHR        Vulkan::m_vkQueuePresentKHR{VK_NULL_HANDLE};
 PFN_vkSetHdrMetadataEXT      Vulkan::m_vkSetHdrMetadataEXT{VK_NULL_HANDLE};
+#ifdef ENABLE_FRAME_GENERATION
 PFN_vkCreateWin32SurfaceKHR  Vulkan::m_vkCreateWin32SurfaceKHR{VK_NULL_HANDLE};
-PFN_vkDestroySurfaceKHR      Vulkan::m_vkDestroySurfaceKHR{VK_NULL_HANDLE};
-#ifdef ENABLE_FSR
-PFN_vkCreateSwapchainFFXAPI  Vulkan::m_fxCreateSwapchainKHR{VK_NULL_HANDLE};
-PFN_vkDestroySwapchainFFXAPI Vulkan::m_fxDestroySwapchainKHR{VK_NULL_HANDLE};
-PFN_vkGetSwapchainImagesKHR  Vulkan::m_fxGetSwapchainImagesKHR{VK_NULL_HANDLE};
-PFN_vkAcquireNextImageKHR    Vulkan::m_fxAcquireNextImageKHR{VK_NULL_HANDLE};
-PFN_vkQueuePresentKHR        Vulkan::m_fxQueuePresentKHR{VK_NULL_HANDLE};
-PFN_vkSetHdrMetadataEXT      Vulkan::m_fxSetHdrMetadataEXT{VK_NULL_HANDLE};
 #endif
+PFN_vkDestroySurfaceKHR      Vulkan::m_vkDestroySurfaceKHR{VK_NULL_HANDLE};
 #ifdef ENABLE_DLSS
 PFN_vkGetInstanceProcAddr   Vulkan::m_slGetInstanceProcAddr{VK_NULL_HANDLE};
 PFN_vkCreateInstance        Vulkan::m_slCreateInstance{VK_NULL_HANDLE};
@@ -55,12 +63,31 @@ PFN_vkGetDeviceQueue                         Vulkan::m_vkGetDeviceQueue{VK_NULL_
 PFN_vkDestroyImage                           Vulkan::m_vkDestroyImage{VK_NULL_HANDLE};
 PFN_vkCreateImageView                        Vulkan::m_vkCreateImageView{VK_NULL_HANDLE};
 PFN_vkDestroyImageView                       Vulkan::m_vkDestroyImageView{VK_NULL_HANDLE};
+PFN_vkGetPipelineCacheData                   Vulkan::m_vkGetPipelineCacheData{VK_NULL_HANDLE};
+PFN_vkDestroyPipelineCache                   Vulkan::m_vkDestroyPipelineCache{VK_NULL_HANDLE};
+PFN_vkCmdPipelineBarrier                     Vulkan::m_vkCmdPipelineBarrier{VK_NULL_HANDLE};
+PFN_vkCmdPipelineBarrier2                    Vulkan::m_vkCmdPipelineBarrier2{VK_NULL_HANDLE};
+PFN_vkDestroyQueryPool                       Vulkan::m_vkDestroyQueryPool{VK_NULL_HANDLE};
+PFN_vkGetQueryPoolResults                    Vulkan::m_vkGetQueryPoolResults{VK_NULL_HANDLE};
+PFN_vkCmdResetQueryPool                      Vulkan::m_vkCmdResetQueryPool{VK_NULL_HANDLE};
+PFN_vkCmdWriteTimestamp                      Vulkan::m_vkCmdWriteTimestamp{VK_NULL_HANDLE};
+PFN_vkCmdWriteTimestamp2                     Vulkan::m_vkCmdWriteTimestamp2{VK_NULL_HANDLE};
 
 VkInstance Vulkan::instance{VK_NULL_HANDLE};
+bool       Vulkan::synchronization2{false};
+VkPipelineCache Vulkan::pipelineCache{VK_NULL_HANDLE};
+std::string     Vulkan::pipelineCacheKey{};
+std::mutex      Vulkan::pipelineCacheMutex{};
+std::unordered_multimap<VkImage, Vulkan::CachedImageView> Vulkan::imageViews{};
+std::mutex                                                Vulkan::imageViewMutex{};
+Vulkan::ImageViewCacheStats                               Vulkan::imageViewStats{};
+VkQueryPool           Vulkan::timestampPool{VK_NULL_HANDLE};
+bool                  Vulkan::timestampsAttempted{false};
+float                 Vulkan::timestampPeriod{0.0F};
+uint64_t              Vulkan::timestampMask{0U};
+std::vector<uint32_t> Vulkan::freeTimestampRings{};
+std::mutex            Vulkan::timestampMutex{};
 IUnityGraphicsVulkanV2* Vulkan::graphicsInterface{nullptr};
-HWND                    Vulkan::HWNDToIntercept{nullptr};
-VkSurfaceKHR            Vulkan::surfaceToIntercept{VK_NULL_HANDLE};
-VkSwapchainKHR          Vulkan::swapchainToIntercept{VK_NULL_HANDLE};
 
 PFN_vkVoidFunction Vulkan::hook_vkGetInstanceProcAddr(VkInstance instance, const char* name) {
     if (strcmp(name, "vkGetInstanceProcAddr") == 0) return reinterpret_cast<PFN_vkVoidFunction>(&hook_vkGetInstanceProcAddr);
@@ -85,16 +112,22 @@ PFN_vkVoidFunction Vulkan::hook_vkGetInstanceProcAddr(VkInstance instance, const
 #    endif
         return reinterpret_cast<PFN_vkVoidFunction>(&hook_vkCreateDevice);
     }
+#    ifdef ENABLE_FRAME_GENERATION
     if (strcmp(name, "vkCreateWin32SurfaceKHR") == 0) {
         m_vkCreateWin32SurfaceKHR = reinterpret_cast<PFN_vkCreateWin32SurfaceKHR>(m_vkGetInstanceProcAddr(instance, name));
         return reinterpret_cast<PFN_vkVoidFunction>(&hook_vkCreateWin32SurfaceKHR);
     }
+#    endif
     if (strcmp(name, "vkDestroySurfaceKHR") == 0) { return reinterpret_cast<PFN_vkVoidFunction>(m_vkDestroySurfaceKHR = reinterpret_cast<PFN_vkDestroySurfaceKHR>(m_vkGetInstanceProcAddr(instance, name))); }
     if (strcmp(name, "vkGetPhysicalDeviceQueueFamilyProperties") == 0) return reinterpret_cast<PFN_vkVoidFunction>(m_vkGetPhysicalDeviceQueueFamilyProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceQueueFamilyProperties>(m_vkGetInstanceProcAddr(instance, name)));
     if (strcmp(name, "vkGetPhysicalDeviceSurfaceSupportKHR") == 0) return reinterpret_cast<PFN_vkVoidFunction>(m_vkGetPhysicalDeviceSurfaceSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceSurfaceSupportKHR>(m_vkGetInstanceProcAddr(instance, name)));
     if (strcmp(name, "vkGetDeviceQueue") == 0) return reinterpret_cast<PFN_vkVoidFunction>(m_vkGetDeviceQueue = reinterpret_cast<PFN_vkGetDeviceQueue>(m_vkGetInstanceProcAddr(instance, name)));
     if (strcmp(name, "vkCreateImageView") == 0) return reinterpret_cast<PFN_vkVoidFunction>(m_vkCreateImageView = reinterpret_cast<PFN_vkCreateImageView>(m_vkGetInstanceProcAddr(instance, name)));
     if (strcmp(name, "vkDestroyImageView") == 0) return reinterpret_cast<PFN_vkVoidFunction>(m_vkDestroyImageView = reinterpret_cast<PFN_vkDestroyImageView>(m_vkGetInstanceProcAddr(instance, name)));
+    if (strcmp(name, "vkDestroyImage") == 0) {
+        m_vkDestroyImage = reinterpret_cast<PFN_vkDestroyImage>(m_vkGetInstanceProcAddr(instance, name));
+        return reinterpret_cast<PFN_vkVoidFunction>(&hook_vkDestroyImage);
+    }
     if (strcmp(name, "vkCreateSwapchainKHR") == 0) {
         m_vkCreateSwapchainKHR = reinterpret_cast<PFN_vkCreateSwapchainKHR>(m_vkGetInstanceProcAddr(instance, name));
 #    ifdef ENABLE_DLSS
@@ -146,10 +179,16 @@ PFN_vkVoidFunction Vulkan::hook_vkGetDeviceProcAddr(VkDevice device, const char*
     if (strcmp(name, "vkGetDeviceQueue") == 0) return reinterpret_cast<PFN_vkVoidFunction>(m_vkGetDeviceQueue = reinterpret_cast<PFN_vkGetDeviceQueue>(m_vkGetDeviceProcAddr(device, name)));
     if (strcmp(name, "vkCreateImageView") == 0) return reinterpret_cast<PFN_vkVoidFunction>(m_vkCreateImageView = reinterpret_cast<PFN_vkCreateImageView>(m_vkGetDeviceProcAddr(device, name)));
     if (strcmp(name, "vkDestroyImageView") == 0) return reinterpret_cast<PFN_vkVoidFunction>(m_vkDestroyImageView = reinterpret_cast<PFN_vkDestroyImageView>(m_vkGetDeviceProcAddr(device, name)));
+    if (strcmp(name, "vkDestroyImage") == 0) {
+        m_vkDestroyImage = reinterpret_cast<PFN_vkDestroyImage>(m_vkGetDeviceProcAddr(device, name));
+        return reinterpret_cast<PFN_vkVoidFunction>(&hook_vkDestroyImage);
+    }
+#    ifdef ENABLE_FRAME_GENERATION
     if (strcmp(name, "vkCreateWin32SurfaceKHR") == 0) {
         m_vkCreateWin32SurfaceKHR = reinterpret_cast<PFN_vkCreateWin32SurfaceKHR>(m_vkGetDeviceProcAddr(device, name));
         return reinterpret_cast<PFN_vkVoidFunction>(&hook_vkCreateWin32SurfaceKHR);
     }
+#    endif
     if (strcmp(name, "vkCreateSwapchainKHR") == 0) {
         m_vkCreateSwapchainKHR = reinterpret_cast<PFN_vkCreateSwapchainKHR>(m_vkGetDeviceProcAddr(device, name));
 #    ifdef ENABLE_DLSS
@@ -195,6 +234,7 @@ PFN_vkVoidFunction Vulkan::hook_vkGetDeviceProcAddr(VkDevice device, const char*
     return m_vkGetDeviceProcAddr(device, name);
 }
 
+#    ifdef ENABLE_FRAME_GENERATION
 VkSurfaceKHR Vulkan::createDummySurface(void*& hWnd) {
 #    ifdef WIN32
     HINSTANCE hInstance = GetModuleHandle(nullptr);
@@ -218,6 +258,7 @@ void Vulkan::destroyDummySurface(void* hWnd, VkSurfaceKHR dummySurface) {
     DestroyWindow(static_cast<HWND>(hWnd));
 #    endif
 }
+#    endif
 
 VkResult Vulkan::hook_vkCreateInstance(const VkInstanceCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkInstance* pInstance) {
     VkResult result{VK_SUCCESS};
@@ -232,6 +273,15 @@ VkResult Vulkan::hook_vkCreateInstance(const VkInstanceCreateInfo* pCreateInfo,
 
 VkResult Vulkan::hook_vkCreateDevice(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkDevice* pDevice) {
     static VkDeviceCreateInfo createInfo = *pCreateInfo;
+    // Barriers are recorded through synchronization2 only if Unity enabled it on the device it is creating.
+    m_vkCmdPipelineBarrier  = VK_NULL_HANDLE;
+    m_vkCmdPipelineBarrier2 = VK_NULL_HANDLE;
+    synchronization2        = false;
+    for (auto* next = static_cast<const VkBaseInStructure*>(pCreateInfo->pNext); next != nullptr; next = next->pNext) {
+        if (next->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES) synchronization2 |= reinterpret_cast<const VkPhysicalDeviceVulkan13Features*>(next)->synchronization2 == VK_TRUE;
+        if (next->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES) synchronization2 |= reinterpret_cast<const VkPhysicalDeviceSynchronization2Features*>(next)->synchronization2 == VK_TRUE;
+    }
+#ifdef ENABLE_FRAME_GENERATION
     void* hWnd = nullptr;
     const std::array asyncRequirements {
       VqsQueueRequirements{VK_QUEUE_TRANSFER_BIT, 0.9F, VK_NULL_HANDLE},
@@ -321,6 +371,7 @@ VkResult Vulkan::hook_vkCreateDevice(VkPhysicalDevice physicalDevice, const VkDe
         createInfo.queueCreateInfoCount = queueCreateInfos.size();
     }
     vqsDestroyQuery(query);
+#endif
 
 #ifdef ENABLE_DLSS
     if (m_slCreateDevice != VK_NULL_HANDLE) return m_slCreateDevice(physicalDevice, &createInfo, pAllocator, pDevice);
@@ -328,10 +379,10 @@ VkResult Vulkan::hook_vkCreateDevice(VkPhysicalDevice physicalDevice, const VkDe
     return m_vkCreateDevice(physicalDevice, &createInfo, pAllocator, pDevice);
 }
 
+#ifdef ENABLE_FRAME_GENERATION
 VkResult Vulkan::hook_vkCreateWin32SurfaceKHR(VkInstance instance, const VkWin32SurfaceCreateInfoKHR* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkSurfaceKHR* pSurface) {
     const VkResult result = m_vkCreateWin32SurfaceKHR(instance, pCreateInfo, pAllocator, pSurface);
     FrameGenerator::addMapping(pCreateInfo->hwnd, *pSurface);
-    if (HWNDToIntercept == pCreateInfo->hwnd) surfaceToIntercept = *pSurface;
     return result;
 }
 
@@ -339,84 +390,154 @@ void Vulkan::hook_vkDestroySurfaceKHR(VkInstance instance, VkSurfaceKHR surface,
     m_vkDestroySurfaceKHR(instance, surface, pAllocator);
     FrameGenerator::removeMapping(surface);
 }
+#endif
 
 VkResult Vulkan::hook_vkCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInfoKHR* pCreateInfo, VkAllocationCallbacks* pAllocator, VkSwapchainKHR* pSwapchain) {
+    TRACE_ZONE("hook_vkCreateSwapchainKHR");
     VkResult result = VK_RESULT_MAX_ENUM;
-#ifdef ENABLE_FSR
-    if (FrameGenerator::ownsSwapchain(*pSwapchain)) result = m_fxCreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain, FSR_FrameGenerator::getContext());
+#ifdef ENABLE_FRAME_GENERATION
+    FrameGenerator* const target = FrameGenerator::getTarget(pCreateInfo->surface);
+    FrameGenerator*       owner  = nullptr;
+#    ifdef ENABLE_FSR
+    FrameGenerator::Proxies proxies{};
+    if (FrameGenerator::SwapchainState state{}; FrameGenerator::getState(*pSwapchain, state) && state.owner != nullptr && state.owner == target) {
+        owner   = state.owner;
+        proxies = state.proxies;
+        result  = proxies.create(device, pCreateInfo, pAllocator, pSwapchain, static_cast<FSR_FrameGenerator*>(owner)->getContext());
+        if (!owner->owns(*pSwapchain)) owner = nullptr;
+    }
+#    endif
 #endif
     if (result == VK_RESULT_MAX_ENUM) {
         result = m_vkCreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain);
-        if (Plugin::frameGenerationProvider != Plugin::None && surfaceToIntercept == pCreateInfo->surface) {
+#ifdef ENABLE_FRAME_GENERATION
+        if (result == VK_SUCCESS && target != nullptr) {
             switch (Plugin::frameGenerationProvider) {
-#ifdef ENABLE_FSR
-                case Plugin::FSR: FSR_FrameGenerator::createSwapchain(pSwapchain, pCreateInfo, pAllocator, &m_fxCreateSwapchainKHR, &m_fxDestroySwapchainKHR, &m_fxGetSwapchainImagesKHR, &m_fxAcquireNextImageKHR, &m_fxQueuePresentKHR, &m_fxSetHdrMetadataEXT, nullptr); break;
-#endif
+#    ifdef ENABLE_FSR
+                case Plugin::FSR: static_cast<FSR_FrameGenerator*>(target)->createSwapchain(pSwapchain, pCreateInfo, pAllocator, &proxies.create, &proxies.destroy, &proxies.getImages, &proxies.acquire, &proxies.present, &proxies.setHdrMetadata, &proxies.lastPresentCount); break;
+#    endif
                 case Plugin::None:
                 default: break;
             }
+            if (target->owns(*pSwapchain)) owner = target;
         }
+#endif
     }
-    FrameGenerator::addMapping(pCreateInfo->surface, *pSwapchain, toUnityFormat(pCreateInfo->imageFormat));
-    if (surfaceToIntercept == pCreateInfo->surface) swapchainToIntercept = *pSwapchain;
+#ifdef ENABLE_FRAME_GENERATION
+    FrameGenerator::addMapping(*pSwapchain, {
+      .surface = pCreateInfo->surface,
+      .format  = toUnityFormat(pCreateInfo->imageFormat),
+      .owner   = owner,
+      .target  = nullptr,
+#    ifdef ENABLE_FSR
+      .proxies = proxies,
+#    endif
+    });
+#endif
     return result;
 }
 
 void Vulkan::hook_vkDestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks* pAllocator) {
+#ifdef ENABLE_FRAME_GENERATION
+    FrameGenerator::SwapchainState state{};
+    FrameGenerator* const          owner = FrameGenerator::getState(swapchain, state) ? state.owner : nullptr;
     FrameGenerator::removeMapping(swapchain);
-#ifdef ENABLE_FSR
-    if (FrameGenerator::ownsSwapchain(swapchain)) return FSR_FrameGenerator::destroySwapchain();
+    if (owner != nullptr) {
+        // The swapchain belongs to the generator's swapchain context. If the generator has since made a newer one, this
+        // swapchain went away with the context it replaced.
+        if (owner->owns(swapchain)) {
+            switch (Plugin::frameGenerationProvider) {
+#    ifdef ENABLE_FSR
+                case Plugin::FSR: static_cast<FSR_FrameGenerator*>(owner)->destroySwapchain(); break;
+#    endif
+                case Plugin::None:
+                default: break;
+            }
+        }
+        FrameGenerator::collect(owner);
+        return;
+    }
 #endif
     m_vkDestroySwapchainKHR(device, swapchain, pAllocator);
 }
 
 VkResult Vulkan::hook_vkGetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t* pSwapchainImageCount, VkImage* pSwapchainImages) {
-#ifdef ENABLE_FSR
-    if (FrameGenerator::ownsSwapchain(swapchain)) return m_fxGetSwapchainImagesKHR(device, swapchain, pSwapchainImageCount, pSwapchainImages);
+#if defined(ENABLE_FRAME_GENERATION) && defined(ENABLE_FSR)
+    if (FrameGenerator::SwapchainState state{}; FrameGenerator::getState(swapchain, state) && state.owner != nullptr) return state.proxies.getImages(device, swapchain, pSwapchainImageCount, pSwapchainImages);
 #endif
     return m_vkGetSwapchainImagesKHR(device, swapchain, pSwapchainImageCount, pSwapchainImages);
 }
 
 VkResult Vulkan::hook_vkAcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, const uint64_t timeout, VkSemaphore semaphore, VkFence fence, uint32_t* pImageIndex) {
-#ifdef ENABLE_FSR
-    const bool isFsrSwapchain = FrameGenerator::ownsSwapchain(swapchain);
-    if (isFsrSwapchain ^ (Plugin::frameGenerationProvider == Plugin::FSR) && swapchainToIntercept == swapchain) return VK_ERROR_OUT_OF_DATE_KHR;
-    if (isFsrSwapchain) return m_fxAcquireNextImageKHR(device, swapchain, timeout, semaphore, fence, pImageIndex);
+    TRACE_ZONE("hook_vkAcquireNextImageKHR");
+#if defined(ENABLE_FRAME_GENERATION) && defined(ENABLE_FSR)
+    if (FrameGenerator::SwapchainState state{}; FrameGenerator::getState(swapchain, state)) {
+        if (state.owner != state.target) {
+            Stats::add(Stats::ForcedOutOfDateAcquires);
+            return VK_ERROR_OUT_OF_DATE_KHR;
+        }
+        if (state.owner != nullptr) return state.proxies.acquire(device, swapchain, timeout, semaphore, fence, pImageIndex);
+    }
 #endif
     return m_vkAcquireNextImageKHR(device, swapchain, timeout, semaphore, fence, pImageIndex);
 }
 
 VkResult Vulkan::hook_vkQueuePresentKHR(VkQueue queue, const VkPresentInfoKHR* pPresentInfo) {
+    TRACE_ZONE("hook_vkQueuePresentKHR");
 #ifdef ENABLE_FRAME_GENERATION
-    const bool intercepting = swapchainToIntercept != nullptr;
-    VkPresentInfoKHR presentInfo = *pPresentInfo;
-    std::vector<VkSwapchainKHR> nativeSwapchains;
-    std::unordered_map<std::size_t, uint32_t> mapping;
-    uint32_t swapchainCount = presentInfo.swapchainCount;
-    nativeSwapchains.reserve(swapchainCount);
-    VkResult swapchainPresentResult = VK_SUCCESS;
-    for (; swapchainCount > 0; --swapchainCount) {
-        const uint32_t index = swapchainCount - 1;
-        const bool isFsrSwapchain = FrameGenerator::ownsSwapchain(pPresentInfo->pSwapchains[index]);
-        if (isFsrSwapchain || swapchainToIntercept == pPresentInfo->pSwapchains[index] && pPresentInfo->pResults != nullptr) mapping[-1] = index;
-        if ((isFsrSwapchain && !intercepting) || (!isFsrSwapchain && swapchainToIntercept == pPresentInfo->pSwapchains[index])) swapchainPresentResult = VK_ERROR_OUT_OF_DATE_KHR;
-        else if (isFsrSwapchain) swapchainPresentResult = m_fxQueuePresentKHR(queue, &presentInfo);
+    // Every swapchain that the plugin could intercept is in the registry, so a present naming more swapchains than the
+    // registry holds cannot involve frame generation.
+    if (pPresentInfo->swapchainCount > FrameGenerator::MaxSwapchains) return m_vkQueuePresentKHR(queue, pPresentInfo);
+    // The swapchains that go to the driver, compacted together with their image indices and their position in the
+    // application's arrays. Everything lives on the stack; this runs once per presented frame.
+    std::array<VkSwapchainKHR, FrameGenerator::MaxSwapchains> nativeSwapchains;
+    std::array<uint32_t, FrameGenerator::MaxSwapchains>       nativeImageIndices;
+    std::array<uint32_t, FrameGenerator::MaxSwapchains>       nativePositions;
+    std::array<VkResult, FrameGenerator::MaxSwapchains>       nativeResults;
+    uint32_t                                                  nativeCount{};
+    VkResult                                                  swapchainPresentResult = VK_SUCCESS;
+    // Each generated swapchain is presented on its own through its generator. Unity presents one window per call, so
+    // the application's wait semaphores are handed to whichever present is issued first.
+    bool waited{false};
+    for (uint32_t index{}; index < pPresentInfo->swapchainCount; ++index) {
+        FrameGenerator::SwapchainState state{};
+        const bool                     registered = FrameGenerator::getState(pPresentInfo->pSwapchains[index], state);
+        if (registered && state.owner != state.target) {
+            Stats::add(Stats::ForcedOutOfDatePresents);
+            swapchainPresentResult = VK_ERROR_OUT_OF_DATE_KHR;
+        }
+#    ifdef ENABLE_FSR
+        else if (registered && state.owner != nullptr) {
+            VkPresentInfoKHR presentInfo   = *pPresentInfo;
+            presentInfo.waitSemaphoreCount = waited ? 0U : pPresentInfo->waitSemaphoreCount;
+            presentInfo.swapchainCount     = 1U;
+            presentInfo.pSwapchains        = &pPresentInfo->pSwapchains[index];
+            presentInfo.pImageIndices      = &pPresentInfo->pImageIndices[index];
+            presentInfo.pResults           = nullptr;
+            swapchainPresentResult         = state.proxies.present(queue, &presentInfo);
+            waited                         = true;
+            state.owner->governor.record();
+            if (state.proxies.lastPresentCount != nullptr) state.owner->pacing.record(state.proxies.lastPresentCount(pPresentInfo->pSwapchains[index]));
+        }
+#    endif
         else {
-            nativeSwapchains.emplace_back(pPresentInfo->pSwapchains[index]);
-            if (pPresentInfo->pResults != nullptr) mapping[nativeSwapchains.size()] = index;
+            nativeSwapchains[nativeCount]   = pPresentInfo->pSwapchains[index];
+            nativeImageIndices[nativeCount] = pPresentInfo->pImageIndices[index];
+            nativePositions[nativeCount++]  = index;
+            continue;
         }
+        if (pPresentInfo->pResults != nullptr) pPresentInfo->pResults[index] = swapchainPresentResult;
     }
-    presentInfo.pSwapchains = nativeSwapchains.data();
-    presentInfo.swapchainCount = nativeSwapchains.size();
-    std::vector<VkResult> results(nativeSwapchains.size());
-    presentInfo.pResults = results.data();
-    if (presentInfo.swapchainCount == 0) return swapchainPresentResult;
+    if (nativeCount == 0) return swapchainPresentResult;
+    VkPresentInfoKHR presentInfo   = *pPresentInfo;
+    presentInfo.waitSemaphoreCount = waited ? 0U : pPresentInfo->waitSemaphoreCount;
+    presentInfo.swapchainCount     = nativeCount;
+    presentInfo.pSwapchains        = nativeSwapchains.data();
+    presentInfo.pImageIndices      = nativeImageIndices.data();
+    presentInfo.pResults           = nativeResults.data();
     const VkResult result = m_vkQueuePresentKHR(queue, &presentInfo);
     if (pPresentInfo->pResults != nullptr)
-        for (const auto & [src, dst] : mapping) {
-            if (src == -1) pPresentInfo->pResults[dst] = swapchainPresentResult;
-            else pPresentInfo->pResults[dst] = results[src];
-        }
+        for (uint32_t native{}; native < nativeCount; ++native) pPresentInfo->pResults[nativePositions[native]] = nativeResults[native];
     if (result == VK_ERROR_DEVICE_LOST || swapchainPresentResult == VK_ERROR_DEVICE_LOST) return VK_ERROR_DEVICE_LOST;
     if (result == VK_ERROR_SURFACE_LOST_KHR || swapchainPresentResult == VK_ERROR_SURFACE_LOST_KHR) return VK_ERROR_SURFACE_LOST_KHR;
     if (result == VK_ERROR_OUT_OF_DATE_KHR || swapchainPresentResult == VK_ERROR_OUT_OF_DATE_KHR) return VK_ERROR_OUT_OF_DATE_KHR;
@@ -429,22 +550,31 @@ VkResult Vulkan::hook_vkQueuePresentKHR(VkQueue queue, const VkPresentInfoKHR* p
 }
 
 void Vulkan::hook_vkSetHdrMetadataEXT(VkDevice device, uint32_t swapchainCount, const VkSwapchainKHR* pSwapchains, const VkHdrMetadataEXT* pMetadata) {
-#ifdef ENABLE_FRAME_GENERATION
-    std::vector<VkSwapchainKHR> nativeSwapchains;
-    nativeSwapchains.reserve(swapchainCount);
-    for (; swapchainCount > 0; --swapchainCount)
-        if (FrameGenerator::ownsSwapchain(pSwapchains[swapchainCount - 1])) m_fxSetHdrMetadataEXT(device, 1, &pSwapchains[swapchainCount - 1], pMetadata);
-        else nativeSwapchains.emplace_back(pSwapchains[swapchainCount - 1]);
-    pSwapchains = nativeSwapchains.data();
-    swapchainCount = nativeSwapchains.size();
-    if (swapchainCount == 0) return;
-#endif
+#if defined(ENABLE_FRAME_GENERATION) && defined(ENABLE_FSR)
+    if (swapchainCount > FrameGenerator::MaxSwapchains) return m_vkSetHdrMetadataEXT(device, swapchainCount, pSwapchains, pMetadata);
+    std::array<VkSwapchainKHR, FrameGenerator::MaxSwapchains>   nativeSwapchains;
+    std::array<VkHdrMetadataEXT, FrameGenerator::MaxSwapchains> nativeMetadata;
+    uint32_t                                                    nativeCount{};
+    for (uint32_t index{}; index < swapchainCount; ++index) {
+        if (FrameGenerator::SwapchainState state{}; FrameGenerator::getState(pSwapchains[index], state) && state.owner != nullptr) state.proxies.setHdrMetadata(device, 1, &pSwapchains[index], &pMetadata[index]);
+        else {
+            nativeSwapchains[nativeCount] = pSwapchains[index];
+            nativeMetadata[nativeCount++] = pMetadata[index];
+        }
+    }
+    if (nativeCount == 0) return;
+    return m_vkSetHdrMetadataEXT(device, nativeCount, nativeSwapchains.data(), nativeMetadata.data());
+#else
     return m_vkSetHdrMetadataEXT(device, swapchainCount, pSwapchains, pMetadata);
+#endif
 }
 
 PFN_vkGetInstanceProcAddr Vulkan::interceptInitialization(PFN_vkGetInstanceProcAddr t_getInstanceProcAddr, void* /*unused*/) {
     m_vkGetInstanceProcAddr = t_getInstanceProcAddr;
-    Upscaler::load(VULKAN, &m_slGetInstanceProcAddr);
+#    ifdef ENABLE_DLSS
+    // Streamline has to hook instance creation, so it cannot wait for the first `CreateContext`.
+    DLSS_Upscaler::load(VULKAN, &m_slGetInstanceProcAddr);
+#    endif
     return &hook_vkGetInstanceProcAddr;
 }
 
@@ -464,12 +594,6 @@ bool Vulkan::unregisterUnityInterfaces() {
 }
 
 #ifdef ENABLE_FRAME_GENERATION
-void Vulkan::setFrameGenerationHWND(HWND hWnd) {
-    HWNDToIntercept      = hWnd;
-    surfaceToIntercept   = FrameGenerator::getSurface(hWnd);
-    swapchainToIntercept = FrameGenerator::getSwapchain(surfaceToIntercept);
-}
-
 VkQueue Vulkan::getQueue(const uint32_t family, const uint32_t index) {
     VkQueue queue{VK_NULL_HANDLE};
     m_vkGetDeviceQueue(graphicsInterface->Instance().device, family, index, &queue);
@@ -477,7 +601,35 @@ VkQueue Vulkan::getQueue(const uint32_t family, const uint32_t index) {
 }
 #endif
 
-VkImageView Vulkan::createImageView(VkImage image, const VkFormat format, const VkImageAspectFlags flags) {
+void Vulkan::hook_vkDestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks* pAllocator) {
+    {
+        const std::lock_guard lock(imageViewMutex);
+        const auto [begin, end] = imageViews.equal_range(image);
+        if (begin != end) ++imageViewStats.invalidations;
+        for (auto entry = begin; entry != end; ++entry) m_vkDestroyImageView(device, entry->second.view, nullptr);
+        imageViews.erase(begin, end);
+    }
+    m_vkDestroyImage(device, image, pAllocator);
+}
+
+VkImageView Vulkan::getImageView(VkImage image, const VkFormat format, const VkImageAspectFlags flags) {
+    const VkImageSubresourceRange range {
+        .aspectMask     = flags,
+        .baseMipLevel   = 0U,
+        .levelCount     = 1U,
+        .baseArrayLayer = 0U,
+        .layerCount     = 1U,
+    };
+    const std::lock_guard lock(imageViewMutex);
+    const auto [begin, end] = imageViews.equal_range(image);
+    for (auto entry = begin; entry != end; ++entry) {
+        const VkImageSubresourceRange& cached = entry->second.range;
+        if (entry->second.format == format && cached.aspectMask == range.aspectMask && cached.baseMipLevel == range.baseMipLevel && cached.levelCount == range.levelCount && cached.baseArrayLayer == range.baseArrayLayer && cached.layerCount == range.layerCount) {
+            ++imageViewStats.hits;
+            return entry->second.view;
+        }
+    }
+    ++imageViewStats.misses;
     const VkImageViewCreateInfo createInfo {
       .sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
       .pNext    = nullptr,
@@ -486,29 +638,314 @@ VkImageView Vulkan::createImageView(VkImage image, const VkFormat format, const
       .viewType = VK_IMAGE_VIEW_TYPE_2D,
       .format   = format,
       .components = {VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY},
-      .subresourceRange = {
-        .aspectMask     = flags,
-        .baseMipLevel   = 0U,
-        .levelCount     = 1U,
-        .baseArrayLayer = 0U,
-        .layerCount     = 1U,
-      },
+      .subresourceRange = range,
     };
 
     VkImageView view{VK_NULL_HANDLE};
-    m_vkCreateImageView(graphicsInterface->Instance().device, &createInfo, nullptr, &view);
+    if (m_vkCreateImageView(graphicsInterface->Instance().device, &createInfo, nullptr, &view) == VK_SUCCESS) imageViews.emplace(image, CachedImageView{format, range, view});
     return view;
 }
 
-void Vulkan::destroyImageView(VkImageView viewToDestroy) {
-    if (viewToDestroy != VK_NULL_HANDLE) m_vkDestroyImageView(graphicsInterface->Instance().device, viewToDestroy, nullptr);
-    viewToDestroy = VK_NULL_HANDLE;
+void Vulkan::destroyImageViews() {
+    const std::lock_guard lock(imageViewMutex);
+    for (const auto& [image, cached] : imageViews) m_vkDestroyImageView(graphicsInterface->Instance().device, cached.view, nullptr);
+    imageViews.clear();
+}
+
+Vulkan::ImageViewCacheStats Vulkan::getImageViewCacheStats() {
+    const std::lock_guard lock(imageViewMutex);
+    ImageViewCacheStats stats = imageViewStats;
+    stats.views               = imageViews.size();
+    return stats;
+}
+
+void Vulkan::recordBarrier(VkCommandBuffer commandBuffer, const VkMemoryBarrier2& memoryBarrier, const std::span<const VkImageMemoryBarrier2> imageBarriers) {
+    if (m_vkCmdPipelineBarrier == VK_NULL_HANDLE) {
+        const VkDevice device = graphicsInterface->Instance().device;
+        m_vkCmdPipelineBarrier = reinterpret_cast<PFN_vkCmdPipelineBarrier>(m_vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier"));
+        if (synchronization2) {
+            m_vkCmdPipelineBarrier2 = reinterpret_cast<PFN_vkCmdPipelineBarrier2>(m_vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier2"));
+            if (m_vkCmdPipelineBarrier2 == VK_NULL_HANDLE) m_vkCmdPipelineBarrier2 = reinterpret_cast<PFN_vkCmdPipelineBarrier2>(m_vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier2KHR"));
+        }
+    }
+    if (m_vkCmdPipelineBarrier2 != VK_NULL_HANDLE) {
+        const VkDependencyInfo dependencyInfo {
+            .sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .pNext                    = nullptr,
+            .dependencyFlags          = 0x0U,
+            .memoryBarrierCount       = 1U,
+            .pMemoryBarriers          = &memoryBarrier,
+            .bufferMemoryBarrierCount = 0U,
+            .pBufferMemoryBarriers    = nullptr,
+            .imageMemoryBarrierCount  = static_cast<uint32_t>(imageBarriers.size()),
+            .pImageMemoryBarriers     = imageBarriers.data()
+        };
+        return m_vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+    }
+
+    // Every stage and access bit that the plugin uses has the same value in both versions of the flags, so the same
+    // dependency still goes out as a single call without synchronization2.
+    const VkMemoryBarrier legacyMemoryBarrier {
+        .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .pNext         = nullptr,
+        .srcAccessMask = static_cast<VkAccessFlags>(memoryBarrier.srcAccessMask),
+        .dstAccessMask = static_cast<VkAccessFlags>(memoryBarrier.dstAccessMask)
+    };
+    std::array<VkImageMemoryBarrier, MaxBarrierImages> legacyImageBarriers{};
+    const size_t count = std::min(imageBarriers.size(), legacyImageBarriers.size());
+    for (size_t i{}; i < count; ++i) {
+        const VkImageMemoryBarrier2& barrier = imageBarriers[i];
+        legacyImageBarriers.at(i) = {
+            .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext               = nullptr,
+            .srcAccessMask       = static_cast<VkAccessFlags>(barrier.srcAccessMask),
+            .dstAccessMask       = static_cast<VkAccessFlags>(barrier.dstAccessMask),
+            .oldLayout           = barrier.oldLayout,
+            .newLayout           = barrier.newLayout,
+            .srcQueueFamilyIndex = barrier.srcQueueFamilyIndex,
+            .dstQueueFamilyIndex = barrier.dstQueueFamilyIndex,
+            .image               = barrier.image,
+            .subresourceRange    = barrier.subresourceRange
+        };
+    }
+    m_vkCmdPipelineBarrier(commandBuffer, static_cast<VkPipelineStageFlags>(memoryBarrier.srcStageMask), static_cast<VkPipelineStageFlags>(memoryBarrier.dstStageMask), 0x0U, 1U, &legacyMemoryBarrier, 0U, nullptr, static_cast<uint32_t>(count), legacyImageBarriers.data());
+}
+
+bool Vulkan::BarrierBatch::add(void* texture, const VkImageLayout layout, const VkAccessFlags2 flags, UnityVulkanImage& image) {
+    if (!graphicsInterface->AccessTexture(texture, UnityVulkanWholeImage, layout, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, static_cast<VkAccessFlags>(flags), kUnityVulkanResourceAccess_ObserveOnly, &image)) return false;
+    if (image.image == VK_NULL_HANDLE) return false;
+    access |= flags;
+    // Views of a batch may share an image; Unity still reports the layout from before the first view's transition.
+    if (image.layout == layout || std::ranges::any_of(transitions.begin(), transitions.begin() + count, [&image](const Transition& transition) { return transition.image == image.image; })) return true;
+    // An image without contents has no layout to be handed back in, and a full batch has no room; Unity has to transition
+    // and track those images itself.
+    if (image.layout == VK_IMAGE_LAYOUT_UNDEFINED || image.layout == VK_IMAGE_LAYOUT_PREINITIALIZED || count == MaxBarrierImages)
+        return graphicsInterface->AccessTexture(texture, UnityVulkanWholeImage, layout, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, static_cast<VkAccessFlags>(flags), kUnityVulkanResourceAccess_PipelineBarrier, &image);
+    transitions.at(count++) = {image.image, image.aspect, image.layout, layout};
+    return true;
+}
+
+void Vulkan::BarrierBatch::record(VkCommandBuffer commandBuffer) const {
+    constexpr VkPipelineStageFlags2 srcStage{VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT};
+    constexpr VkAccessFlags2        srcAccess{VK_ACCESS_2_MEMORY_WRITE_BIT};
+    std::array<VkImageMemoryBarrier2, MaxBarrierImages> imageBarriers{};
+    for (uint32_t i{}; i < count; ++i) {
+        const Transition& transition = transitions.at(i);
+        imageBarriers.at(i) = {
+            .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+            .pNext               = nullptr,
+            .srcStageMask        = srcStage,
+            .srcAccessMask       = srcAccess,
+            .dstStageMask        = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            .dstAccessMask       = access,
+            .oldLayout           = transition.from,
+            .newLayout           = transition.to,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image               = transition.image,
+            .subresourceRange    = {transition.aspect, 0U, VK_REMAINING_MIP_LEVELS, 0U, VK_REMAINING_ARRAY_LAYERS}
+        };
+    }
+    const VkMemoryBarrier2 memoryBarrier {
+        .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+        .pNext         = nullptr,
+        .srcStageMask  = srcStage,
+        .srcAccessMask = srcAccess,
+        .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        .dstAccessMask = access
+    };
+    recordBarrier(commandBuffer, memoryBarrier, std::span(imageBarriers.data(), count));
+}
+
+void Vulkan::BarrierBatch::restore(VkCommandBuffer commandBuffer) {
+    // Unity only observed these images, so it does not know about the dispatch's writes; make them visible to whatever
+    // Unity records next, whether or not any image changed layout.
+    constexpr VkAccessFlags2 dstAccess{VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT};
+    std::array<VkImageMemoryBarrier2, MaxBarrierImages> imageBarriers{};
+    for (uint32_t i{}; i < count; ++i) {
+        const Transition& transition = transitions.at(i);
+        imageBarriers.at(i) = {
+            .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+            .pNext               = nullptr,
+            .srcStageMask        = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            .srcAccessMask       = VK_ACCESS_2_SHADER_WRITE_BIT,
+            .dstStageMask        = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+            .dstAccessMask       = dstAccess,
+            .oldLayout           = transition.to,
+            .newLayout           = transition.from,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image               = transition.image,
+            .subresourceRange    = {transition.aspect, 0U, VK_REMAINING_MIP_LEVELS, 0U, VK_REMAINING_ARRAY_LAYERS}
+        };
+    }
+    const VkMemoryBarrier2 memoryBarrier {
+        .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+        .pNext         = nullptr,
+        .srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+        .dstStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+        .dstAccessMask = dstAccess
+    };
+    recordBarrier(commandBuffer, memoryBarrier, std::span(imageBarriers.data(), count));
+    clear();
+}
+
+void Vulkan::BarrierBatch::clear() {
+    count  = 0U;
+    access = 0U;
+}
+
+bool Vulkan::createTimestampPool() {
+    if (timestampsAttempted) return timestampPool != VK_NULL_HANDLE;
+    timestampsAttempted = true;
+    const UnityVulkanInstance unityInstance = graphicsInterface->Instance();
+    const auto vkGetPhysicalDeviceProperties            = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties>(m_vkGetInstanceProcAddr(unityInstance.instance, "vkGetPhysicalDeviceProperties"));
+    const auto vkGetPhysicalDeviceQueueFamilyProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceQueueFamilyProperties>(m_vkGetInstanceProcAddr(unityInstance.instance, "vkGetPhysicalDeviceQueueFamilyProperties"));
+    const auto vkCreateQueryPool                        = reinterpret_cast<PFN_vkCreateQueryPool>(m_vkGetDeviceProcAddr(unityInstance.device, "vkCreateQueryPool"));
+    m_vkDestroyQueryPool    = reinterpret_cast<PFN_vkDestroyQueryPool>(m_vkGetDeviceProcAddr(unityInstance.device, "vkDestroyQueryPool"));
+    m_vkGetQueryPoolResults = reinterpret_cast<PFN_vkGetQueryPoolResults>(m_vkGetDeviceProcAddr(unityInstance.device, "vkGetQueryPoolResults"));
+    m_vkCmdResetQueryPool   = reinterpret_cast<PFN_vkCmdResetQueryPool>(m_vkGetDeviceProcAddr(unityInstance.device, "vkCmdResetQueryPool"));
+    m_vkCmdWriteTimestamp   = reinterpret_cast<PFN_vkCmdWriteTimestamp>(m_vkGetDeviceProcAddr(unityInstance.device, "vkCmdWriteTimestamp"));
+    if (synchronization2) {
+        m_vkCmdWriteTimestamp2 = reinterpret_cast<PFN_vkCmdWriteTimestamp2>(m_vkGetDeviceProcAddr(unityInstance.device, "vkCmdWriteTimestamp2"));
+        if (m_vkCmdWriteTimestamp2 == VK_NULL_HANDLE) m_vkCmdWriteTimestamp2 = reinterpret_cast<PFN_vkCmdWriteTimestamp2>(m_vkGetDeviceProcAddr(unityInstance.device, "vkCmdWriteTimestamp2KHR"));
+    }
+    if (vkGetPhysicalDeviceProperties == VK_NULL_HANDLE || vkGetPhysicalDeviceQueueFamilyProperties == VK_NULL_HANDLE || vkCreateQueryPool == VK_NULL_HANDLE || m_vkDestroyQueryPool == VK_NULL_HANDLE || m_vkGetQueryPoolResults == VK_NULL_HANDLE || m_vkCmdResetQueryPool == VK_NULL_HANDLE || m_vkCmdWriteTimestamp == VK_NULL_HANDLE) return false;
+
+    // Timestamps are only meaningful if the queue that Unity records on writes them at all.
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(unityInstance.physicalDevice, &properties);
+    uint32_t familyCount{};
+    vkGetPhysicalDeviceQueueFamilyProperties(unityInstance.physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(unityInstance.physicalDevice, &familyCount, families.data());
+    if (unityInstance.queueFamilyIndex >= familyCount) return false;
+    const uint32_t validBits = families[unityInstance.queueFamilyIndex].timestampValidBits;
+    if (validBits == 0U || properties.limits.timestampPeriod == 0.0F) return false;
+    timestampMask   = validBits >= 64U ? ~0ULL : (1ULL << validBits) - 1ULL;
+    timestampPeriod = properties.limits.timestampPeriod;
+
+    const VkQueryPoolCreateInfo createInfo {
+        .sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        .pNext              = nullptr,
+        .flags              = 0x0U,
+        .queryType          = VK_QUERY_TYPE_TIMESTAMP,
+        .queryCount         = MaxTimestampRings * TimestampLatency * 2U,
+        .pipelineStatistics = 0x0U
+    };
+    if (vkCreateQueryPool(unityInstance.device, &createInfo, nullptr, &timestampPool) != VK_SUCCESS) return false;
+    freeTimestampRings.resize(MaxTimestampRings);
+    for (uint32_t i{}; i < MaxTimestampRings; ++i) freeTimestampRings[i] = MaxTimestampRings - 1U - i;
+    return true;
+}
+
+bool Vulkan::acquireTimestampRing(uint32_t& ring) {
+    const std::lock_guard lock(timestampMutex);
+    if (!createTimestampPool() || freeTimestampRings.empty()) return false;
+    ring = freeTimestampRings.back();
+    freeTimestampRings.pop_back();
+    return true;
+}
+
+void Vulkan::writeTimestamp(VkCommandBuffer commandBuffer, const uint32_t query) {
+    // Both timestamps of a pair wait for every earlier command, so the pair brackets exactly the work recorded between them.
+    if (m_vkCmdWriteTimestamp2 != VK_NULL_HANDLE) return m_vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, timestampPool, query);
+    m_vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, timestampPool, query);
+}
+
+void Vulkan::destroyTimestampPool() {
+    const std::lock_guard lock(timestampMutex);
+    if (timestampPool != VK_NULL_HANDLE) m_vkDestroyQueryPool(graphicsInterface->Instance().device, timestampPool, nullptr);
+    timestampPool       = VK_NULL_HANDLE;
+    timestampsAttempted = false;
+    freeTimestampRings.clear();
+}
+
+void Vulkan::TimestampRing::begin(VkCommandBuffer commandBuffer, Timings& timings) {
+    if (ring == Unassigned && !acquireTimestampRing(ring)) return;
+    const uint32_t slot  = frame % TimestampLatency;
+    const uint32_t query = (ring * TimestampLatency + slot) * 2U;
+    if (written.at(slot)) {
+        // Without VK_QUERY_RESULT_WAIT_BIT this never blocks; a pair that has somehow not resolved yet is dropped.
+        std::array<uint64_t, 2> results{};
+        if (m_vkGetQueryPoolResults(graphicsInterface->Instance().device, timestampPool, query, 2U, sizeof(results), results.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS)
+            timings.add(static_cast<float>(static_cast<double>((results[1] - results[0]) & timestampMask) * timestampPeriod / 1000000.0));
+        written.at(slot) = false;
+    }
+    m_vkCmdResetQueryPool(commandBuffer, timestampPool, query, 2U);
+    writeTimestamp(commandBuffer, query);
+}
+
+void Vulkan::TimestampRing::end(VkCommandBuffer commandBuffer) {
+    if (ring == Unassigned) return;
+    const uint32_t slot = frame++ % TimestampLatency;
+    writeTimestamp(commandBuffer, (ring * TimestampLatency + slot) * 2U + 1U);
+    written.at(slot) = true;
+}
+
+void Vulkan::TimestampRing::release() {
+    if (ring == Unassigned) return;
+    {
+        const std::lock_guard lock(timestampMutex);
+        // A pool that was destroyed in the meantime took every ring with it.
+        if (timestampPool != VK_NULL_HANDLE) freeTimestampRings.push_back(ring);
+    }
+    ring    = Unassigned;
+    frame   = 0U;
+    written = {};
 }
 
 PFN_vkGetDeviceProcAddr Vulkan::getDeviceProcAddr() {
     return m_vkGetDeviceProcAddr;
 }
 
+VkPipelineCache Vulkan::getPipelineCache() {
+    const std::lock_guard lock{pipelineCacheMutex};
+    if (pipelineCache != VK_NULL_HANDLE) return pipelineCache;
+    const UnityVulkanInstance unityInstance = graphicsInterface->Instance();
+    const auto vkGetPhysicalDeviceProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties>(m_vkGetInstanceProcAddr(unityInstance.instance, "vkGetPhysicalDeviceProperties"));
+    const auto vkCreatePipelineCache         = reinterpret_cast<PFN_vkCreatePipelineCache>(m_vkGetDeviceProcAddr(unityInstance.device, "vkCreatePipelineCache"));
+    m_vkGetPipelineCacheData = reinterpret_cast<PFN_vkGetPipelineCacheData>(m_vkGetDeviceProcAddr(unityInstance.device, "vkGetPipelineCacheData"));
+    m_vkDestroyPipelineCache = reinterpret_cast<PFN_vkDestroyPipelineCache>(m_vkGetDeviceProcAddr(unityInstance.device, "vkDestroyPipelineCache"));
+    if (vkGetPhysicalDeviceProperties == VK_NULL_HANDLE || vkCreatePipelineCache == VK_NULL_HANDLE || m_vkGetPipelineCacheData == VK_NULL_HANDLE || m_vkDestroyPipelineCache == VK_NULL_HANDLE) return VK_NULL_HANDLE;
+
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(unityInstance.physicalDevice, &properties);
+    pipelineCacheKey = PipelineCache::key(properties.pipelineCacheUUID, properties.vendorID, properties.deviceID, properties.driverVersion);
+    const std::vector<char> data = PipelineCache::read(pipelineCacheKey);
+    VkPipelineCacheCreateInfo createInfo {
+        .sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .pNext           = nullptr,
+        .flags           = 0x0U,
+        .initialDataSize = data.size(),
+        .pInitialData    = data.data()
+    };
+    // Drivers are allowed to reject a blob they do not like; start from an empty cache in that case.
+    if (vkCreatePipelineCache(unityInstance.device, &createInfo, nullptr, &pipelineCache) != VK_SUCCESS && !data.empty()) {
+        createInfo.initialDataSize = 0U;
+        createInfo.pInitialData    = nullptr;
+        vkCreatePipelineCache(unityInstance.device, &createInfo, nullptr, &pipelineCache);
+    }
+    return pipelineCache;
+}
+
+void Vulkan::savePipelineCache() {
+    const std::lock_guard lock{pipelineCacheMutex};
+    if (pipelineCache == VK_NULL_HANDLE) return;
+    const VkDevice    device = graphicsInterface->Instance().device;
+    size_t            size{};
+    std::vector<char> data;
+    if (m_vkGetPipelineCacheData(device, pipelineCache, &size, nullptr) == VK_SUCCESS) {
+        data.resize(size);
+        if (m_vkGetPipelineCacheData(device, pipelineCache, &size, data.data()) == VK_SUCCESS) data.resize(size);
+        else data.clear();
+    }
+    m_vkDestroyPipelineCache(device, pipelineCache, nullptr);
+    pipelineCache = VK_NULL_HANDLE;
+    PipelineCache::write(pipelineCacheKey, std::move(data));
+}
+
 #ifdef ENABLE_FRAME_GENERATION
 #pragma region Format Conversions
 UnityRenderingExtTextureFormat Vulkan::toUnityFormat(const VkFormat format) {
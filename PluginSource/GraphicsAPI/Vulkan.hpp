@@ -2,19 +2,164 @@
 #ifdef ENABLE_VULKAN
 #    include "GraphicsAPI.hpp"
 
-#    ifdef ENABLE_FSR
-#        include <vk/ffx_api_vk.h>
-#    endif
-
 #    ifdef ENABLE_FRAME_GENERATION
 #        include <IUnityRenderingExtensions.h>
 #    endif
 
 #    include <vulkan/vulkan.h>
 
+#    include <array>
+#    include <mutex>
+#    include <span>
+#    include <string>
+#    include <unordered_map>
+#    include <vector>
+
+class Timings;
 struct IUnityGraphicsVulkanV2;
+struct UnityVulkanImage;
 
 class Vulkan final : public GraphicsAPI {
+public:
+    static constexpr uint32_t MaxBarrierImages{32U};
+    /// How many evaluations a timestamp pair is left alone for before it is read back.
+    static constexpr uint32_t TimestampLatency{4U};
+    static constexpr uint32_t MaxTimestampRings{64U};
+
+    struct ImageViewCacheStats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t invalidations;
+        uint64_t views;
+    };
+
+    /// Collects the layout transitions and memory dependencies of every image that one dispatch touches and records them
+    /// as a single barrier, rather than letting Unity emit one barrier per `AccessTexture` call. Images are looked up
+    /// without touching Unity's state tracking, so `restore` must be recorded after the dispatch to hand every image back
+    /// in the layout that Unity believes it is in.
+    class BarrierBatch {
+        struct Transition {
+            VkImage            image;
+            VkImageAspectFlags aspect;
+            VkImageLayout      from;
+            VkImageLayout      to;
+        };
+
+        std::array<Transition, MaxBarrierImages> transitions{};
+        uint32_t                         count{};
+        VkAccessFlags2                   access{};
+
+    public:
+        /// Queues `texture` to be in `layout` for `flags` access by a compute dispatch. Images that are already in
+        /// `layout` only take part in the memory dependency.
+        bool add(void* texture, VkImageLayout layout, VkAccessFlags2 flags, UnityVulkanImage& image);
+        /// Records the queued transitions.
+        void record(VkCommandBuffer commandBuffer) const;
+        /// Records the transitions back to Unity's layouts and empties the batch.
+        void restore(VkCommandBuffer commandBuffer);
+        void clear();
+    };
+
+    /// Measures the GPU time of one dispatch per evaluation with a pair of timestamps. Each evaluation writes into the
+    /// next pair of a small ring, and a pair is only read back when the ring comes around to it again, by which point
+    /// the GPU has long finished with it, so reading results never stalls. Every ring lives in one query pool that is
+    /// shared by the whole plugin.
+    class TimestampRing {
+        static constexpr uint32_t Unassigned{~0U};
+
+        uint32_t                           ring{Unassigned};
+        uint32_t                           frame{};
+        std::array<bool, TimestampLatency> written{};
+
+    public:
+        /// Resolves the pair that this evaluation is about to reuse into `timings`, then writes the first timestamp.
+        void begin(VkCommandBuffer commandBuffer, Timings& timings);
+        /// Writes the second timestamp.
+        void end(VkCommandBuffer commandBuffer);
+        /// Hands this ring's queries back to the shared pool.
+        void release();
+    };
+
+#    ifdef ENABLE_PREPROCESSING
+    /// Copies the camera's depth, motion vectors, and opaque-only color into the images that an effect reads with a
+    /// single compute dispatch, in place of the blit or copy per image that Unity would otherwise record. Every image
+    /// that takes part must be in `VK_IMAGE_LAYOUT_GENERAL`, which `add` arranges through the caller's barrier batch.
+    /// Destinations must be storage images in `R32_SFLOAT`, `R16G16_SFLOAT`, and `R16G16B16A16_SFLOAT` respectively.
+    class Preprocess {
+    public:
+        enum Image : uint8_t {
+            Depth,
+            Motion,
+            Opaque,
+            ImageCount
+        };
+
+        struct Copy {
+            /// The texture to read, or `nullptr` to leave `destination` alone.
+            void* source;
+            void* destination;
+            /// Stretches the source over the whole destination, rather than copying texel for texel from the origin.
+            bool stretch;
+            /// Mirrors the source vertically.
+            bool flip;
+        };
+        using Copies = std::array<Copy, ImageCount>;
+
+    private:
+        /// One shader variant per combination of copies, so that a variant never reads an unused binding.
+        static constexpr uint32_t VariantCount{1U << ImageCount};
+        static constexpr uint32_t SetsPerPool{16U};
+
+        struct DescriptorSet {
+            VkDescriptorSet set;
+            /// The frame that last recorded this set, which must be safe before it is written again.
+            uint64_t frame;
+        };
+
+        static PFN_vkDestroySampler             m_vkDestroySampler;
+        static PFN_vkDestroyDescriptorSetLayout m_vkDestroyDescriptorSetLayout;
+        static PFN_vkDestroyPipelineLayout      m_vkDestroyPipelineLayout;
+        static PFN_vkDestroyPipeline            m_vkDestroyPipeline;
+        static PFN_vkCreateDescriptorPool       m_vkCreateDescriptorPool;
+        static PFN_vkDestroyDescriptorPool      m_vkDestroyDescriptorPool;
+        static PFN_vkAllocateDescriptorSets     m_vkAllocateDescriptorSets;
+        static PFN_vkUpdateDescriptorSets       m_vkUpdateDescriptorSets;
+        static PFN_vkCmdBindPipeline            m_vkCmdBindPipeline;
+        static PFN_vkCmdBindDescriptorSets      m_vkCmdBindDescriptorSets;
+        static PFN_vkCmdPushConstants           m_vkCmdPushConstants;
+        static PFN_vkCmdDispatch                m_vkCmdDispatch;
+
+        static VkSampler                            sampler;
+        static VkDescriptorSetLayout                setLayout;
+        static VkPipelineLayout                     pipelineLayout;
+        static std::array<VkPipeline, VariantCount> pipelines;
+        static std::vector<VkDescriptorPool>        pools;
+        static std::vector<DescriptorSet>           sets;
+        static bool                                 attempted;
+        static std::mutex                           mutex;
+
+        static bool create();
+        static bool acquireSet(VkDescriptorSet& set, uint64_t frame, uint64_t safeFrame);
+
+    public:
+        /// Builds the pipelines on first use. Returns whether the pass can be recorded on this device.
+        static bool supported();
+        /// Queues every image of `copies` into `batch` in `VK_IMAGE_LAYOUT_GENERAL`.
+        static bool add(BarrierBatch& batch, const Copies& copies);
+        /// Records the copies, followed by a barrier that makes them visible to the compute dispatches that come next.
+        /// The batch that `add` queued into must already have been recorded.
+        static bool record(VkCommandBuffer commandBuffer, const Copies& copies);
+        static void destroy();
+    };
+#    endif
+
+private:
+    struct CachedImageView {
+        VkFormat                format;
+        VkImageSubresourceRange range;
+        VkImageView             view;
+    };
+
     static PFN_vkGetInstanceProcAddr    m_vkGetInstanceProcAddr;
     static PFN_vkCreateInstance         m_vkCreateInstance;
     static PFN_vkCreateDevice           m_vkCreateDevice;
@@ -25,16 +170,10 @@ class Vulkan final : public GraphicsAPI {
     static PFN_vkAcquireNextImageKHR    m_vkAcquireNextImageKHR;
     static PFN_vkQueuePresentKHR        m_vkQueuePresentKHR;
     static PFN_vkSetHdrMetadataEXT      m_vkSetHdrMetadataEXT;
+#    ifdef ENABLE_FRAME_GENERATION
     static PFN_vkCreateWin32SurfaceKHR  m_vkCreateWin32SurfaceKHR;
-    static PFN_vkDestroySurfaceKHR      m_vkDestroySurfaceKHR;
-#    ifdef ENABLE_FSR
-    static PFN_vkCreateSwapchainFFXAPI  m_fxCreateSwapchainKHR;
-    static PFN_vkDestroySwapchainFFXAPI m_fxDestroySwapchainKHR;
-    static PFN_vkGetSwapchainImagesKHR  m_fxGetSwapchainImagesKHR;
-    static PFN_vkAcquireNextImageKHR    m_fxAcquireNextImageKHR;
-    static PFN_vkQueuePresentKHR        m_fxQueuePresentKHR;
-    static PFN_vkSetHdrMetadataEXT      m_fxSetHdrMetadataEXT;
 #    endif
+    static PFN_vkDestroySurfaceKHR      m_vkDestroySurfaceKHR;
 #    ifdef ENABLE_DLSS
     static PFN_vkGetInstanceProcAddr   m_slGetInstanceProcAddr;
     static PFN_vkCreateInstance        m_slCreateInstance;
@@ -52,28 +191,59 @@ class Vulkan final : public GraphicsAPI {
     static PFN_vkGetDeviceQueue                         m_vkGetDeviceQueue;
     static PFN_vkCreateImageView                        m_vkCreateImageView;
     static PFN_vkDestroyImageView                       m_vkDestroyImageView;
+    static PFN_vkGetPipelineCacheData                   m_vkGetPipelineCacheData;
+    static PFN_vkDestroyPipelineCache                   m_vkDestroyPipelineCache;
+    static PFN_vkCmdPipelineBarrier                     m_vkCmdPipelineBarrier;
+    static PFN_vkCmdPipelineBarrier2                    m_vkCmdPipelineBarrier2;
+    static PFN_vkDestroyQueryPool                       m_vkDestroyQueryPool;
+    static PFN_vkGetQueryPoolResults                    m_vkGetQueryPoolResults;
+    static PFN_vkCmdResetQueryPool                      m_vkCmdResetQueryPool;
+    static PFN_vkCmdWriteTimestamp                      m_vkCmdWriteTimestamp;
+    static PFN_vkCmdWriteTimestamp2                     m_vkCmdWriteTimestamp2;
 
     static VkInstance instance;
+    static bool       synchronization2;
+    static VkPipelineCache pipelineCache;
+    static std::string     pipelineCacheKey;
+    /// Contexts are created on the workers of asynchronous context updates as well as on the game thread.
+    static std::mutex      pipelineCacheMutex;
+    static std::unordered_multimap<VkImage, CachedImageView> imageViews;
+    static std::mutex                                        imageViewMutex;
+    static ImageViewCacheStats                               imageViewStats;
+    static VkQueryPool           timestampPool;
+    static bool                  timestampsAttempted;
+    static float                 timestampPeriod;
+    static uint64_t              timestampMask;
+    static std::vector<uint32_t> freeTimestampRings;
+    static std::mutex            timestampMutex;
     static IUnityGraphicsVulkanV2* graphicsInterface;
-    static HWND                    HWNDToIntercept;
-    static VkSurfaceKHR            surfaceToIntercept;
-    static VkSwapchainKHR          swapchainToIntercept;
 
+#    ifdef ENABLE_FRAME_GENERATION
     static VkSurfaceKHR createDummySurface(void*& hWnd);
     static void         destroyDummySurface(void* hWnd, VkSurfaceKHR dummySurface);
+#    endif
 
     static VkResult           hook_vkCreateInstance(const VkInstanceCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkInstance* pInstance);
     static PFN_vkVoidFunction hook_vkGetInstanceProcAddr(VkInstance instance, const char* name);
     static VkResult           hook_vkCreateDevice(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkDevice* pDevice);
     static PFN_vkVoidFunction hook_vkGetDeviceProcAddr(VkDevice device, const char* name);
+#    ifdef ENABLE_FRAME_GENERATION
     static VkResult           hook_vkCreateWin32SurfaceKHR(VkInstance instance, const VkWin32SurfaceCreateInfoKHR* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkSurfaceKHR* pSurface);
     static void               hook_vkDestroySurfaceKHR(VkInstance instance, VkSurfaceKHR surface, const VkAllocationCallbacks* pAllocator);
+#    endif
     static VkResult           hook_vkCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInfoKHR* pCreateInfo, VkAllocationCallbacks* pAllocator, VkSwapchainKHR* pSwapchain);
     static void               hook_vkDestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks* pAllocator);
     static VkResult           hook_vkGetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t* pSwapchainImageCount, VkImage* pSwapchainImages);
     static VkResult           hook_vkAcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout, VkSemaphore semaphore, VkFence fence, uint32_t* pImageIndex);
     static VkResult           hook_vkQueuePresentKHR(VkQueue queue, const VkPresentInfoKHR* pPresentInfo);
     static void               hook_vkSetHdrMetadataEXT(VkDevice device, uint32_t swapchainCount, const VkSwapchainKHR* pSwapchains, const VkHdrMetadataEXT* pMetadata);
+    static void               hook_vkDestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks* pAllocator);
+
+    static void recordBarrier(VkCommandBuffer commandBuffer, const VkMemoryBarrier2& memoryBarrier, std::span<const VkImageMemoryBarrier2> imageBarriers);
+
+    static bool createTimestampPool();
+    static bool acquireTimestampRing(uint32_t& ring);
+    static void writeTimestamp(VkCommandBuffer commandBuffer, uint32_t query);
 
     static PFN_vkGetInstanceProcAddr interceptInitialization(PFN_vkGetInstanceProcAddr t_getInstanceProcAddr, void* /*unused*/);
 
@@ -89,13 +259,22 @@ public:
     static IUnityGraphicsVulkanV2* getGraphicsInterface();
     static bool                    unregisterUnityInterfaces();
 
-    static void        setFrameGenerationHWND(HWND hWnd);
+#    ifdef ENABLE_FRAME_GENERATION
     static VkQueue     getQueue(uint32_t family, uint32_t index);
-    static VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags flags);
-    static void        destroyImageView(VkImageView viewToDestroy);
+#    endif
+    /// Returns a view of the first mip and layer of `image`. Views are shared between every user of the same image and
+    /// are owned by the plugin, which destroys them when Unity destroys the image.
+    static VkImageView         getImageView(VkImage image, VkFormat format, VkImageAspectFlags flags);
+    static void                destroyImageViews();
+    static ImageViewCacheStats getImageViewCacheStats();
+
+    static void destroyTimestampPool();
 
     static PFN_vkGetDeviceProcAddr getDeviceProcAddr();
 
+    static VkPipelineCache getPipelineCache();
+    static void            savePipelineCache();
+
 #    ifdef ENABLE_FRAME_GENERATION
 #    pragma region Format Conversions
     static UnityRenderingExtTextureFormat toUnityFormat(VkFormat format);
@@ -0,0 +1,351 @@
+#ifdef ENABLE_PREPROCESSING
+#    include "Vulkan.hpp"
+
+#    include "Utilities/Stats.hpp"
+
+#    include <IUnityGraphicsVulkan.h>
+
+#    include <algorithm>
+#    include <array>
+#    include <span>
+#    include <utility>
+
+namespace {
+// Compiled from `Shaders/Preprocess.comp` at build time, one variant per value of `OUTPUTS`.
+constexpr uint32_t Preprocess1[]{
+#    include <Shaders/Preprocess1.spv.inc>
+};
+constexpr uint32_t Preprocess2[]{
+#    include <Shaders/Preprocess2.spv.inc>
+};
+constexpr uint32_t Preprocess3[]{
+#    include <Shaders/Preprocess3.spv.inc>
+};
+constexpr uint32_t Preprocess4[]{
+#    include <Shaders/Preprocess4.spv.inc>
+};
+constexpr uint32_t Preprocess5[]{
+#    include <Shaders/Preprocess5.spv.inc>
+};
+constexpr uint32_t Preprocess6[]{
+#    include <Shaders/Preprocess6.spv.inc>
+};
+constexpr uint32_t Preprocess7[]{
+#    include <Shaders/Preprocess7.spv.inc>
+};
+constexpr std::array<std::span<const uint32_t>, 8> Variants{{{}, Preprocess1, Preprocess2, Preprocess3, Preprocess4, Preprocess5, Preprocess6, Preprocess7}};
+
+/// The format that each destination is declared with in the shader.
+constexpr std::array<VkFormat, Vulkan::Preprocess::ImageCount> Formats{VK_FORMAT_R32_SFLOAT, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT};
+
+constexpr uint32_t WorkgroupSize{8U};
+/// Marks a descriptor set that has never been recorded.
+constexpr uint64_t Unused{~0ULL};
+
+/// Matches the push constant block of `Shaders/Preprocess.comp`.
+struct Constants {
+    std::array<std::array<float, 4>, Vulkan::Preprocess::ImageCount>    transforms;
+    std::array<std::array<uint32_t, 2>, Vulkan::Preprocess::ImageCount> extents;
+};
+}  // namespace
+
+PFN_vkDestroySampler             Vulkan::Preprocess::m_vkDestroySampler{VK_NULL_HANDLE};
+PFN_vkDestroyDescriptorSetLayout Vulkan::Preprocess::m_vkDestroyDescriptorSetLayout{VK_NULL_HANDLE};
+PFN_vkDestroyPipelineLayout      Vulkan::Preprocess::m_vkDestroyPipelineLayout{VK_NULL_HANDLE};
+PFN_vkDestroyPipeline            Vulkan::Preprocess::m_vkDestroyPipeline{VK_NULL_HANDLE};
+PFN_vkCreateDescriptorPool       Vulkan::Preprocess::m_vkCreateDescriptorPool{VK_NULL_HANDLE};
+PFN_vkDestroyDescriptorPool      Vulkan::Preprocess::m_vkDestroyDescriptorPool{VK_NULL_HANDLE};
+PFN_vkAllocateDescriptorSets     Vulkan::Preprocess::m_vkAllocateDescriptorSets{VK_NULL_HANDLE};
+PFN_vkUpdateDescriptorSets       Vulkan::Preprocess::m_vkUpdateDescriptorSets{VK_NULL_HANDLE};
+PFN_vkCmdBindPipeline            Vulkan::Preprocess::m_vkCmdBindPipeline{VK_NULL_HANDLE};
+PFN_vkCmdBindDescriptorSets      Vulkan::Preprocess::m_vkCmdBindDescriptorSets{VK_NULL_HANDLE};
+PFN_vkCmdPushConstants           Vulkan::Preprocess::m_vkCmdPushConstants{VK_NULL_HANDLE};
+PFN_vkCmdDispatch                Vulkan::Preprocess::m_vkCmdDispatch{VK_NULL_HANDLE};
+
+VkSampler                                                Vulkan::Preprocess::sampler{VK_NULL_HANDLE};
+VkDescriptorSetLayout                                    Vulkan::Preprocess::setLayout{VK_NULL_HANDLE};
+VkPipelineLayout                                         Vulkan::Preprocess::pipelineLayout{VK_NULL_HANDLE};
+std::array<VkPipeline, Vulkan::Preprocess::VariantCount> Vulkan::Preprocess::pipelines{};
+std::vector<VkDescriptorPool>                            Vulkan::Preprocess::pools{};
+std::vector<Vulkan::Preprocess::DescriptorSet>           Vulkan::Preprocess::sets{};
+bool                                                     Vulkan::Preprocess::attempted{false};
+std::mutex                                               Vulkan::Preprocess::mutex{};
+
+bool Vulkan::Preprocess::create() {
+    // Pipelines are created in order, so the last one only exists if every other part does.
+    if (attempted) return pipelines.back() != VK_NULL_HANDLE;
+    attempted             = true;
+    const VkDevice device = graphicsInterface->Instance().device;
+    const auto vkCreateSampler             = reinterpret_cast<PFN_vkCreateSampler>(m_vkGetDeviceProcAddr(device, "vkCreateSampler"));
+    const auto vkCreateDescriptorSetLayout = reinterpret_cast<PFN_vkCreateDescriptorSetLayout>(m_vkGetDeviceProcAddr(device, "vkCreateDescriptorSetLayout"));
+    const auto vkCreatePipelineLayout      = reinterpret_cast<PFN_vkCreatePipelineLayout>(m_vkGetDeviceProcAddr(device, "vkCreatePipelineLayout"));
+    const auto vkCreateShaderModule        = reinterpret_cast<PFN_vkCreateShaderModule>(m_vkGetDeviceProcAddr(device, "vkCreateShaderModule"));
+    const auto vkDestroyShaderModule       = reinterpret_cast<PFN_vkDestroyShaderModule>(m_vkGetDeviceProcAddr(device, "vkDestroyShaderModule"));
+    const auto vkCreateComputePipelines    = reinterpret_cast<PFN_vkCreateComputePipelines>(m_vkGetDeviceProcAddr(device, "vkCreateComputePipelines"));
+    m_vkDestroySampler             = reinterpret_cast<PFN_vkDestroySampler>(m_vkGetDeviceProcAddr(device, "vkDestroySampler"));
+    m_vkDestroyDescriptorSetLayout = reinterpret_cast<PFN_vkDestroyDescriptorSetLayout>(m_vkGetDeviceProcAddr(device, "vkDestroyDescriptorSetLayout"));
+    m_vkDestroyPipelineLayout      = reinterpret_cast<PFN_vkDestroyPipelineLayout>(m_vkGetDeviceProcAddr(device, "vkDestroyPipelineLayout"));
+    m_vkDestroyPipeline            = reinterpret_cast<PFN_vkDestroyPipeline>(m_vkGetDeviceProcAddr(device, "vkDestroyPipeline"));
+    m_vkCreateDescriptorPool       = reinterpret_cast<PFN_vkCreateDescriptorPool>(m_vkGetDeviceProcAddr(device, "vkCreateDescriptorPool"));
+    m_vkDestroyDescriptorPool      = reinterpret_cast<PFN_vkDestroyDescriptorPool>(m_vkGetDeviceProcAddr(device, "vkDestroyDescriptorPool"));
+    m_vkAllocateDescriptorSets     = reinterpret_cast<PFN_vkAllocateDescriptorSets>(m_vkGetDeviceProcAddr(device, "vkAllocateDescriptorSets"));
+    m_vkUpdateDescriptorSets       = reinterpret_cast<PFN_vkUpdateDescriptorSets>(m_vkGetDeviceProcAddr(device, "vkUpdateDescriptorSets"));
+    m_vkCmdBindPipeline            = reinterpret_cast<PFN_vkCmdBindPipeline>(m_vkGetDeviceProcAddr(device, "vkCmdBindPipeline"));
+    m_vkCmdBindDescriptorSets      = reinterpret_cast<PFN_vkCmdBindDescriptorSets>(m_vkGetDeviceProcAddr(device, "vkCmdBindDescriptorSets"));
+    m_vkCmdPushConstants           = reinterpret_cast<PFN_vkCmdPushConstants>(m_vkGetDeviceProcAddr(device, "vkCmdPushConstants"));
+    m_vkCmdDispatch                = reinterpret_cast<PFN_vkCmdDispatch>(m_vkGetDeviceProcAddr(device, "vkCmdDispatch"));
+    if (vkCreateSampler == VK_NULL_HANDLE || vkCreateDescriptorSetLayout == VK_NULL_HANDLE || vkCreatePipelineLayout == VK_NULL_HANDLE || vkCreateShaderModule == VK_NULL_HANDLE || vkDestroyShaderModule == VK_NULL_HANDLE || vkCreateComputePipelines == VK_NULL_HANDLE) return false;
+    if (m_vkDestroySampler == VK_NULL_HANDLE || m_vkDestroyDescriptorSetLayout == VK_NULL_HANDLE || m_vkDestroyPipelineLayout == VK_NULL_HANDLE || m_vkDestroyPipeline == VK_NULL_HANDLE || m_vkCreateDescriptorPool == VK_NULL_HANDLE || m_vkDestroyDescriptorPool == VK_NULL_HANDLE || m_vkAllocateDescriptorSets == VK_NULL_HANDLE || m_vkUpdateDescriptorSets == VK_NULL_HANDLE) return false;
+    if (m_vkCmdBindPipeline == VK_NULL_HANDLE || m_vkCmdBindDescriptorSets == VK_NULL_HANDLE || m_vkCmdPushConstants == VK_NULL_HANDLE || m_vkCmdDispatch == VK_NULL_HANDLE) return false;
+
+    // Every copy lands on texel centers of its source when the extents match, so point sampling keeps those copies exact.
+    const VkSamplerCreateInfo samplerCreateInfo {
+        .sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+        .pNext                   = nullptr,
+        .flags                   = 0x0U,
+        .magFilter               = VK_FILTER_NEAREST,
+        .minFilter               = VK_FILTER_NEAREST,
+        .mipmapMode              = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+        .addressModeU            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        .addressModeV            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        .addressModeW            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        .mipLodBias              = 0.0F,
+        .anisotropyEnable        = VK_FALSE,
+        .maxAnisotropy           = 1.0F,
+        .compareEnable           = VK_FALSE,
+        .compareOp               = VK_COMPARE_OP_ALWAYS,
+        .minLod                  = 0.0F,
+        .maxLod                  = 0.0F,
+        .borderColor             = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK,
+        .unnormalizedCoordinates = VK_FALSE
+    };
+    if (vkCreateSampler(device, &samplerCreateInfo, nullptr, &sampler) != VK_SUCCESS) return false;
+
+    const std::array samplers{sampler};
+    std::array<VkDescriptorSetLayoutBinding, ImageCount * 2U> bindings{};
+    for (uint32_t binding{}; binding < bindings.size(); ++binding) {
+        const bool source = binding < ImageCount;
+        bindings.at(binding) = {
+            .binding            = binding,
+            .descriptorType     = source ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            .descriptorCount    = 1U,
+            .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+            .pImmutableSamplers = source ? samplers.data() : nullptr
+        };
+    }
+    const VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo {
+        .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext        = nullptr,
+        .flags        = 0x0U,
+        .bindingCount = static_cast<uint32_t>(bindings.size()),
+        .pBindings    = bindings.data()
+    };
+    if (vkCreateDescriptorSetLayout(device, &setLayoutCreateInfo, nullptr, &setLayout) != VK_SUCCESS) return false;
+
+    const VkPushConstantRange pushConstantRange {
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .offset     = 0U,
+        .size       = sizeof(Constants)
+    };
+    const VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo {
+        .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .pNext                  = nullptr,
+        .flags                  = 0x0U,
+        .setLayoutCount         = 1U,
+        .pSetLayouts            = &setLayout,
+        .pushConstantRangeCount = 1U,
+        .pPushConstantRanges    = &pushConstantRange
+    };
+    if (vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout) != VK_SUCCESS) return false;
+
+    for (uint32_t variant{1U}; variant < VariantCount; ++variant) {
+        const std::span<const uint32_t> code = Variants.at(variant);
+        const VkShaderModuleCreateInfo  shaderModuleCreateInfo {
+            .sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+            .pNext    = nullptr,
+            .flags    = 0x0U,
+            .codeSize = code.size_bytes(),
+            .pCode    = code.data()
+        };
+        VkShaderModule module{VK_NULL_HANDLE};
+        if (vkCreateShaderModule(device, &shaderModuleCreateInfo, nullptr, &module) != VK_SUCCESS) return false;
+        const VkComputePipelineCreateInfo pipelineCreateInfo {
+            .sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+            .pNext  = nullptr,
+            .flags  = 0x0U,
+            .stage  = {
+                .sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                .pNext               = nullptr,
+                .flags               = 0x0U,
+                .stage               = VK_SHADER_STAGE_COMPUTE_BIT,
+                .module              = module,
+                .pName               = "main",
+                .pSpecializationInfo = nullptr
+            },
+            .layout             = pipelineLayout,
+            .basePipelineHandle = VK_NULL_HANDLE,
+            .basePipelineIndex  = -1
+        };
+        const VkResult result = vkCreateComputePipelines(device, getPipelineCache(), 1U, &pipelineCreateInfo, nullptr, &pipelines.at(variant));
+        vkDestroyShaderModule(device, module, nullptr);
+        if (result != VK_SUCCESS) {
+            pipelines.at(variant) = VK_NULL_HANDLE;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Vulkan::Preprocess::acquireSet(VkDescriptorSet& set, const uint64_t frame, const uint64_t safeFrame) {
+    const auto reusable = std::ranges::find_if(sets, [frame, safeFrame](const DescriptorSet& entry) { return entry.frame == Unused || (entry.frame < frame && entry.frame <= safeFrame); });
+    if (reusable != sets.end()) {
+        reusable->frame = frame;
+        set             = reusable->set;
+        return true;
+    }
+
+    const VkDevice                            device = graphicsInterface->Instance().device;
+    const std::array<VkDescriptorPoolSize, 2> poolSizes {{
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, ImageCount * SetsPerPool},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, ImageCount * SetsPerPool}
+    }};
+    const VkDescriptorPoolCreateInfo poolCreateInfo {
+        .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext         = nullptr,
+        .flags         = 0x0U,
+        .maxSets       = SetsPerPool,
+        .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+        .pPoolSizes    = poolSizes.data()
+    };
+    VkDescriptorPool pool{VK_NULL_HANDLE};
+    if (m_vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &pool) != VK_SUCCESS) return false;
+    pools.push_back(pool);
+    std::array<VkDescriptorSetLayout, SetsPerPool> layouts{};
+    layouts.fill(setLayout);
+    const VkDescriptorSetAllocateInfo allocateInfo {
+        .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext              = nullptr,
+        .descriptorPool     = pool,
+        .descriptorSetCount = SetsPerPool,
+        .pSetLayouts        = layouts.data()
+    };
+    std::array<VkDescriptorSet, SetsPerPool> allocated{};
+    if (m_vkAllocateDescriptorSets(device, &allocateInfo, allocated.data()) != VK_SUCCESS) return false;
+    for (const VkDescriptorSet entry : allocated) sets.push_back({entry, Unused});
+    sets.at(sets.size() - SetsPerPool).frame = frame;
+    set                                      = allocated.front();
+    return true;
+}
+
+bool Vulkan::Preprocess::supported() {
+    const std::lock_guard lock(mutex);
+    return create();
+}
+
+bool Vulkan::Preprocess::add(BarrierBatch& batch, const Copies& copies) {
+    UnityVulkanImage image{};
+    for (const auto& [source, destination, stretch, flip] : copies) {
+        if (source == nullptr) continue;
+        if (!batch.add(source, VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_2_SHADER_READ_BIT, image)) return false;
+        // The effect that reads the destination comes after the copy, in the same batch.
+        if (!batch.add(destination, VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT, image)) return false;
+    }
+    return true;
+}
+
+bool Vulkan::Preprocess::record(VkCommandBuffer commandBuffer, const Copies& copies) {
+    uint32_t variant{};
+    for (uint32_t image{}; image < ImageCount; ++image)
+        if (copies.at(image).source != nullptr) variant |= 1U << image;
+    if (variant == 0U) return true;
+
+    UnityVulkanRecordingState state{};
+    if (!graphicsInterface->CommandRecordingState(&state, kUnityVulkanGraphicsQueueAccess_DontCare)) return false;
+    const std::lock_guard lock(mutex);
+    if (!create()) return false;
+
+    Constants                                          constants{};
+    std::array<VkDescriptorImageInfo, ImageCount * 2U> imageInfos{};
+    std::array<VkWriteDescriptorSet, ImageCount * 2U>  writes{};
+    uint32_t                                           writeCount{};
+    VkExtent2D                                         groups{};
+    for (uint32_t image{}; image < ImageCount; ++image) {
+        const auto& [source, destination, stretch, flip] = copies.at(image);
+        if (source == nullptr) continue;
+        UnityVulkanImage sourceImage{};
+        UnityVulkanImage destinationImage{};
+        graphicsInterface->AccessTexture(source, UnityVulkanWholeImage, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0x0U, kUnityVulkanResourceAccess_ObserveOnly, &sourceImage);
+        graphicsInterface->AccessTexture(destination, UnityVulkanWholeImage, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0x0U, kUnityVulkanResourceAccess_ObserveOnly, &destinationImage);
+        if (sourceImage.image == VK_NULL_HANDLE || destinationImage.image == VK_NULL_HANDLE) return false;
+        if (destinationImage.format != Formats.at(image) || (destinationImage.usage & VK_IMAGE_USAGE_STORAGE_BIT) == 0U || (sourceImage.usage & VK_IMAGE_USAGE_SAMPLED_BIT) == 0U) return false;
+        // Depth-stencil images can only be sampled through a view of one aspect.
+        const VkImageView sourceView      = getImageView(sourceImage.image, sourceImage.format, (sourceImage.aspect & VK_IMAGE_ASPECT_DEPTH_BIT) != 0U ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT);
+        const VkImageView destinationView = getImageView(destinationImage.image, destinationImage.format, VK_IMAGE_ASPECT_COLOR_BIT);
+        if (sourceView == VK_NULL_HANDLE || destinationView == VK_NULL_HANDLE) return false;
+        imageInfos.at(image)              = {VK_NULL_HANDLE, sourceView, VK_IMAGE_LAYOUT_GENERAL};
+        imageInfos.at(ImageCount + image) = {VK_NULL_HANDLE, destinationView, VK_IMAGE_LAYOUT_GENERAL};
+        for (const uint32_t binding : {static_cast<uint32_t>(image), ImageCount + image}) {
+            writes.at(writeCount++) = {
+                .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext            = nullptr,
+                .dstSet           = VK_NULL_HANDLE,
+                .dstBinding       = binding,
+                .dstArrayElement  = 0U,
+                .descriptorCount  = 1U,
+                .descriptorType   = binding < ImageCount ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                .pImageInfo       = &imageInfos.at(binding),
+                .pBufferInfo      = nullptr,
+                .pTexelBufferView = nullptr
+            };
+        }
+
+        // A stretched copy spreads the source over the whole destination. Otherwise it is texel for texel from the
+        // origin, over the part that both images cover.
+        const VkExtent2D from{sourceImage.extent.width, sourceImage.extent.height};
+        const VkExtent2D to = stretch ? VkExtent2D{destinationImage.extent.width, destinationImage.extent.height} : VkExtent2D{std::min(from.width, destinationImage.extent.width), std::min(from.height, destinationImage.extent.height)};
+        const VkExtent2D scale = stretch ? to : from;
+        constants.transforms.at(image) = {1.0F / static_cast<float>(scale.width), (flip ? -1.0F : 1.0F) / static_cast<float>(scale.height), 0.0F, flip ? 1.0F : 0.0F};
+        constants.extents.at(image)    = {to.width, to.height};
+        groups = {std::max(groups.width, (to.width + WorkgroupSize - 1U) / WorkgroupSize), std::max(groups.height, (to.height + WorkgroupSize - 1U) / WorkgroupSize)};
+    }
+
+    VkDescriptorSet set{VK_NULL_HANDLE};
+    if (!acquireSet(set, state.currentFrameNumber, state.safeFrameNumber)) return false;
+    for (uint32_t write{}; write < writeCount; ++write) writes.at(write).dstSet = set;
+    m_vkUpdateDescriptorSets(graphicsInterface->Instance().device, writeCount, writes.data(), 0U, nullptr);
+    m_vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelines.at(variant));
+    m_vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0U, 1U, &set, 0U, nullptr);
+    m_vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0U, sizeof(constants), &constants);
+    m_vkCmdDispatch(commandBuffer, groups.width, groups.height, 1U);
+    Stats::add(Stats::PreprocessDispatches);
+
+    // Every image is already in `VK_IMAGE_LAYOUT_GENERAL`, so a memory dependency is all that the effect needs.
+    const VkMemoryBarrier2 memoryBarrier {
+        .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+        .pNext         = nullptr,
+        .srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+        .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT
+    };
+    recordBarrier(commandBuffer, memoryBarrier, {});
+    return true;
+}
+
+void Vulkan::Preprocess::destroy() {
+    const std::lock_guard lock(mutex);
+    const VkDevice device = graphicsInterface->Instance().device;
+    for (const VkDescriptorPool pool : pools) m_vkDestroyDescriptorPool(device, pool, nullptr);
+    for (VkPipeline& pipeline : pipelines)
+        if (pipeline != VK_NULL_HANDLE) m_vkDestroyPipeline(device, std::exchange(pipeline, VK_NULL_HANDLE), nullptr);
+    if (pipelineLayout != VK_NULL_HANDLE) m_vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    if (setLayout != VK_NULL_HANDLE) m_vkDestroyDescriptorSetLayout(device, setLayout, nullptr);
+    if (sampler != VK_NULL_HANDLE) m_vkDestroySampler(device, sampler, nullptr);
+    pools.clear();
+    sets.clear();
+    pipelineLayout = VK_NULL_HANDLE;
+    setLayout      = VK_NULL_HANDLE;
+    sampler        = VK_NULL_HANDLE;
+    attempted      = false;
+}
+#endif
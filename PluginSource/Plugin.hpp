@@ -1,5 +1,6 @@
 #pragma once
 #include "Upscaler/Upscaler.hpp"
+#include "Utilities/LogQueue.hpp"
 
 #include <IUnityGraphics.h>
 #include <IUnityLog.h>
@@ -16,9 +17,12 @@ inline IUnityLog*        logInterface      = nullptr;
 
 inline std::filesystem::path path = "";
 
+inline void log(const LogQueue::Level level, const LogQueue::Category category, const std::string_view msg) {
+    LogQueue::push(level, category, msg);
+}
+
 inline void log(const UnityLogType type, const std::string_view msg) {
-    if (type == kUnityLogTypeLog) return;
-    Unity::logInterface->Log(type, msg.data(), "Upscaler native library: 'GfxPluginUpscaler.dll'", 0);
+    log(LogQueue::toLevel(type), LogQueue::Plugin, msg);
 }
 
 inline void log(const Upscaler::Status status, const std::string_view msg) {
@@ -47,7 +51,9 @@ enum ImageID : uint8_t {
 
 enum Events {
     Upscale,
-    Generate
+    Generate,
+    BeginFrameTiming,
+    EndFrameTiming
 };
 
 inline enum FrameGenerationProvider : uint8_t {
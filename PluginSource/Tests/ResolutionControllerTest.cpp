@@ -0,0 +1,144 @@
+#include "Utilities/ResolutionController.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Replays synthetic GPU frame time traces through the dynamic resolution controller and checks what it did against
+// outcomes that follow from the simulated GPU. Every trace is recorded at the maximum resolution; the replay scales all
+// but `FixedShare` of each time with the pixel count and hands it to the controller `latency` frames late.
+
+namespace {
+constexpr ResolutionController::Resolution Minimum{960U, 540U};
+constexpr ResolutionController::Resolution Maximum{1920U, 1080U};
+constexpr ResolutionController::Settings   Settings{16.6F, 0.1F, 0.3F, 0.05F, 0.02F, 0.04F};
+constexpr float                            FixedShare{0.2F};
+
+uint32_t failures{};
+
+void check(const bool condition, const char* const name, const char* const message) {
+    if (condition) return;
+    std::fprintf(stderr, "%s: %s\n", name, message);
+    ++failures;
+}
+
+std::vector<ResolutionController::State> replay(const std::vector<float>& trace, const uint32_t latency) {
+    std::vector<ResolutionController::State> states(trace.size());
+    ResolutionController::replay(trace, Settings, Minimum, Maximum, latency, FixedShare, states);
+    return states;
+}
+
+// The per-axis scale at which the simulated GPU spends exactly the budget on a frame that takes `time` at full size.
+float equilibrium(const float time) {
+    return std::sqrt((Settings.targetFrameTime / time - FixedShare) / (1.0F - FixedShare));
+}
+
+uint32_t changes(const std::vector<ResolutionController::State>& states, const size_t from) {
+    uint32_t count{};
+    for (size_t frame{std::max<size_t>(from, 1U)}; frame < states.size(); ++frame) count += states[frame].resolution != states[frame - 1].resolution ? 1U : 0U;
+    return count;
+}
+
+// A constant overload settles within the tolerance band around the budget, at the scale that the simulated GPU needs,
+// no matter how late the frame times arrive.
+void convergesToBudget() {
+    for (const uint32_t latency : {0U, 2U, 5U, ResolutionController::MaxLatency}) {
+        const auto states = replay(std::vector(600U, 25.0F), latency);
+        const auto& last  = states.back();
+        check(std::abs(Settings.targetFrameTime - last.frameTime) / Settings.targetFrameTime <= Settings.tolerance, "convergesToBudget", "The frame time did not settle within the tolerance band.");
+        check(std::abs(last.scale - equilibrium(25.0F)) <= Settings.step + Settings.tolerance, "convergesToBudget", "The scale did not settle near the one that meets the budget.");
+        check(changes(states, 120U) == 0U, "convergesToBudget", "The resolution still changed after settling.");
+    }
+}
+
+// Once settled, noise that stays inside the tolerance band never moves the resolution.
+void holdsWithinTolerance() {
+    std::vector trace(600U, 25.0F);
+    constexpr std::array noise{1.02F, 0.98F, 1.01F, 0.99F, 1.0F, 1.015F, 0.985F};
+    for (size_t frame{300U}; frame < trace.size(); ++frame) trace[frame] *= noise.at(frame % noise.size());
+    const auto states = replay(trace, 2U);
+    check(changes(states, 300U) == 0U, "holdsWithinTolerance", "Noise within the tolerance band changed the resolution.");
+    check(states[299].resolution == states.back().resolution, "holdsWithinTolerance", "The resolution drifted while the load was unchanged.");
+}
+
+// Changes smaller than `step` are not applied, so a slow drift moves the resolution in a few large steps.
+void quantizesChanges() {
+    std::vector<float> trace(900U);
+    for (size_t frame{}; frame < trace.size(); ++frame) trace[frame] = 18.0F + 8.0F * static_cast<float>(frame) / static_cast<float>(trace.size());
+    const auto states = replay(trace, 2U);
+    check(changes(states, 0U) <= 20U, "quantizesChanges", "A slow drift changed the resolution too often.");
+    float smallest{1.0F};
+    for (size_t frame{1U}; frame < states.size(); ++frame)
+        if (states[frame].resolution != states[frame - 1].resolution) smallest = std::min(smallest, std::abs(states[frame].scale - states[frame - 1].scale));
+    check(smallest >= Settings.step, "quantizesChanges", "A change smaller than the step was applied.");
+}
+
+// Loads that no resolution can meet pin the controller to the minimum, and loads that fit at full size keep it at the
+// maximum, without it ever leaving the bounds.
+void clampsToBounds() {
+    const auto heavy = replay(std::vector(300U, 100.0F), 2U);
+    check(heavy.back().resolution == Minimum, "clampsToBounds", "An unreachable budget did not pin the minimum resolution.");
+    check(changes(heavy, 30U) == 0U, "clampsToBounds", "The resolution moved while pinned to the minimum.");
+    const auto light = replay(std::vector(300U, 5.0F), 2U);
+    check(changes(light, 0U) == 0U && light.back().resolution == Maximum, "clampsToBounds", "A load that fits did not keep the maximum resolution.");
+    for (const auto& states : {heavy, light}) {
+        for (const auto& state : states) {
+            check(state.resolution.width >= Minimum.width && state.resolution.width <= Maximum.width, "clampsToBounds", "The width left the bounds.");
+            check(state.resolution.height >= Minimum.height && state.resolution.height <= Maximum.height, "clampsToBounds", "The height left the bounds.");
+        }
+    }
+
+    // The loop cannot wind up while pinned, so it recovers the maximum within a few frames of the load dropping.
+    std::vector trace(600U, 100.0F);
+    std::fill(trace.begin() + 300, trace.end(), 5.0F);
+    const auto recovered = replay(trace, 2U);
+    check(recovered[315].resolution == Maximum, "clampsToBounds", "The resolution recovered slowly after being pinned to the minimum.");
+
+    // A minimum larger than the maximum is clamped to it rather than inverting the range.
+    ResolutionController controller{0U};
+    controller.configure(Settings);
+    controller.setBounds({2560U, 540U}, Maximum);
+    for (uint32_t frame{}; frame < 60U; ++frame) controller.update(100.0F);
+    check(controller.state().resolution.width == Maximum.width, "clampsToBounds", "A minimum wider than the maximum was not clamped to it.");
+}
+
+// Frame times that arrive late are rescaled by the pixel count change since the frame they measure. After a load step
+// the controller therefore does not keep shrinking the resolution while the stale, over-budget times drain, and lands on
+// the same scale regardless of the latency.
+void compensatesLatency() {
+    std::vector trace(600U, 12.0F);
+    std::fill(trace.begin() + 300, trace.end(), 30.0F);
+    for (const uint32_t latency : {1U, 5U, ResolutionController::MaxLatency}) {
+        const auto  states = replay(trace, latency);
+        const float lowest = std::ranges::min_element(states, {}, &ResolutionController::State::scale)->scale;
+        check(states[299].resolution == Maximum, "compensatesLatency", "A load that fits did not keep the maximum resolution before the step.");
+        check(states.back().scale - lowest <= Settings.step, "compensatesLatency", "The controller undershot while stale frame times drained.");
+        check(std::abs(states.back().scale - equilibrium(30.0F)) <= Settings.step + Settings.tolerance, "compensatesLatency", "The scale did not settle near the one that meets the budget.");
+    }
+
+    // The prediction itself: a time measured at full size and reported after the pixel count halved is halved too.
+    ResolutionController controller{2U};
+    controller.configure(Settings);
+    controller.setBounds(Minimum, Maximum);
+    controller.update(0.0F);
+    controller.update(0.0F);
+    controller.update(100.0F);
+    const ResolutionController::State state = controller.state();
+    check(state.scale < 1.0F, "compensatesLatency", "An overrun did not lower the resolution.");
+    controller.update(100.0F);
+    check(std::abs(controller.state().predictedFrameTime - 100.0F * state.scale * state.scale) <= 1e-3F, "compensatesLatency", "A late frame time was not rescaled by the change in pixel count.");
+}
+}  // namespace
+
+int main() {
+    convergesToBudget();
+    holdsWithinTolerance();
+    quantizesChanges();
+    clampsToBounds();
+    compensatesLatency();
+    if (failures != 0U) std::fprintf(stderr, "%u checks failed.\n", failures);
+    return failures == 0U ? EXIT_SUCCESS : EXIT_FAILURE;
+}
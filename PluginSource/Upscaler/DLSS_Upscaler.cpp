@@ -25,28 +25,20 @@
 
 #    include <filesystem>
 
-HMODULE DLSS_Upscaler::library{nullptr};
+Library DLSS_Upscaler::library{};
 bool DLSS_Upscaler::loaded{false};
+bool DLSS_Upscaler::attempted{false};
 
 uint64_t DLSS_Upscaler::applicationID{0xDC98EECU};
-uint32_t DLSS_Upscaler::users{0};
+std::atomic<uint32_t> DLSS_Upscaler::users{0};
+std::atomic<uint32_t> DLSS_Upscaler::nextViewport{0};
 
 void* (*DLSS_Upscaler::fpGetDevice)(){&staticSafeFail<static_cast<void*>(nullptr)>};
 Upscaler::Status (DLSS_Upscaler::*DLSS_Upscaler::fpSetResources)(const std::array<void*, 4>&){&DLSS_Upscaler::safeFail};
 Upscaler::Status (*DLSS_Upscaler::fpGetCommandBuffer)(void*&){&staticSafeFail};
 
-decltype(&slInit) DLSS_Upscaler::slInit{nullptr};
-decltype(&slSetD3DDevice) DLSS_Upscaler::slSetD3DDevice{nullptr};
-decltype(&slSetFeatureLoaded) DLSS_Upscaler::slSetFeatureLoaded{nullptr};
-decltype(&slGetFeatureFunction) DLSS_Upscaler::slGetFeatureFunction{nullptr};
-decltype(&slDLSSGetOptimalSettings) DLSS_Upscaler::slDLSSGetOptimalSettings{nullptr};
-decltype(&slDLSSSetOptions) DLSS_Upscaler::slDLSSSetOptions{nullptr};
-decltype(&slSetTagForFrame) DLSS_Upscaler::slSetTagForFrame{nullptr};
-decltype(&slGetNewFrameToken) DLSS_Upscaler::slGetNewFrameToken{nullptr};
-decltype(&slSetConstants) DLSS_Upscaler::slSetConstants{nullptr};
-decltype(&slEvaluateFeature) DLSS_Upscaler::slEvaluateFeature{nullptr};
-decltype(&slFreeResources) DLSS_Upscaler::slFreeResources{nullptr};
-decltype(&slShutdown) DLSS_Upscaler::slShutdown{nullptr};
+DLSS_Upscaler::Api DLSS_Upscaler::api{};
+DLSS_Upscaler::FeatureApi DLSS_Upscaler::featureApi{};
 
 #    ifdef ENABLE_VULKAN
 Upscaler::Status DLSS_Upscaler::VulkanSetResources(const std::array<void*, 4>& images) {
@@ -55,8 +47,7 @@ Upscaler::Status DLSS_Upscaler::VulkanSetResources(const std::array<void*, 4>& i
         Vulkan::getGraphicsInterface()->AccessTexture(images.at(id), UnityVulkanWholeImage, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, id == Plugin::Output ? VK_ACCESS_SHADER_WRITE_BIT : VK_ACCESS_SHADER_READ_BIT, kUnityVulkanResourceAccess_PipelineBarrier, &image);
         RETURN_STATUS_WITH_MESSAGE_IF(image.image == VK_NULL_HANDLE, RecoverableRuntimeError, "Unity provided a `VK_NULL_HANDLE` image.");
         auto& resource = resources.at(id);
-        Vulkan::destroyImageView(static_cast<VkImageView>(resource.view));
-        resource              = sl::Resource {sl::ResourceType::eTex2d, image.image, image.memory.memory, Vulkan::createImageView(image.image, image.format, image.aspect)};
+        resource              = sl::Resource {sl::ResourceType::eTex2d, image.image, image.memory.memory, Vulkan::getImageView(image.image, image.format, image.aspect)};
         resource.state        = image.layout;
         resource.usage        = image.usage;
         resource.width        = image.extent.width;
@@ -176,9 +167,9 @@ Upscaler::Status DLSS_Upscaler::setStatus(const sl::Result t_error) {
 
 void DLSS_Upscaler::log([[maybe_unused]] const sl::LogType type, const char* msg) {
     switch (type) {
-        case sl::LogType::eInfo: Plugin::log(kUnityLogTypeLog, msg); break;
-        case sl::LogType::eWarn: Plugin::log(kUnityLogTypeWarning, msg); break;
-        case sl::LogType::eError: Plugin::log(kUnityLogTypeError, msg); break;
+        case sl::LogType::eInfo: Plugin::log(LogQueue::Info, LogQueue::DeepLearningSuperSampling, msg); break;
+        case sl::LogType::eWarn: Plugin::log(LogQueue::Warning, LogQueue::DeepLearningSuperSampling, msg); break;
+        case sl::LogType::eError: Plugin::log(LogQueue::Error, LogQueue::DeepLearningSuperSampling, msg); break;
         case sl::LogType::eCount: break;
     }
 }
@@ -201,35 +192,27 @@ sl::DLSSMode DLSS_Upscaler::getQuality(const enum Quality quality) const {
 }
 
 bool DLSS_Upscaler::loadedCorrectly() {
+    // On Vulkan Streamline must be in place before the instance exists, so `Vulkan::interceptInitialization` loads it.
+    if (!attempted && GraphicsAPI::getType() != GraphicsAPI::NONE && GraphicsAPI::getType() != GraphicsAPI::VULKAN) load(GraphicsAPI::getType(), nullptr);
     return loaded;
 }
 
 void DLSS_Upscaler::load(const GraphicsAPI::Type type, void* vkGetProcAddrFunc) {
-    const std::wstring path = Plugin::path/"sl.interposer.dll";
+    attempted = true;
+    const std::filesystem::path path = Plugin::path / "sl.interposer.dll";
     if (!sl::security::verifyEmbeddedSignature(path.c_str())) return (void)(loaded = false);
-    library = LoadLibraryW(path.c_str());
-    if (library == nullptr) return (void)(loaded = false);
-    slInit               = reinterpret_cast<decltype(&::slInit)>(GetProcAddress(library, "slInit"));
-    slSetD3DDevice       = reinterpret_cast<decltype(&::slSetD3DDevice)>(GetProcAddress(library, "slSetD3DDevice"));
-    slSetFeatureLoaded   = reinterpret_cast<decltype(&::slSetFeatureLoaded)>(GetProcAddress(library, "slSetFeatureLoaded"));
-    slGetFeatureFunction = reinterpret_cast<decltype(&::slGetFeatureFunction)>(GetProcAddress(library, "slGetFeatureFunction"));
-    slSetTagForFrame     = reinterpret_cast<decltype(&::slSetTagForFrame)>(GetProcAddress(library, "slSetTagForFrame"));
-    slGetNewFrameToken   = reinterpret_cast<decltype(&::slGetNewFrameToken)>(GetProcAddress(library, "slGetNewFrameToken"));
-    slSetConstants       = reinterpret_cast<decltype(&::slSetConstants)>(GetProcAddress(library, "slSetConstants"));
-    slEvaluateFeature    = reinterpret_cast<decltype(&::slEvaluateFeature)>(GetProcAddress(library, "slEvaluateFeature"));
-    slFreeResources      = reinterpret_cast<decltype(&::slFreeResources)>(GetProcAddress(library, "slFreeResources"));
-    slShutdown           = reinterpret_cast<decltype(&::slShutdown)>(GetProcAddress(library, "slShutdown"));
+    if (!library.load(path)) return (void)(loaded = false);
+    if (!library.resolve(api, std::array{"slInit", "slSetD3DDevice", "slSetFeatureLoaded", "slGetFeatureFunction", "slSetTagForFrame", "slGetNewFrameToken", "slSetConstants", "slEvaluateFeature", "slFreeResources", "slShutdown"})) return (void)(loaded = false);
 #ifdef ENABLE_VULKAN
-    if (type == GraphicsAPI::VULKAN) *static_cast<PFN_vkGetInstanceProcAddr*>(vkGetProcAddrFunc) = reinterpret_cast<PFN_vkGetInstanceProcAddr>(GetProcAddress(library, "vkGetInstanceProcAddr"));
+    if (type == GraphicsAPI::VULKAN) *static_cast<PFN_vkGetInstanceProcAddr*>(vkGetProcAddrFunc) = reinterpret_cast<PFN_vkGetInstanceProcAddr>(library.getSymbol("vkGetInstanceProcAddr"));
 #endif
-    if (slInit == nullptr || slSetD3DDevice == nullptr || slSetFeatureLoaded == nullptr || slGetFeatureFunction == nullptr || slSetTagForFrame == nullptr || slGetNewFrameToken == nullptr || slSetConstants == nullptr || slEvaluateFeature == nullptr || slFreeResources == nullptr || slShutdown == nullptr) return (void)(loaded = false);
 
     const std::array pathStrings { Plugin::path.wstring() };
     std::array paths { pathStrings[0].c_str() };
     constexpr std::array features { sl::kFeatureDLSS };
     sl::Preferences pref {};
     pref.logMessageCallback = &DLSS_Upscaler::log;
-    pref.logLevel = sl::LogLevel::eVerbose;
+    pref.logLevel = LogQueue::enabled(LogQueue::Verbose) ? sl::LogLevel::eVerbose : sl::LogLevel::eDefault;
     pref.pathsToPlugins = paths.data();
     pref.numPathsToPlugins = paths.size();
     pref.flags |= sl::PreferenceFlags::eUseManualHooking | sl::PreferenceFlags::eUseFrameBasedResourceTagging;
@@ -243,28 +226,28 @@ void DLSS_Upscaler::load(const GraphicsAPI::Type type, void* vkGetProcAddrFunc)
         case GraphicsAPI::DX11: pref.renderAPI = sl::RenderAPI::eD3D11; break;
         default: loaded = false; return;
     }
-    if (slInit(pref, sl::kSDKVersion) != sl::Result::eOk) return (void)(loaded = false);
-    if ((type == GraphicsAPI::DX12 || type == GraphicsAPI::DX11) && slSetD3DDevice(fpGetDevice()) != sl::Result::eOk) return (void)(loaded = false);
+    if (api.slInit(pref, sl::kSDKVersion) != sl::Result::eOk) return (void)(loaded = false);
+    if ((type == GraphicsAPI::DX12 || type == GraphicsAPI::DX11) && api.slSetD3DDevice(fpGetDevice()) != sl::Result::eOk) return (void)(loaded = false);
     loaded = true;
 }
 
 void DLSS_Upscaler::shutdown() {
-    if (slShutdown != nullptr) slShutdown();
+    if (api.slShutdown != nullptr) api.slShutdown();
 }
 
 void DLSS_Upscaler::unload() {
-    if (library != nullptr) FreeLibrary(library);
-    library              = nullptr;
-    slInit               = nullptr;
-    slSetD3DDevice       = nullptr;
-    slSetFeatureLoaded   = nullptr;
-    slGetFeatureFunction = nullptr;
-    slSetTagForFrame     = nullptr;
-    slGetNewFrameToken   = nullptr;
-    slSetConstants       = nullptr;
-    slEvaluateFeature    = nullptr;
-    slFreeResources      = nullptr;
-    slShutdown           = nullptr;
+    api        = {};
+    featureApi = {};
+    library.unload();
+    loaded    = false;
+    attempted = false;
+}
+
+void DLSS_Upscaler::unloadUnused() {
+    // The Vulkan hooks stay in the dispatch chain for the lifetime of the instance.
+    if (users != 0 || GraphicsAPI::getType() == GraphicsAPI::VULKAN) return;
+    if (loaded) shutdown();
+    unload();
 }
 
 void DLSS_Upscaler::useGraphicsAPI(const GraphicsAPI::Type type) {
@@ -296,22 +279,20 @@ void DLSS_Upscaler::useGraphicsAPI(const GraphicsAPI::Type type) {
     }
 }
 
-DLSS_Upscaler::DLSS_Upscaler() : handle(users++), viewToClip(), clipToView(), clipToPrevClip(), prevClipToClip(), position(), up(), right(), forward(), farPlane(0), nearPlane(0), verticalFOV(0) {
-    if (users != 1U) return;
-    RETURN_VOID_WITH_MESSAGE_IF(setStatus(slSetFeatureLoaded(sl::kFeatureDLSS, true)), "Failed to load the NVIDIA Deep Learning Super Sampling feature.");
+DLSS_Upscaler::DLSS_Upscaler() : handle(nextViewport++), viewToClip(), clipToView(), clipToPrevClip(), prevClipToClip(), position(), up(), right(), forward(), farPlane(0), nearPlane(0), verticalFOV(0) {
+    if (++users != 1U) return;
+    RETURN_VOID_WITH_MESSAGE_IF(setStatus(api.slSetFeatureLoaded(sl::kFeatureDLSS, true)), "Failed to load the NVIDIA Deep Learning Super Sampling feature.");
     void* func{nullptr};
-    RETURN_VOID_WITH_MESSAGE_IF(setStatus(slGetFeatureFunction(sl::kFeatureDLSS, "slDLSSGetOptimalSettings", func)), "Failed to get the 'slDLSSGetOptimalSettings' function.");
-    slDLSSGetOptimalSettings = reinterpret_cast<decltype(&::slDLSSGetOptimalSettings)>(func);
-    RETURN_VOID_WITH_MESSAGE_IF(setStatus(slGetFeatureFunction(sl::kFeatureDLSS, "slDLSSSetOptions", func)), "Failed to get the 'slDLSSSetOptions' function.");
-    slDLSSSetOptions = reinterpret_cast<decltype(&::slDLSSSetOptions)>(func);
+    RETURN_VOID_WITH_MESSAGE_IF(setStatus(api.slGetFeatureFunction(sl::kFeatureDLSS, "slDLSSGetOptimalSettings", func)), "Failed to get the 'slDLSSGetOptimalSettings' function.");
+    featureApi.slDLSSGetOptimalSettings = reinterpret_cast<decltype(&::slDLSSGetOptimalSettings)>(func);
+    RETURN_VOID_WITH_MESSAGE_IF(setStatus(api.slGetFeatureFunction(sl::kFeatureDLSS, "slDLSSSetOptions", func)), "Failed to get the 'slDLSSSetOptions' function.");
+    featureApi.slDLSSSetOptions = reinterpret_cast<decltype(&::slDLSSSetOptions)>(func);
 }
 
 DLSS_Upscaler::~DLSS_Upscaler() {
-#ifdef ENABLE_VULKAN
-    if (GraphicsAPI::getType() == GraphicsAPI::VULKAN) for (const auto& resource : resources) Vulkan::destroyImageView(static_cast<VkImageView>(resource.view));
-#endif
-    slFreeResources(sl::kFeatureDLSS, handle);
-    if (--users == 0) slSetFeatureLoaded(sl::kFeatureDLSS, false);
+    if (settings.resolution.width != 0) Stats::add(Stats::DeepLearningSuperSamplingContextDestructions);
+    api.slFreeResources(sl::kFeatureDLSS, handle);
+    if (--users == 0) api.slSetFeatureLoaded(sl::kFeatureDLSS, false);
 }
 
 Upscaler::Status DLSS_Upscaler::useSettings(const Resolution resolution, const Preset preset, const enum Quality mode, const Flags flags) {
@@ -349,8 +330,13 @@ Upscaler::Status DLSS_Upscaler::useSettings(const Resolution resolution, const P
     }
     options.useAutoExposure = sl::Boolean::eTrue;
     sl::DLSSOptimalSettings slOptimalSettings;
-    RETURN_WITH_MESSAGE_IF(setStatus(slDLSSGetOptimalSettings(options, slOptimalSettings)), "Failed to get NVIDIA Deep Learning Super Sampling optimal settings.");
-    RETURN_WITH_MESSAGE_IF(setStatus(slDLSSSetOptions(handle, options)), "Failed to set NVIDIA Deep Learning Super Sampling options.");
+    RETURN_WITH_MESSAGE_IF(setStatus(featureApi.slDLSSGetOptimalSettings(options, slOptimalSettings)), "Failed to get NVIDIA Deep Learning Super Sampling optimal settings.");
+    RETURN_WITH_MESSAGE_IF(setStatus(featureApi.slDLSSSetOptions(handle, options)), "Failed to set NVIDIA Deep Learning Super Sampling options.");
+    if (const ContextCache::Key key{outputResolution, mode, flags, preset}; !(key == settings)) {
+        if (settings.resolution.width != 0) Stats::add(Stats::DeepLearningSuperSamplingContextDestructions);
+        Stats::add(Stats::DeepLearningSuperSamplingContextCreations);
+        settings = key;
+    }
     recommendedInputResolution    = Resolution{slOptimalSettings.optimalRenderWidth, slOptimalSettings.optimalRenderHeight};
     dynamicMinimumInputResolution = Resolution{slOptimalSettings.renderWidthMin, slOptimalSettings.renderHeightMin};
     dynamicMaximumInputResolution = Resolution{slOptimalSettings.renderWidthMax, slOptimalSettings.renderHeightMax};
@@ -358,15 +344,37 @@ Upscaler::Status DLSS_Upscaler::useSettings(const Resolution resolution, const P
 }
 
 Upscaler::Status DLSS_Upscaler::useImages(const std::array<void*, 4>& images) {
+    Stats::add(Stats::ImageRebinds);
     return (this->*fpSetResources)(images);
 }
 
 Upscaler::Status DLSS_Upscaler::evaluate(const Resolution inputResolution) {
+    const std::array views {View<DLSS_Upscaler>{this, inputResolution}};
+    return evaluate(views);
+}
+
+Upscaler::Status DLSS_Upscaler::evaluate(const std::span<const View<DLSS_Upscaler>> views) {
     void* commandBuffer {};
     RETURN_IF(fpGetCommandBuffer(commandBuffer));
+    sl::FrameToken* frameToken{nullptr};
+    RETURN_WITH_MESSAGE_IF(setStatus(api.slGetNewFrameToken(frameToken, nullptr)), "Failed to get new Streamline frame token.");
+    Status result = Success;
+    for (const auto& [upscaler, inputResolution] : views) {
+        if (upscaler->resetHistory) Stats::add(Stats::HistoryResets);
+        upscaler->beginTiming(commandBuffer);
+        const Status status = upscaler->record(commandBuffer, *frameToken, inputResolution);
+        upscaler->endTiming(commandBuffer);
+        if (status != Success) Stats::add(Stats::FailedDispatches);
+        if (result == Success) result = status;
+    }
+    return result;
+}
+
+Upscaler::Status DLSS_Upscaler::record(void* commandBuffer, const sl::FrameToken& frameToken, const Resolution inputResolution) {
     const sl::Extent colorExtent {0, 0, inputResolution.width, inputResolution.height};
     const sl::Extent depthExtent {0, 0, inputResolution.width, inputResolution.height};
-    const sl::Extent motionExtent {0, 0, resources.at(Plugin::Motion).width, resources.at(Plugin::Motion).height};
+    const Resolution motion = Upscaler::motionExtent(inputResolution, {resources.at(Plugin::Motion).width, resources.at(Plugin::Motion).height}, settings.flags);
+    const sl::Extent motionExtent {0, 0, motion.width, motion.height};
     const sl::Extent outputExtent {0, 0, resources.at(Plugin::Output).width, resources.at(Plugin::Output).height};
     const std::array tags {
         sl::ResourceTag {&resources.at(Plugin::Color), sl::kBufferTypeScalingInputColor, sl::ResourceLifecycle::eValidUntilEvaluate, &colorExtent},
@@ -374,9 +382,7 @@ Upscaler::Status DLSS_Upscaler::evaluate(const Resolution inputResolution) {
         sl::ResourceTag {&resources.at(Plugin::Motion), sl::kBufferTypeMotionVectors, sl::ResourceLifecycle::eValidUntilEvaluate, &motionExtent},
         sl::ResourceTag {&resources.at(Plugin::Output), sl::kBufferTypeScalingOutputColor, sl::ResourceLifecycle::eValidUntilEvaluate, &outputExtent},
     };
-    sl::FrameToken* frameToken{nullptr};
-    RETURN_WITH_MESSAGE_IF(setStatus(slGetNewFrameToken(frameToken, nullptr)), "Failed to get new Streamline frame token.");
-    RETURN_WITH_MESSAGE_IF(setStatus(slSetTagForFrame(*frameToken, handle, tags.data(), tags.size(), commandBuffer)), "Failed to set Streamline tags.");
+    RETURN_WITH_MESSAGE_IF(setStatus(api.slSetTagForFrame(frameToken, handle, tags.data(), tags.size(), commandBuffer)), "Failed to set Streamline tags.");
     sl::Constants constants {};
     std::ranges::copy(viewToClip, reinterpret_cast<float*>(constants.cameraViewToClip.row));
     std::ranges::copy(clipToView, reinterpret_cast<float*>(constants.clipToCameraView.row));
@@ -398,9 +404,9 @@ Upscaler::Status DLSS_Upscaler::evaluate(const Resolution inputResolution) {
     constants.depthInverted        = sl::eTrue;
     constants.cameraMotionIncluded = sl::eTrue;
     constants.motionVectors3D      = sl::eFalse;
-    RETURN_WITH_MESSAGE_IF(setStatus(slSetConstants(constants, *frameToken, handle)), "Failed to set Streamline constants.");
+    RETURN_WITH_MESSAGE_IF(setStatus(api.slSetConstants(constants, frameToken, handle)), "Failed to set Streamline constants.");
     std::array<const sl::BaseStructure*, 1> evaluateInputs {&handle};
-    RETURN_WITH_MESSAGE_IF(setStatus(slEvaluateFeature(sl::kFeatureDLSS, *frameToken, evaluateInputs.data(), evaluateInputs.size(), commandBuffer)), "Failed to evaluate DLSS");
+    RETURN_WITH_MESSAGE_IF(setStatus(api.slEvaluateFeature(sl::kFeatureDLSS, frameToken, evaluateInputs.data(), evaluateInputs.size(), commandBuffer)), "Failed to evaluate DLSS");
     return Success;
 }
 #endif
\ No newline at end of file
@@ -3,20 +3,27 @@
 #    include "GraphicsAPI/GraphicsAPI.hpp"
 #    include "Upscaler.hpp"
 #    include "Plugin.hpp"
+#    include "Utilities/ContextCache.hpp"
+#    include "Utilities/Library.hpp"
 
 #    include <sl.h>
 #    include <sl_dlss.h>
 
-#    include <Windows.h>
-
 #    include <array>
+#    include <atomic>
+#    include <span>
 
 class DLSS_Upscaler final : public Upscaler {
-    static HMODULE library;
+    static Library library;
     static bool loaded;
+    static bool attempted;
 
     static uint64_t applicationID;
-    static uint32_t users;
+    /// The number of live instances. The DLSS feature stays loaded while any exist.
+    static std::atomic<uint32_t> users;
+    /// The viewport of the next instance. Viewports are never reused, because an asynchronous context update keeps the
+    /// instance it replaces alive, and Streamline frees a viewport's resources when that instance is deleted.
+    static std::atomic<uint32_t> nextViewport;
 
     static void* (*fpGetDevice)();
     static Status (DLSS_Upscaler::*fpSetResources)(const std::array<void*, 4>& images);
@@ -24,19 +31,25 @@ class DLSS_Upscaler final : public Upscaler {
 
     sl::ViewportHandle handle{0};
     std::array<sl::Resource, 4> resources{};
-
-    static decltype(&slInit)                   slInit;
-    static decltype(&slSetD3DDevice)           slSetD3DDevice;
-    static decltype(&slSetFeatureLoaded)       slSetFeatureLoaded;
-    static decltype(&slGetFeatureFunction)     slGetFeatureFunction;
-    static decltype(&slDLSSGetOptimalSettings) slDLSSGetOptimalSettings;
-    static decltype(&slDLSSSetOptions)         slDLSSSetOptions;
-    static decltype(&slSetTagForFrame)         slSetTagForFrame;
-    static decltype(&slGetNewFrameToken)       slGetNewFrameToken;
-    static decltype(&slSetConstants)           slSetConstants;
-    static decltype(&slEvaluateFeature)        slEvaluateFeature;
-    static decltype(&slFreeResources)          slFreeResources;
-    static decltype(&slShutdown)               slShutdown;
+    /// The settings last handed to Streamline, which rebuilds the viewport's DLSS feature whenever they change.
+    ContextCache::Key settings{};
+
+    static struct Api {
+        decltype(&::slInit)               slInit;
+        decltype(&::slSetD3DDevice)       slSetD3DDevice;
+        decltype(&::slSetFeatureLoaded)   slSetFeatureLoaded;
+        decltype(&::slGetFeatureFunction) slGetFeatureFunction;
+        decltype(&::slSetTagForFrame)     slSetTagForFrame;
+        decltype(&::slGetNewFrameToken)   slGetNewFrameToken;
+        decltype(&::slSetConstants)       slSetConstants;
+        decltype(&::slEvaluateFeature)    slEvaluateFeature;
+        decltype(&::slFreeResources)      slFreeResources;
+        decltype(&::slShutdown)           slShutdown;
+    } api;
+    static struct FeatureApi {
+        decltype(&::slDLSSGetOptimalSettings) slDLSSGetOptimalSettings;
+        decltype(&::slDLSSSetOptions)         slDLSSSetOptions;
+    } featureApi;
 
 #    ifdef ENABLE_VULKAN
     Status        VulkanSetResources(const std::array<void*, 4>& images);
@@ -60,6 +73,8 @@ class DLSS_Upscaler final : public Upscaler {
 
     [[nodiscard]] sl::DLSSMode getQuality(enum Quality quality) const;
 
+    Status record(void* commandBuffer, const sl::FrameToken& frameToken, Resolution inputResolution);
+
 public:
     std::array<float, 16> viewToClip;
     std::array<float, 16> clipToView;
@@ -77,6 +92,7 @@ public:
     static void load(GraphicsAPI::Type type, void* vkGetProcAddrFunc);
     static void shutdown();
     static void unload();
+    static void unloadUnused();
     static void useGraphicsAPI(GraphicsAPI::Type type);
 
     DLSS_Upscaler();
@@ -89,5 +105,7 @@ public:
     Status useSettings(Resolution resolution, Preset preset, enum Quality mode, Flags flags);
     Status useImages(const std::array<void*, 4>& images);
     Status evaluate(Resolution inputResolution);
+    /// Evaluates every view into one command buffer under one Streamline frame token; each view keeps its own viewport.
+    static Status evaluate(std::span<const View<DLSS_Upscaler>> views);
 };
 #endif
\ No newline at end of file
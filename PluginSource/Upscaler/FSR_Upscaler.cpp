@@ -20,19 +20,27 @@
 #    include <ffx_upscale.h>
 
 #    include <algorithm>
+#    include <utility>
 
-HMODULE FSR_Upscaler::library{nullptr};
-bool FSR_Upscaler::loaded{false};
+Library               FSR_Upscaler::library{};
+bool                  FSR_Upscaler::loaded{false};
+bool                  FSR_Upscaler::attempted{false};
+std::atomic<uint32_t> FSR_Upscaler::users{0};
+std::mutex            FSR_Upscaler::lifetime{};
+ContextCache          FSR_Upscaler::cache{&FSR_Upscaler::destroyContext};
 
 Upscaler::Status (FSR_Upscaler::*FSR_Upscaler::fpCreate)(ffxCreateContextDescUpscale&){&FSR_Upscaler::safeFail};
 Upscaler::Status (FSR_Upscaler::*FSR_Upscaler::fpSetResources)(const std::array<void*, 6>&){&FSR_Upscaler::safeFail};
 Upscaler::Status (*FSR_Upscaler::fpGetCommandBuffer)(void*&){&staticSafeFail};
+Upscaler::Status (FSR_Upscaler::*FSR_Upscaler::fpPrepareResources)(){&FSR_Upscaler::safeFail};
+Upscaler::Status (*FSR_Upscaler::fpRecordBarriers)(void*){&staticSafeFail};
+Upscaler::Status (FSR_Upscaler::*FSR_Upscaler::fpPreprocess)(void*){&FSR_Upscaler::safeFail};
+Upscaler::Status (*FSR_Upscaler::fpReleaseResources)(void*){&staticSafeFail};
+#    ifdef ENABLE_VULKAN
+Vulkan::BarrierBatch FSR_Upscaler::barriers{};
+#    endif
 
-PfnFfxCreateContext FSR_Upscaler::ffxCreateContext;
-PfnFfxDestroyContext FSR_Upscaler::ffxDestroyContext;
-PfnFfxConfigure FSR_Upscaler::ffxConfigure;
-PfnFfxQuery FSR_Upscaler::ffxQuery;
-PfnFfxDispatch FSR_Upscaler::ffxDispatch;
+FSR_Upscaler::Api FSR_Upscaler::api{};
 
 #    ifdef ENABLE_VULKAN
 Upscaler::Status FSR_Upscaler::VulkanCreate(ffxCreateContextDescUpscale& createContextDescUpscale) {
@@ -46,24 +54,26 @@ Upscaler::Status FSR_Upscaler::VulkanCreate(ffxCreateContextDescUpscale& createC
         .vkDeviceProcAddr = Vulkan::getDeviceProcAddr()
     };
     createContextDescUpscale.header.pNext = &createBackendVKDesc.header;
-    const Status status = setStatus(ffxCreateContext(&context, &createContextDescUpscale.header, nullptr));
+    const Status status = setStatus(api.ffxCreateContext(&context, &createContextDescUpscale.header, nullptr));
     createContextDescUpscale.header.pNext = createBackendVKDesc.header.pNext;
     return status;
 }
 
 Upscaler::Status FSR_Upscaler::VulkanSetResources(const std::array<void*, 6>& images) {
+    textures = images;
     for (Plugin::ImageID id{0}; id < (autoReactive ? images.size() : 4); ++reinterpret_cast<uint8_t&>(id)) {
-        VkAccessFlags      accessFlags{VK_ACCESS_SHADER_READ_BIT};
         FfxApiResourceUsage resourceUsage{FFX_API_RESOURCE_USAGE_READ_ONLY};
-        if (id == Plugin::Output || id == Plugin::Reactive) {
-            accessFlags   = VK_ACCESS_SHADER_WRITE_BIT;
-            resourceUsage = FFX_API_RESOURCE_USAGE_UAV;
-        }
+        if (id == Plugin::Output || id == Plugin::Reactive) resourceUsage = FFX_API_RESOURCE_USAGE_UAV;
+        // Only look the image up here. Its transition is batched with the others' in `VulkanPrepareResources`.
         UnityVulkanImage image {};
-        Vulkan::getGraphicsInterface()->AccessTexture(images.at(id), UnityVulkanWholeImage, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, accessFlags, kUnityVulkanResourceAccess_PipelineBarrier, &image);
+        Vulkan::getGraphicsInterface()->AccessTexture(images.at(id), UnityVulkanWholeImage, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0x0U, kUnityVulkanResourceAccess_ObserveOnly, &image);
         auto& [resource, description, state] = resources.at(id);
         resource = image.image;
         RETURN_STATUS_WITH_MESSAGE_IF(resource == VK_NULL_HANDLE, RecoverableRuntimeError, "Unity provided a `VK_NULL_HANDLE` image.");
+        // Unity's own camera depth can be bound in place of a copy. It usually carries stencil, so FFX must be told to
+        // view only its depth aspect.
+        if (ffxApiIsDepthFormat(image.format)) resourceUsage = static_cast<FfxApiResourceUsage>(resourceUsage | FFX_API_RESOURCE_USAGE_DEPTHTARGET);
+        RETURN_STATUS_WITH_MESSAGE_IF(ffxApiGetSurfaceFormatVK(image.format) == FFX_API_SURFACE_FORMAT_UNKNOWN, RecoverableRuntimeError, "Unity provided an image in a format that FSR cannot read.");
         description = {
             .type     = FFX_API_RESOURCE_TYPE_TEXTURE2D,
             .format   = ffxApiGetSurfaceFormatVK(image.format),
@@ -79,6 +89,58 @@ Upscaler::Status FSR_Upscaler::VulkanSetResources(const std::array<void*, 6>& im
     return Success;
 }
 
+Upscaler::Status FSR_Upscaler::VulkanPrepareResources() {
+    for (Plugin::ImageID id{0}; id < (autoReactive ? textures.size() : 4); ++reinterpret_cast<uint8_t&>(id)) {
+        const VkAccessFlags2 access = id == Plugin::Output || id == Plugin::Reactive ? VK_ACCESS_2_SHADER_WRITE_BIT : VK_ACCESS_2_SHADER_READ_BIT;
+        UnityVulkanImage image {};
+        if (!barriers.add(textures.at(id), VK_IMAGE_LAYOUT_GENERAL, access, image)) {
+            // Drop the whole batch; the images queued so far would otherwise be transitioned without being dispatched.
+            barriers.clear();
+            Plugin::log(RecoverableRuntimeError, "Unity provided a `VK_NULL_HANDLE` image.");
+            return RecoverableRuntimeError;
+        }
+    }
+#        ifdef ENABLE_PREPROCESSING
+    if (!Vulkan::Preprocess::add(barriers, preprocessCopies())) {
+        barriers.clear();
+        Plugin::log(RecoverableRuntimeError, "Unity provided a `VK_NULL_HANDLE` image to preprocess.");
+        return RecoverableRuntimeError;
+    }
+#        endif
+    return Success;
+}
+
+Upscaler::Status FSR_Upscaler::VulkanRecordBarriers(void* commandBuffer) {
+    barriers.record(static_cast<VkCommandBuffer>(commandBuffer));
+    return Success;
+}
+
+Upscaler::Status FSR_Upscaler::VulkanPreprocess(void* commandBuffer) {
+#        ifdef ENABLE_PREPROCESSING
+    RETURN_STATUS_WITH_MESSAGE_IF(!Vulkan::Preprocess::record(static_cast<VkCommandBuffer>(commandBuffer), preprocessCopies()), RecoverableRuntimeError, "Failed to preprocess the depth, motion vector, and opaque-only color images.");
+    return Success;
+#        else
+    RETURN_STATUS_WITH_MESSAGE_IF(depthSource != nullptr || motionSource != nullptr || opaqueSource != nullptr, RecoverableRuntimeError, "The plugin was built without preprocessing, so Unity must copy the depth, motion vector, and opaque-only color images itself.");
+    return Success;
+#        endif
+}
+
+#        ifdef ENABLE_PREPROCESSING
+Vulkan::Preprocess::Copies FSR_Upscaler::preprocessCopies() const {
+    // The opaque-only color always matches the input in size, so it is copied texel for texel like `CopyTexture` would.
+    return {{
+      {depthSource, textures.at(Plugin::Depth), !fixedAllocation, false},
+      {motionSource, textures.at(Plugin::Motion), !fixedAllocation, false},
+      {autoReactive ? opaqueSource : nullptr, textures.at(Plugin::Opaque), false, false},
+    }};
+}
+#        endif
+
+Upscaler::Status FSR_Upscaler::VulkanReleaseResources(void* commandBuffer) {
+    barriers.restore(static_cast<VkCommandBuffer>(commandBuffer));
+    return Success;
+}
+
 Upscaler::Status FSR_Upscaler::VulkanGetCommandBuffer(void*& commandBuffer) {
     UnityVulkanRecordingState state {};
     Vulkan::getGraphicsInterface()->EnsureOutsideRenderPass();
@@ -98,7 +160,7 @@ Upscaler::Status FSR_Upscaler::DX12Create(ffxCreateContextDescUpscale& createCon
         .device = DX12::getGraphicsInterface()->GetDevice()
     };
     createContextDescUpscale.header.pNext = &createBackendDX12Desc.header;
-    const Status status = setStatus(ffxCreateContext(&context, &createContextDescUpscale.header, nullptr));
+    const Status status = setStatus(api.ffxCreateContext(&context, &createContextDescUpscale.header, nullptr));
     createContextDescUpscale.header.pNext = createBackendDX12Desc.header.pNext;
     return status;
 }
@@ -135,39 +197,47 @@ Upscaler::Status FSR_Upscaler::DX12GetCommandBuffer(void*& commandList) {
 #    endif
 
 bool FSR_Upscaler::loadedCorrectly() {
+    if (!attempted && GraphicsAPI::getType() != GraphicsAPI::NONE) load(GraphicsAPI::getType(), nullptr);
     return loaded;
 }
 
 void FSR_Upscaler::load(const GraphicsAPI::Type type, void* /*unused*/) {
-    std::filesystem::path path = Plugin::path;
+    attempted = true;
+    std::string_view name;
     switch (type) {
 #ifndef NDEBUG
-        case GraphicsAPI::VULKAN: path /= "amd_fidelityfx_vkd.dll"; break;
-        case GraphicsAPI::DX12: path /= "amd_fidelityfx_dx12d.dll"; break;
+        case GraphicsAPI::VULKAN: name = "amd_fidelityfx_vkd"; break;
+        case GraphicsAPI::DX12: name = "amd_fidelityfx_dx12d"; break;
 # else
-        case GraphicsAPI::VULKAN: path /= "amd_fidelityfx_vk.dll"; break;
-        case GraphicsAPI::DX12: path /= "amd_fidelityfx_dx12.dll"; break;
+        case GraphicsAPI::VULKAN: name = "amd_fidelityfx_vk"; break;
+        case GraphicsAPI::DX12: name = "amd_fidelityfx_dx12"; break;
 #endif
         default: return (void)(loaded = false);
     }
-    library = LoadLibrary(path.string().c_str());
-    if (library == nullptr) return (void)(loaded = false);
-    ffxCreateContext  = reinterpret_cast<PfnFfxCreateContext>(GetProcAddress(library, "ffxCreateContext"));
-    ffxDestroyContext = reinterpret_cast<PfnFfxDestroyContext>(GetProcAddress(library, "ffxDestroyContext"));
-    ffxConfigure      = reinterpret_cast<PfnFfxConfigure>(GetProcAddress(library, "ffxConfigure"));
-    ffxQuery          = reinterpret_cast<PfnFfxQuery>(GetProcAddress(library, "ffxQuery"));
-    ffxDispatch       = reinterpret_cast<PfnFfxDispatch>(GetProcAddress(library, "ffxDispatch"));
-    loaded = ffxCreateContext != nullptr && ffxDestroyContext != nullptr && ffxConfigure != nullptr && ffxQuery != nullptr && ffxDispatch != nullptr;
+    if (!library.load(Plugin::path / Library::fileName(name))) return (void)(loaded = false);
+    loaded = library.resolve(api, std::array{"ffxCreateContext", "ffxDestroyContext", "ffxConfigure", "ffxQuery", "ffxDispatch"});
 }
 
 void FSR_Upscaler::unload() {
-    ffxCreateContext = nullptr;
-    ffxDestroyContext = nullptr;
-    ffxConfigure = nullptr;
-    ffxQuery = nullptr;
-    ffxDispatch = nullptr;
-    if (library != nullptr) FreeLibrary(library);
-    library = nullptr;
+    cache.clear();
+    api = {};
+    library.unload();
+    loaded    = false;
+    attempted = false;
+}
+
+void FSR_Upscaler::unloadUnused() {
+    const std::lock_guard lock{lifetime};
+    if (users != 0) return;
+    cache.clear();
+    // Frame generation dispatches through the same library.
+    if (Plugin::frameGenerationProvider != Plugin::FSR) unload();
+}
+
+void FSR_Upscaler::destroyContext(void* context) {
+    Stats::add(Stats::FidelityFXSuperResolutionContextDestructions);
+    ffxContext handle{context};
+    setStatus(api.ffxDestroyContext(&handle, nullptr));
 }
 
 Upscaler::Status FSR_Upscaler::setStatus(const ffxReturnCode_t t_error) {
@@ -183,13 +253,10 @@ Upscaler::Status FSR_Upscaler::setStatus(const ffxReturnCode_t t_error) {
     }
 }
 
-void FSR_Upscaler::log(const FfxApiMsgType type, const wchar_t* t_msg) {
-    std::wstring message(t_msg);
-    std::string  msg(message.length(), 0);
-    std::ranges::transform(message, msg.begin(), [](const wchar_t c) { return static_cast<char>(c); });
+void FSR_Upscaler::log(const FfxApiMsgType type, const wchar_t* msg) {
     switch (type) {
-        case FFX_API_MESSAGE_TYPE_ERROR: Plugin::log(kUnityLogTypeError, msg); break;
-        case FFX_API_MESSAGE_TYPE_WARNING: Plugin::log(kUnityLogTypeWarning, msg); break;
+        case FFX_API_MESSAGE_TYPE_ERROR: LogQueue::push(LogQueue::Error, LogQueue::FidelityFXSuperResolution, std::wstring_view{msg}); break;
+        case FFX_API_MESSAGE_TYPE_WARNING: LogQueue::push(LogQueue::Warning, LogQueue::FidelityFXSuperResolution, std::wstring_view{msg}); break;
         case FFX_API_MESSAGE_TYPE_COUNT: break;
     }
 }
@@ -218,6 +285,10 @@ void FSR_Upscaler::useGraphicsAPI(const GraphicsAPI::Type type) {
             fpCreate           = &FSR_Upscaler::VulkanCreate;
             fpSetResources     = &FSR_Upscaler::VulkanSetResources;
             fpGetCommandBuffer = &FSR_Upscaler::VulkanGetCommandBuffer;
+            fpPrepareResources = &FSR_Upscaler::VulkanPrepareResources;
+            fpRecordBarriers   = &FSR_Upscaler::VulkanRecordBarriers;
+            fpPreprocess       = &FSR_Upscaler::VulkanPreprocess;
+            fpReleaseResources = &FSR_Upscaler::VulkanReleaseResources;
             break;
         }
 #    endif
@@ -226,6 +297,10 @@ void FSR_Upscaler::useGraphicsAPI(const GraphicsAPI::Type type) {
             fpCreate           = &FSR_Upscaler::DX12Create;
             fpSetResources     = &FSR_Upscaler::DX12SetResources;
             fpGetCommandBuffer = &FSR_Upscaler::DX12GetCommandBuffer;
+            fpPrepareResources = &FSR_Upscaler::safeFail<Success>;
+            fpRecordBarriers   = &staticSafeFail<Success>;
+            fpPreprocess       = &FSR_Upscaler::safeFail<Success>;
+            fpReleaseResources = &staticSafeFail<Success>;
             break;
         }
 #    endif
@@ -233,14 +308,27 @@ void FSR_Upscaler::useGraphicsAPI(const GraphicsAPI::Type type) {
             fpCreate           = &FSR_Upscaler::safeFail<UnsupportedGraphicsApi>;
             fpSetResources     = &FSR_Upscaler::safeFail<UnsupportedGraphicsApi>;
             fpGetCommandBuffer = &staticSafeFail<UnsupportedGraphicsApi>;
+            fpPrepareResources = &FSR_Upscaler::safeFail<UnsupportedGraphicsApi>;
+            fpRecordBarriers   = &staticSafeFail<UnsupportedGraphicsApi>;
+            fpPreprocess       = &FSR_Upscaler::safeFail<UnsupportedGraphicsApi>;
+            fpReleaseResources = &staticSafeFail<UnsupportedGraphicsApi>;
             break;
         }
     }
 }
 
+FSR_Upscaler::FSR_Upscaler() {
+    const std::lock_guard lock{lifetime};
+    ++users;
+}
+
 FSR_Upscaler::~FSR_Upscaler() {
-    if (context != nullptr) setStatus(ffxDestroyContext(&context, nullptr));
+    const std::lock_guard lock{lifetime};
+    // The replacement of this instance may want its context back. Contexts that do not fit are destroyed through the
+    // library, so this instance only stops counting once that is done.
+    cache.put(settings, context, contextBytes);
     context = nullptr;
+    --users;
 }
 
 Upscaler::Status FSR_Upscaler::useSettings(const Resolution resolution, const enum Quality mode, const Flags flags) {
@@ -256,7 +344,7 @@ Upscaler::Status FSR_Upscaler::useSettings(const Resolution resolution, const en
         .pOutRenderWidth  = &recommendedInputResolution.width,
         .pOutRenderHeight = &recommendedInputResolution.height
     };
-    RETURN_WITH_MESSAGE_IF(setStatus(ffxQuery(nullptr, &queryDescUpscaleGetRenderResolutionFromQualityMode.header)), "Failed to query render resolution from quality mode. Ensure that the QualityMode setting is a valid enum value.");
+    RETURN_WITH_MESSAGE_IF(setStatus(api.ffxQuery(nullptr, &queryDescUpscaleGetRenderResolutionFromQualityMode.header)), "Failed to query render resolution from quality mode. Ensure that the QualityMode setting is a valid enum value.");
 
     dynamicMinimumInputResolution = {1, 1};
     dynamicMaximumInputResolution = outputResolution;
@@ -280,20 +368,81 @@ Upscaler::Status FSR_Upscaler::useSettings(const Resolution resolution, const en
         .fpMessage      = reinterpret_cast<decltype(ffxCreateContextDescUpscale::fpMessage)>(&FSR_Upscaler::log)
     };
 
-    if (context != nullptr) RETURN_WITH_MESSAGE_IF(setStatus(ffxDestroyContext(&context, nullptr)), "Failed to destroy AMD FidelityFX Super Resolution context");
-    context = nullptr;
+    const ContextCache::Key key{outputResolution, mode, flags, Default};
+    if (context != nullptr && key == settings) return Success;
+    cache.put(settings, context, contextBytes);
+    settings = key;
+    context  = cache.take(settings, contextBytes);
+    if (context != nullptr) {
+        historyStale = true;
+        return Success;
+    }
     RETURN_IF((this->*fpCreate)(createContextDescUpscale));
+    Stats::add(Stats::FidelityFXSuperResolutionContextCreations);
+
+    FfxApiEffectMemoryUsage memoryUsage{};
+    ffxQueryDescUpscaleGetGPUMemoryUsage queryDescUpscaleGetGPUMemoryUsage {
+        .header = {
+            .type  = FFX_API_QUERY_DESC_TYPE_UPSCALE_GPU_MEMORY_USAGE,
+            .pNext = nullptr
+        },
+        .gpuMemoryUsageUpscaler = &memoryUsage
+    };
+    contextBytes = api.ffxQuery(&context, &queryDescUpscaleGetGPUMemoryUsage.header) == FFX_API_RETURN_OK ? memoryUsage.totalUsageInBytes : 0U;
     return Success;
 }
 
+uint32_t FSR_Upscaler::jitterPhaseCount(const Resolution inputResolution) const {
+    int32_t phaseCount{};
+    ffxQueryDescUpscaleGetJitterPhaseCount queryDescUpscaleGetJitterPhaseCount {
+        .header = {
+            .type  = FFX_API_QUERY_DESC_TYPE_UPSCALE_GETJITTERPHASECOUNT,
+            .pNext = nullptr
+        },
+        .renderWidth    = inputResolution.width,
+        .displayWidth   = outputResolution.width,
+        .pOutPhaseCount = &phaseCount
+    };
+    if (api.ffxQuery(nullptr, &queryDescUpscaleGetJitterPhaseCount.header) != FFX_API_RETURN_OK || phaseCount <= 0) return Upscaler::jitterPhaseCount(inputResolution);
+    return static_cast<uint32_t>(phaseCount);
+}
+
 Upscaler::Status FSR_Upscaler::useImages(const std::array<void*, 6>& images) {
+    Stats::add(Stats::ImageRebinds);
     return (this->*fpSetResources)(images);
 }
 
 Upscaler::Status FSR_Upscaler::evaluate(const Resolution inputResolution) {
+    const std::array views {View<FSR_Upscaler>{this, inputResolution}};
+    return evaluate(views);
+}
+
+Upscaler::Status FSR_Upscaler::evaluate(const std::span<const View<FSR_Upscaler>> views) {
     void* commandBuffer {};
     RETURN_IF(fpGetCommandBuffer(commandBuffer));
+    for (const auto& [upscaler, inputResolution] : views) {
+        const Status prepared = (upscaler->*fpPrepareResources)();
+        if (prepared != Success) return prepared;
+    }
+    const Status recorded = fpRecordBarriers(commandBuffer);
+    if (recorded != Success) return recorded;
+    Status dispatched = Success;
+    for (const auto& [upscaler, inputResolution] : views) {
+        upscaler->resetHistory |= std::exchange(upscaler->historyStale, false);
+        if (upscaler->resetHistory) Stats::add(Stats::HistoryResets);
+        Status status = (upscaler->*fpPreprocess)(commandBuffer);
+        upscaler->beginTiming(commandBuffer);
+        if (status == Success) status = upscaler->dispatch(commandBuffer, inputResolution);
+        upscaler->endTiming(commandBuffer);
+        if (status != Success) Stats::add(Stats::FailedDispatches);
+        if (dispatched == Success) dispatched = status;
+    }
+    // Release even if a dispatch failed, so that the images are back in the layouts that Unity is tracking.
+    const Status released = fpReleaseResources(commandBuffer);
+    return dispatched != Success ? dispatched : released;
+}
 
+Upscaler::Status FSR_Upscaler::dispatch(void* commandBuffer, const Resolution inputResolution) {
     if (autoReactive) {
         const ffxDispatchDescUpscaleGenerateReactiveMask dispatchDescUpscaleGenerateReactiveMask{
           .header = {
@@ -313,8 +462,9 @@ Upscaler::Status FSR_Upscaler::evaluate(const Resolution inputResolution) {
             static_cast<unsigned>(FFX_UPSCALE_AUTOREACTIVEFLAGS_APPLY_THRESHOLD) |
             static_cast<unsigned>(FFX_UPSCALE_AUTOREACTIVEFLAGS_USE_COMPONENTS_MAX)
         };
-        RETURN_WITH_MESSAGE_IF(setStatus(ffxDispatch(&context, &dispatchDescUpscaleGenerateReactiveMask.header)), "Failed to dispatch AMD FidelityFX Super Resolution reactive mask generation commands.");
+        RETURN_WITH_MESSAGE_IF(setStatus(api.ffxDispatch(&context, &dispatchDescUpscaleGenerateReactiveMask.header)), "Failed to dispatch AMD FidelityFX Super Resolution reactive mask generation commands.");
     }
+    const Resolution motion = motionExtent(inputResolution, {resources.at(Plugin::Motion).description.width, resources.at(Plugin::Motion).description.height}, settings.flags);
     const ffxDispatchDescUpscale dispatchDescUpscale {
         .header = {
             .type  = FFX_API_DISPATCH_DESC_TYPE_UPSCALE,
@@ -329,7 +479,7 @@ Upscaler::Status FSR_Upscaler::evaluate(const Resolution inputResolution) {
         .transparencyAndComposition = FfxApiResource {},
         .output                     = resources.at(Plugin::Output),
         .jitterOffset               = FfxApiFloatCoords2D {jitter.x, jitter.y},
-        .motionVectorScale          = FfxApiFloatCoords2D {-static_cast<float>(resources.at(Plugin::Motion).description.width), -static_cast<float>(resources.at(Plugin::Motion).description.height)},
+        .motionVectorScale          = FfxApiFloatCoords2D {-static_cast<float>(motion.width), -static_cast<float>(motion.height)},
         .renderSize                 = FfxApiDimensions2D {inputResolution.width, inputResolution.height},
         .upscaleSize                = FfxApiDimensions2D {resources.at(Plugin::Output).description.width, resources.at(Plugin::Output).description.height},
         .enableSharpening           = sharpness > 0.0F,
@@ -343,7 +493,7 @@ Upscaler::Status FSR_Upscaler::evaluate(const Resolution inputResolution) {
         .viewSpaceToMetersFactor    = 1.0F,
         .flags                      = debugView ? FFX_UPSCALE_FLAG_DRAW_DEBUG_VIEW : 0U
     };
-    RETURN_WITH_MESSAGE_IF(setStatus(ffxDispatch(&context, &dispatchDescUpscale.header)), "Failed to dispatch AMD FidelityFX Super Resolution upscaling commands.");
+    RETURN_WITH_MESSAGE_IF(setStatus(api.ffxDispatch(&context, &dispatchDescUpscale.header)), "Failed to dispatch AMD FidelityFX Super Resolution upscaling commands.");
     return Success;
 }
 #endif
\ No newline at end of file
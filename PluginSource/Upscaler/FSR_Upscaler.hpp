@@ -1,43 +1,81 @@
 #pragma once
 #ifdef ENABLE_FSR
 #    include "GraphicsAPI/GraphicsAPI.hpp"
+#    ifdef ENABLE_VULKAN
+#        include "GraphicsAPI/Vulkan.hpp"
+#    endif
 #    include "Upscaler.hpp"
 #    include "Plugin.hpp"
+#    include "Utilities/ContextCache.hpp"
+#    include "Utilities/Library.hpp"
 
 #    include <ffx_upscale.h>
 #    include <ffx_api.h>
 
-#    define NOMINMAX
-#    include <Windows.h>
-
 #    include <array>
+#    include <atomic>
+#    include <mutex>
+#    include <span>
 
 namespace ffx { struct CreateContextDescUpscale; }  // namespace ffx
 struct FfxApiResource;
 
 class FSR_Upscaler final : public Upscaler {
-    static HMODULE library;
-    static bool loaded;
+#    ifdef ENABLE_BENCHMARK
+    friend class StubFFX;
+#    endif
+
+    static Library               library;
+    static bool                  loaded;
+    static bool                  attempted;
+    /// The number of live instances. They are created on the game thread and destroyed on the render thread, so
+    /// `lifetime` keeps `unloadUnused` from unloading the library under a destructor's SDK calls.
+    static std::atomic<uint32_t> users;
+    static std::mutex            lifetime;
+    /// Shared by every instance, so that a context built by an instance that has since been replaced (for example by an
+    /// asynchronous context update) can still be swapped back in.
+    static ContextCache          cache;
 
     static Status (FSR_Upscaler::*fpCreate)(ffxCreateContextDescUpscale&);
     static Status (FSR_Upscaler::*fpSetResources)(const std::array<void*, 6>&);
     static Status (*fpGetCommandBuffer)(void*&);
+    static Status (FSR_Upscaler::*fpPrepareResources)();
+    static Status (*fpRecordBarriers)(void*);
+    static Status (FSR_Upscaler::*fpPreprocess)(void*);
+    static Status (*fpReleaseResources)(void*);
+#    ifdef ENABLE_VULKAN
+    static Vulkan::BarrierBatch barriers;
+#    endif
 
     ffxContext context{};
     std::array<FfxApiResource, 6> resources{};
+    ContextCache::Key settings{};
+    uint64_t          contextBytes{};
+#    ifdef ENABLE_VULKAN
+    std::array<void*, 6> textures{};
+#    endif
 
 public:
-    static PfnFfxCreateContext ffxCreateContext;
-    static PfnFfxDestroyContext ffxDestroyContext;
-    static PfnFfxConfigure ffxConfigure;
-    static PfnFfxQuery ffxQuery;
-    static PfnFfxDispatch ffxDispatch;
+    static struct Api {
+        PfnFfxCreateContext  ffxCreateContext;
+        PfnFfxDestroyContext ffxDestroyContext;
+        PfnFfxConfigure      ffxConfigure;
+        PfnFfxQuery          ffxQuery;
+        PfnFfxDispatch       ffxDispatch;
+    } api;
 
 private:
 #    ifdef ENABLE_VULKAN
     Status        VulkanCreate(ffxCreateContextDescUpscale& createContextDescUpscale);
     Status        VulkanSetResources(const std::array<void*, 6>& images);
     static Status VulkanGetCommandBuffer(void*& commandBuffer);
+    Status        VulkanPrepareResources();
+    static Status VulkanRecordBarriers(void* commandBuffer);
+    Status        VulkanPreprocess(void* commandBuffer);
+    static Status VulkanReleaseResources(void* commandBuffer);
+#        ifdef ENABLE_PREPROCESSING
+    [[nodiscard]] Vulkan::Preprocess::Copies preprocessCopies() const;
+#        endif
 #    endif
 
 #    ifdef ENABLE_DX12
@@ -46,11 +84,14 @@ private:
     static Status DX12GetCommandBuffer(void*& commandList);
 #    endif
 
+    static void   destroyContext(void* context);
     static Status setStatus(ffxReturnCode_t t_error);
-    static void log(FfxApiMsgType /*unused*/, const wchar_t *t_msg);
+    static void log(FfxApiMsgType /*unused*/, const wchar_t *msg);
 
     [[nodiscard]] FfxApiUpscaleQualityMode getQuality(enum Quality quality) const;
 
+    Status dispatch(void* commandBuffer, Resolution inputResolution);
+
 public:
     float frameTime;
     float sharpness;
@@ -62,16 +103,34 @@ public:
     float verticalFOV;
     bool debugView;
     bool autoReactive;
+    /// The camera's own images that the preprocessing pass copies into the depth, motion vector, and opaque-only color
+    /// images before the dispatch, or `nullptr` where Unity already filled those images itself.
+    void* depthSource{};
+    void* motionSource{};
+    void* opaqueSource{};
+    /// Whether those images are allocated for the maximum input resolution, so that depth and motion vectors are copied
+    /// texel for texel from the origin rather than stretched.
+    bool fixedAllocation{};
 
     static bool loadedCorrectly();
     static void load(GraphicsAPI::Type type, void*);
     static void unload();
+    static void unloadUnused();
     static void useGraphicsAPI(GraphicsAPI::Type type);
 
+    FSR_Upscaler();
+    FSR_Upscaler(const FSR_Upscaler&)            = delete;
+    FSR_Upscaler(FSR_Upscaler&&)                 = delete;
+    FSR_Upscaler& operator=(const FSR_Upscaler&) = delete;
+    FSR_Upscaler& operator=(FSR_Upscaler&&)      = delete;
     ~FSR_Upscaler() override;
 
     Status useSettings(Resolution resolution, enum Quality mode, Flags flags);
     Status useImages(const std::array<void*, 6>& images);
+    /// Asks FSR for the phase count, so that it follows the SDK if its recommendation changes.
+    [[nodiscard]] uint32_t jitterPhaseCount(Resolution inputResolution) const override;
     Status evaluate(Resolution inputResolution);
+    /// Evaluates every view into one command buffer, behind one barrier that covers the images of every view.
+    static Status evaluate(std::span<const View<FSR_Upscaler>> views);
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "DLSS_Upscaler.hpp"
+#include "FSR_Upscaler.hpp"
+#include "XeSS_Upscaler.hpp"
+
+#include <array>
+
+// The per-frame data that each backend publishes into its frame ring for the upscale events. The C# backends mirror
+// these layouts field for field, and the benchmark fills the FidelityFX one directly.
+
+#ifdef ENABLE_DLSS
+struct DeepLearningSuperSamplingUpscaleData
+{
+    DLSS_Upscaler* handle;
+    std::array<float, 16> viewToClip;
+    std::array<float, 16> clipToView;
+    std::array<float, 16> clipToPrevClip;
+    std::array<float, 16> prevClipToClip;
+    std::array<float, 3> position;
+    std::array<float, 3> up;
+    std::array<float, 3> right;
+    std::array<float, 3> forward;
+    float farPlane;
+    float nearPlane;
+    float verticalFOV;
+    Upscaler::Jitter jitter;
+    Upscaler::Resolution inputResolution;
+    bool resetHistory;
+};
+#endif
+
+#ifdef ENABLE_FSR
+struct FidelityFXSuperResolutionUpscaleData
+{
+    FSR_Upscaler* handle;
+    float frameTime;
+    float sharpness;
+    float reactiveValue;
+    float reactiveScale;
+    float reactiveThreshold;
+    float farPlane;
+    float nearPlane;
+    float verticalFOV;
+    Upscaler::Jitter jitter;
+    Upscaler::Resolution inputResolution;
+    /// Bit 0 enables the debug view, bit 1 resets the history, and bit 2 marks the images as allocated for the maximum
+    /// input resolution (see `FSR_Upscaler::fixedAllocation`).
+    unsigned options;
+    void* depthSource;
+    void* motionSource;
+    void* opaqueSource;
+};
+#endif
+
+#ifdef ENABLE_XESS
+struct XeSuperSamplingUpscaleData
+{
+    XeSS_Upscaler* handle;
+    Upscaler::Jitter jitter;
+    Upscaler::Resolution inputResolution;
+    bool resetHistory;
+};
+#endif
@@ -2,31 +2,52 @@
 
 #include "DLSS_Upscaler.hpp"
 #include "FSR_Upscaler.hpp"
-#include "XeSS_UPscaler.hpp"
+#include "XeSS_Upscaler.hpp"
 
 #include "GraphicsAPI/GraphicsAPI.hpp"
+#include "Utilities/JitterSequence.hpp"
 
-void Upscaler::load(const GraphicsAPI::Type type, void* vkGetProcAddrFunc) {
+void Upscaler::beginTiming(void* commandBuffer) {
+#ifdef ENABLE_VULKAN
+    if (GraphicsAPI::getType() == GraphicsAPI::VULKAN) timestamps.begin(static_cast<VkCommandBuffer>(commandBuffer), timings);
+#endif
+}
+
+void Upscaler::endTiming(void* commandBuffer) {
+#ifdef ENABLE_VULKAN
+    if (GraphicsAPI::getType() == GraphicsAPI::VULKAN) timestamps.end(static_cast<VkCommandBuffer>(commandBuffer));
+#endif
+}
+
+Upscaler::Resolution Upscaler::motionExtent(const Resolution inputResolution, const Resolution motionImage, const Flags flags) {
+    return (flags & OutputResolutionMotionVectors) == OutputResolutionMotionVectors ? motionImage : inputResolution;
+}
+
+uint32_t Upscaler::jitterPhaseCount(const Resolution inputResolution) const {
+    return JitterSequence::phaseCount(inputResolution.width, outputResolution.width);
+}
+
+void Upscaler::unload() {
 #    ifdef ENABLE_DLSS
-    DLSS_Upscaler::load(type, vkGetProcAddrFunc);
+    DLSS_Upscaler::unload();
 #    endif
 #    ifdef ENABLE_FSR
-    FSR_Upscaler::load(type, nullptr);
+    FSR_Upscaler::unload();
 #    endif
 #    ifdef ENABLE_XESS
-    XeSS_Upscaler::load(type, nullptr);
+    XeSS_Upscaler::unload();
 #    endif
 }
 
-void Upscaler::unload() {
+void Upscaler::unloadUnused() {
 #    ifdef ENABLE_DLSS
-    DLSS_Upscaler::unload();
+    DLSS_Upscaler::unloadUnused();
 #    endif
 #    ifdef ENABLE_FSR
-    FSR_Upscaler::unload();
+    FSR_Upscaler::unloadUnused();
 #    endif
 #    ifdef ENABLE_XESS
-    XeSS_Upscaler::unload();
+    XeSS_Upscaler::unloadUnused();
 #    endif
 }
 
@@ -40,4 +61,10 @@ void Upscaler::useGraphicsAPI(const GraphicsAPI::Type type) {
 #ifdef ENABLE_XESS
     XeSS_Upscaler::useGraphicsAPI(type);
 #endif
+}
+
+Upscaler::~Upscaler() {
+#ifdef ENABLE_VULKAN
+    timestamps.release();
+#endif
 }
\ No newline at end of file
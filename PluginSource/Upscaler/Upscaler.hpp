@@ -1,6 +1,11 @@
 #pragma once
 
 #include "GraphicsAPI/GraphicsAPI.hpp"
+#ifdef ENABLE_VULKAN
+#    include "GraphicsAPI/Vulkan.hpp"
+#endif
+#include "Utilities/Stats.hpp"
+#include "Utilities/Timings.hpp"
 
 #include <vector>
 
@@ -25,10 +30,10 @@ if ((bool)(x)) {                                          \
         return;                                 \
     }                                           \
 }
-#define RETURN_IF(x)                   \
-{                                      \
-    Upscaler::Status status = x;       \
-    if ((x) != Success) return status; \
+#define RETURN_IF(x)                      \
+{                                         \
+    Upscaler::Status status = x;          \
+    if (status != Success) return status; \
 }
 
 class Upscaler {
@@ -84,15 +89,49 @@ public:
 
     bool resetHistory{};
 
+    /// GPU time spent in this upscaler's dispatches. Only measured on Vulkan.
+    Timings timings;
+
+    /// The most views that one batched evaluation records.
+    static constexpr uint32_t MaxBatchViews{4U};
+
+    /// One view of a batched evaluation: an upscaler whose per-frame data has been set, and the input resolution that
+    /// it is evaluated at.
+    template<typename T>
+    struct View {
+        T*         upscaler;
+        Resolution inputResolution;
+    };
+
 protected:
+    /// Set when a cached context is swapped back in; its history belongs to an earlier stretch of frames.
+    bool historyStale{};
+#ifdef ENABLE_VULKAN
+    Vulkan::TimestampRing timestamps;
+#endif
+
     template<auto val = FatalRuntimeError, typename... Args> constexpr auto safeFail(Args... /*unused*/) { return val; }
     template<auto val = FatalRuntimeError, typename... Args> constexpr auto safeFail(Args... /*unused*/) const { return val; }
     template<auto val = FatalRuntimeError, typename... Args> static constexpr auto staticSafeFail(Args... /*unused*/) { return val; }
 
+    /// Brackets the commands recorded into `commandBuffer` between the two calls with timestamps that resolve into
+    /// `timings` a few evaluations later.
+    void beginTiming(void* commandBuffer);
+    void endTiming(void* commandBuffer);
+
+    /// The part of a `motionImage`-sized motion vector image that holds this frame's motion vectors. Images may be
+    /// allocated for the largest input resolution, so input resolution motion vectors only fill the render rect at the
+    /// origin; display resolution motion vectors always fill the whole image.
+    static Resolution motionExtent(Resolution inputResolution, Resolution motionImage, Flags flags);
+
 public:
-    static void load(GraphicsAPI::Type type, void* vkGetProcAddrFunc=nullptr);
     static void unload();
+    static void unloadUnused();
     static void useGraphicsAPI(GraphicsAPI::Type type);
 
-    virtual ~Upscaler() = default;
+    /// How many phases of the jitter sequence to cycle through while rendering at `inputResolution` for this context's
+    /// output resolution.
+    [[nodiscard]] virtual uint32_t jitterPhaseCount(Resolution inputResolution) const;
+
+    virtual ~Upscaler();
 };
\ No newline at end of file
@@ -26,37 +26,37 @@
 #        include <xess/xess_d3d11.h>
 #    endif
 
-HMODULE XeSS_Upscaler::library{nullptr};
-HMODULE XeSS_Upscaler::dx11library{nullptr};
-bool    XeSS_Upscaler::loaded{false};
+#    include <utility>
+
+Library               XeSS_Upscaler::library{};
+Library               XeSS_Upscaler::dx11library{};
+bool                  XeSS_Upscaler::loaded{false};
+bool                  XeSS_Upscaler::attempted{false};
+std::atomic<uint32_t> XeSS_Upscaler::users{0};
+std::mutex            XeSS_Upscaler::lifetime{};
+ContextCache          XeSS_Upscaler::cache{&XeSS_Upscaler::destroyContext};
 
 Upscaler::Status (XeSS_Upscaler::* XeSS_Upscaler::fpCreate)(const void*){&XeSS_Upscaler::safeFail};
 Upscaler::Status (XeSS_Upscaler::* XeSS_Upscaler::fpSetImages)(const std::array<void*, 4>&){&XeSS_Upscaler::safeFail};
-Upscaler::Status (XeSS_Upscaler::* XeSS_Upscaler::fpEvaluate)(Resolution) const {&XeSS_Upscaler::safeFail};
+Upscaler::Status (XeSS_Upscaler::* XeSS_Upscaler::fpEvaluate)(Resolution, void*) const {&XeSS_Upscaler::safeFail};
+Upscaler::Status (*XeSS_Upscaler::fpGetCommandBuffer)(void*&){&staticSafeFail};
 
-decltype(&xessGetOptimalInputResolution) XeSS_Upscaler::xessGetOptimalInputResolution{nullptr};
-decltype(&xessDestroyContext)            XeSS_Upscaler::xessDestroyContext{nullptr};
-decltype(&xessSetVelocityScale)          XeSS_Upscaler::xessSetVelocityScale{nullptr};
-decltype(&xessSetLoggingCallback)        XeSS_Upscaler::xessSetLoggingCallback{nullptr};
+XeSS_Upscaler::Api XeSS_Upscaler::api{};
 #    ifdef ENABLE_VULKAN
-decltype(&xessVKGetRequiredInstanceExtensions) XeSS_Upscaler::xessVKGetRequiredInstanceExtensions{nullptr};
-decltype(&xessVKCreateContext)                 XeSS_Upscaler::xessVKCreateContext{nullptr};
-decltype(&xessVKBuildPipelines)                XeSS_Upscaler::xessVKBuildPipelines{nullptr};
-decltype(&xessVKInit)                          XeSS_Upscaler::xessVKInit{nullptr};
-decltype(&xessVKExecute)                       XeSS_Upscaler::xessVKExecute{nullptr};
+XeSS_Upscaler::VulkanApi XeSS_Upscaler::vulkanApi{};
 #    endif
 #    ifdef ENABLE_DX12
-decltype(&xessD3D12CreateContext)  XeSS_Upscaler::xessD3D12CreateContext{nullptr};
-decltype(&xessD3D12BuildPipelines) XeSS_Upscaler::xessD3D12BuildPipelines{nullptr};
-decltype(&xessD3D12Init)           XeSS_Upscaler::xessD3D12Init{nullptr};
-decltype(&xessD3D12Execute)        XeSS_Upscaler::xessD3D12Execute{nullptr};
+XeSS_Upscaler::DX12Api XeSS_Upscaler::dx12Api{};
 #    endif
 #    ifdef ENABLE_DX11
-decltype(&xessD3D11CreateContext) XeSS_Upscaler::xessD3D11CreateContext{nullptr};
-decltype(&xessD3D11Init)          XeSS_Upscaler::xessD3D11Init{nullptr};
-decltype(&xessD3D11Execute)       XeSS_Upscaler::xessD3D11Execute{nullptr};
+XeSS_Upscaler::DX11Api XeSS_Upscaler::dx11Api{};
 #    endif
 
+void XeSS_Upscaler::destroyContext(void* context) {
+    Stats::add(Stats::XeSuperSamplingContextDestructions);
+    setStatus(api.xessDestroyContext(static_cast<xess_context_handle_t>(context)));
+}
+
 Upscaler::Status XeSS_Upscaler::setStatus(const xess_result_t t_error) {
     switch (t_error) {
         case XESS_RESULT_WARNING_NONEXISTING_FOLDER:
@@ -80,10 +80,10 @@ Upscaler::Status XeSS_Upscaler::setStatus(const xess_result_t t_error) {
 
 void XeSS_Upscaler::log(const char* msg, const xess_logging_level_t type) {
     switch (type) {
-        case XESS_LOGGING_LEVEL_DEBUG: Plugin::log(kUnityLogTypeException, msg); break;
-        case XESS_LOGGING_LEVEL_INFO: Plugin::log(kUnityLogTypeLog, msg); break;
-        case XESS_LOGGING_LEVEL_WARNING: Plugin::log(kUnityLogTypeWarning, msg); break;
-        case XESS_LOGGING_LEVEL_ERROR: Plugin::log(kUnityLogTypeError, msg); break;
+        case XESS_LOGGING_LEVEL_DEBUG: Plugin::log(LogQueue::Verbose, LogQueue::XeSuperSampling, msg); break;
+        case XESS_LOGGING_LEVEL_INFO: Plugin::log(LogQueue::Info, LogQueue::XeSuperSampling, msg); break;
+        case XESS_LOGGING_LEVEL_WARNING: Plugin::log(LogQueue::Warning, LogQueue::XeSuperSampling, msg); break;
+        case XESS_LOGGING_LEVEL_ERROR: Plugin::log(LogQueue::Error, LogQueue::XeSuperSampling, msg); break;
     }
 }
 
@@ -108,11 +108,12 @@ xess_quality_settings_t XeSS_Upscaler::getQuality(const enum Quality quality) co
 
 #    ifdef ENABLE_VULKAN
 Upscaler::Status XeSS_Upscaler::VulkanCreate(const void* params) {
-    const auto*               vkParams = static_cast<const xess_vk_init_params_t*>(params);
+    xess_vk_init_params_t     vkParams = *static_cast<const xess_vk_init_params_t*>(params);
     const UnityVulkanInstance instance = Vulkan::getGraphicsInterface()->Instance();
-    RETURN_WITH_MESSAGE_IF(setStatus(xessVKCreateContext(instance.instance, instance.physicalDevice, instance.device, &context)), "Failed to create the Intel Xe Super Sampling context.");
-    RETURN_WITH_MESSAGE_IF(setStatus(xessVKBuildPipelines(context, vkParams->pipelineCache, true, vkParams->initFlags)), "Failed to build Xe Super Sampling pipelines.");
-    RETURN_WITH_MESSAGE_IF(setStatus(xessVKInit(context, vkParams)), "Failed to initialize the Intel Xe Super Sampling context.");
+    vkParams.pipelineCache             = Vulkan::getPipelineCache();
+    RETURN_WITH_MESSAGE_IF(setStatus(vulkanApi.xessVKCreateContext(instance.instance, instance.physicalDevice, instance.device, &context)), "Failed to create the Intel Xe Super Sampling context.");
+    RETURN_WITH_MESSAGE_IF(setStatus(vulkanApi.xessVKBuildPipelines(context, vkParams.pipelineCache, true, vkParams.initFlags)), "Failed to build Xe Super Sampling pipelines.");
+    RETURN_WITH_MESSAGE_IF(setStatus(vulkanApi.xessVKInit(context, &vkParams)), "Failed to initialize the Intel Xe Super Sampling context.");
     return Success;
 }
 
@@ -122,9 +123,8 @@ Upscaler::Status XeSS_Upscaler::VulkanSetImages(const std::array<void*, 4>& imag
         Vulkan::getGraphicsInterface()->AccessTexture(images.at(id), UnityVulkanWholeImage, id == Plugin::Output ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | (id == Plugin::Output ? VK_ACCESS_SHADER_WRITE_BIT : 0), kUnityVulkanResourceAccess_PipelineBarrier, &image);
         RETURN_STATUS_WITH_MESSAGE_IF(image.image == VK_NULL_HANDLE, RecoverableRuntimeError, "Unity provided a `VK_NULL_HANDLE` image.");
         XeSSResource& resource = resources.at(id);
-        Vulkan::destroyImageView(resource.vulkan.imageView);
         resource = XeSSResource{.vulkan = {
-            .imageView = Vulkan::createImageView(image.image, image.format, image.aspect),
+            .imageView = Vulkan::getImageView(image.image, image.format, image.aspect),
             .image = image.image,
             .subresourceRange = {
                 .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
@@ -141,7 +141,15 @@ Upscaler::Status XeSS_Upscaler::VulkanSetImages(const std::array<void*, 4>& imag
     return Success;
 }
 
-Upscaler::Status XeSS_Upscaler::VulkanEvaluate(const Resolution inputResolution) const {
+Upscaler::Status XeSS_Upscaler::VulkanGetCommandBuffer(void*& commandBuffer) {
+    UnityVulkanRecordingState state{};
+    Vulkan::getGraphicsInterface()->EnsureOutsideRenderPass();
+    RETURN_STATUS_WITH_MESSAGE_IF(!Vulkan::getGraphicsInterface()->CommandRecordingState(&state, kUnityVulkanGraphicsQueueAccess_DontCare), FatalRuntimeError, "Unable to obtain a command recording state from Unity. This is fatal.");
+    commandBuffer = state.commandBuffer;
+    return Success;
+}
+
+Upscaler::Status XeSS_Upscaler::VulkanEvaluate(const Resolution inputResolution, void* commandBuffer) const {
     const xess_vk_image_view_info  motion = resources.at(Plugin::Motion).vulkan;
     const xess_vk_execute_params_t params {
       .colorTexture    = resources.at(Plugin::Color).vulkan,
@@ -155,21 +163,20 @@ Upscaler::Status XeSS_Upscaler::VulkanEvaluate(const Resolution inputResolution)
       .inputWidth      = inputResolution.width,
       .inputHeight     = inputResolution.height,
     };
-    UnityVulkanRecordingState state{};
-    Vulkan::getGraphicsInterface()->EnsureOutsideRenderPass();
-    RETURN_STATUS_WITH_MESSAGE_IF(!Vulkan::getGraphicsInterface()->CommandRecordingState(&state, kUnityVulkanGraphicsQueueAccess_DontCare), FatalRuntimeError, "Unable to obtain a command recording state from Unity. This is fatal.");
-    RETURN_WITH_MESSAGE_IF(setStatus(xessSetVelocityScale(context, -static_cast<float>(motion.width), -static_cast<float>(motion.height))), "Failed to set motion scale.");
-    RETURN_WITH_MESSAGE_IF(setStatus(xessVKExecute(context, state.commandBuffer, &params)), "Failed to execute Intel Xe Super Sampling.");
+    const Resolution scale = motionExtent(inputResolution, {motion.width, motion.height}, settings.flags);
+    RETURN_WITH_MESSAGE_IF(setStatus(api.xessSetVelocityScale(context, -static_cast<float>(scale.width), -static_cast<float>(scale.height))), "Failed to set motion scale.");
+    RETURN_WITH_MESSAGE_IF(setStatus(vulkanApi.xessVKExecute(context, static_cast<VkCommandBuffer>(commandBuffer), &params)), "Failed to execute Intel Xe Super Sampling.");
     return Success;
 }
 #endif
 
 #    ifdef ENABLE_DX12
 Upscaler::Status XeSS_Upscaler::DX12Create(const void* params) {
-    const auto* dx12Params = static_cast<const xess_d3d12_init_params_t*>(params);
-    RETURN_WITH_MESSAGE_IF(setStatus(xessD3D12CreateContext(DX12::getGraphicsInterface()->GetDevice(), &context)), "Failed to create the Intel Xe Super Sampling context.");
-    RETURN_WITH_MESSAGE_IF(setStatus(xessD3D12BuildPipelines(context, dx12Params->pPipelineLibrary, true, dx12Params->initFlags)), "Failed to build Xe Super Sampling pipelines.");
-    RETURN_WITH_MESSAGE_IF(setStatus(xessD3D12Init(context, dx12Params)), "Failed to initialize the Intel Xe Super Sampling context.");
+    xess_d3d12_init_params_t dx12Params = *static_cast<const xess_d3d12_init_params_t*>(params);
+    dx12Params.pPipelineLibrary         = DX12::getPipelineLibrary();
+    RETURN_WITH_MESSAGE_IF(setStatus(dx12Api.xessD3D12CreateContext(DX12::getGraphicsInterface()->GetDevice(), &context)), "Failed to create the Intel Xe Super Sampling context.");
+    RETURN_WITH_MESSAGE_IF(setStatus(dx12Api.xessD3D12BuildPipelines(context, dx12Params.pPipelineLibrary, true, dx12Params.initFlags)), "Failed to build Xe Super Sampling pipelines.");
+    RETURN_WITH_MESSAGE_IF(setStatus(dx12Api.xessD3D12Init(context, &dx12Params)), "Failed to initialize the Intel Xe Super Sampling context.");
     return Success;
 }
 
@@ -182,7 +189,14 @@ Upscaler::Status XeSS_Upscaler::DX12SetImages(const std::array<void*, 4>& images
     return Success;
 }
 
-Upscaler::Status XeSS_Upscaler::DX12Evaluate(const Resolution inputResolution) const {
+Upscaler::Status XeSS_Upscaler::DX12GetCommandBuffer(void*& commandList) {
+    UnityGraphicsD3D12RecordingState state{};
+    RETURN_STATUS_WITH_MESSAGE_IF(!DX12::getGraphicsInterface()->CommandRecordingState(&state), FatalRuntimeError, "Unable to obtain a command recording state from Unity. This is fatal.");
+    commandList = state.commandList;
+    return Success;
+}
+
+Upscaler::Status XeSS_Upscaler::DX12Evaluate(const Resolution inputResolution, void* commandList) const {
     const D3D12_RESOURCE_DESC motionDescription = resources.at(Plugin::Motion).dx12->GetDesc();
     const xess_d3d12_execute_params_t params {
       .pColorTexture    = resources.at(Plugin::Color).dx12,
@@ -196,18 +210,17 @@ Upscaler::Status XeSS_Upscaler::DX12Evaluate(const Resolution inputResolution) c
       .inputWidth       = inputResolution.width,
       .inputHeight      = inputResolution.height
     };
-    UnityGraphicsD3D12RecordingState state{};
-    RETURN_STATUS_WITH_MESSAGE_IF(!DX12::getGraphicsInterface()->CommandRecordingState(&state), FatalRuntimeError, "Unable to obtain a command recording state from Unity. This is fatal.");
-    RETURN_WITH_MESSAGE_IF(setStatus(xessSetVelocityScale(context, -static_cast<float>(motionDescription.Width), -static_cast<float>(motionDescription.Height))), "Failed to set motion scale.");
-    RETURN_WITH_MESSAGE_IF(setStatus(xessD3D12Execute(context, state.commandList, &params)), "Failed to execute Intel Xe Super Sampling.");
+    const Resolution scale = motionExtent(inputResolution, {static_cast<uint32_t>(motionDescription.Width), motionDescription.Height}, settings.flags);
+    RETURN_WITH_MESSAGE_IF(setStatus(api.xessSetVelocityScale(context, -static_cast<float>(scale.width), -static_cast<float>(scale.height))), "Failed to set motion scale.");
+    RETURN_WITH_MESSAGE_IF(setStatus(dx12Api.xessD3D12Execute(context, static_cast<ID3D12GraphicsCommandList*>(commandList), &params)), "Failed to execute Intel Xe Super Sampling.");
     return Success;
 }
 #endif
 
 #    ifdef ENABLE_DX11
 Upscaler::Status XeSS_Upscaler::DX11Create(const void* params) {
-    RETURN_WITH_MESSAGE_IF(setStatus(xessD3D11CreateContext(DX11::getGraphicsInterface()->GetDevice(), &context)), "Failed to create the Intel Xe Super Sampling context.");
-    RETURN_WITH_MESSAGE_IF(setStatus(xessD3D11Init(context, static_cast<const xess_d3d11_init_params_t*>(params))), "Failed to initialize the Intel Xe Super Sampling context.");
+    RETURN_WITH_MESSAGE_IF(setStatus(dx11Api.xessD3D11CreateContext(DX11::getGraphicsInterface()->GetDevice(), &context)), "Failed to create the Intel Xe Super Sampling context.");
+    RETURN_WITH_MESSAGE_IF(setStatus(dx11Api.xessD3D11Init(context, static_cast<const xess_d3d11_init_params_t*>(params))), "Failed to initialize the Intel Xe Super Sampling context.");
     return Success;
 }
 
@@ -220,7 +233,7 @@ Upscaler::Status XeSS_Upscaler::DX11SetImages(const std::array<void*, 4>& images
     return Success;
 }
 
-Upscaler::Status XeSS_Upscaler::DX11Evaluate(const Resolution inputResolution) const {
+Upscaler::Status XeSS_Upscaler::DX11Evaluate(const Resolution inputResolution, void* /*unused*/) const {
     D3D11_TEXTURE2D_DESC motionDescription;
     resources.at(Plugin::Motion).dx11->GetDesc(&motionDescription);
     const xess_d3d11_execute_params_t params {
@@ -235,52 +248,37 @@ Upscaler::Status XeSS_Upscaler::DX11Evaluate(const Resolution inputResolution) c
       .inputWidth       = inputResolution.width,
       .inputHeight      = inputResolution.height
     };
-    RETURN_WITH_MESSAGE_IF(setStatus(xessSetVelocityScale(context, -static_cast<float>(motionDescription.Width), -static_cast<float>(motionDescription.Height))), "Failed to set motion scale.");
-    RETURN_WITH_MESSAGE_IF(setStatus(xessD3D11Execute(context, &params)), "Failed to execute Intel Xe Super Sampling.");
+    const Resolution scale = motionExtent(inputResolution, {motionDescription.Width, motionDescription.Height}, settings.flags);
+    RETURN_WITH_MESSAGE_IF(setStatus(api.xessSetVelocityScale(context, -static_cast<float>(scale.width), -static_cast<float>(scale.height))), "Failed to set motion scale.");
+    RETURN_WITH_MESSAGE_IF(setStatus(dx11Api.xessD3D11Execute(context, &params)), "Failed to execute Intel Xe Super Sampling.");
     return Success;
 }
 #    endif
 
 bool XeSS_Upscaler::loadedCorrectly() {
+    if (!attempted && GraphicsAPI::getType() != GraphicsAPI::NONE) load(GraphicsAPI::getType(), nullptr);
     return loaded;
 }
 
 void XeSS_Upscaler::load(const GraphicsAPI::Type type, void* /*unused*/) {
-    library = LoadLibrary((Plugin::path / "libxess.dll").string().c_str());
-    if (library == nullptr) return (void)(loaded = false);
-    xessGetOptimalInputResolution = reinterpret_cast<decltype(xessGetOptimalInputResolution)>(GetProcAddress(library, "xessGetOptimalInputResolution"));
-    xessDestroyContext            = reinterpret_cast<decltype(xessDestroyContext)>(GetProcAddress(library, "xessDestroyContext"));
-    xessSetVelocityScale          = reinterpret_cast<decltype(xessSetVelocityScale)>(GetProcAddress(library, "xessSetVelocityScale"));
-    xessSetLoggingCallback        = reinterpret_cast<decltype(xessSetLoggingCallback)>(GetProcAddress(library, "xessSetLoggingCallback"));
-    if (xessGetOptimalInputResolution == nullptr || xessDestroyContext == nullptr || xessSetVelocityScale == nullptr || xessSetLoggingCallback == nullptr) return (void)(loaded = false);
+    attempted = true;
+    if (!library.load(Plugin::path / Library::fileName("libxess"))) return (void)(loaded = false);
+    if (!library.resolve(api, std::array{"xessGetOptimalInputResolution", "xessDestroyContext", "xessSetVelocityScale", "xessSetLoggingCallback", "xessGetProperties"})) return (void)(loaded = false);
     switch (type) {
 #    ifdef ENABLE_VULKAN
         case GraphicsAPI::VULKAN:
-            xessVKGetRequiredInstanceExtensions = reinterpret_cast<decltype(xessVKGetRequiredInstanceExtensions)>(GetProcAddress(library, "xessVKGetRequiredInstanceExtensions"));
-            xessVKCreateContext                 = reinterpret_cast<decltype(xessVKCreateContext)>(GetProcAddress(library, "xessVKCreateContext"));
-            xessVKBuildPipelines                = reinterpret_cast<decltype(xessVKBuildPipelines)>(GetProcAddress(library, "xessVKBuildPipelines"));
-            xessVKInit                          = reinterpret_cast<decltype(xessVKInit)>(GetProcAddress(library, "xessVKInit"));
-            xessVKExecute                       = reinterpret_cast<decltype(xessVKExecute)>(GetProcAddress(library, "xessVKExecute"));
-            if (xessVKGetRequiredInstanceExtensions == nullptr || xessVKCreateContext == nullptr || xessVKBuildPipelines == nullptr || xessVKInit == nullptr || xessVKExecute == nullptr) return (void) (loaded = false);
+            if (!library.resolve(vulkanApi, std::array{"xessVKGetRequiredInstanceExtensions", "xessVKCreateContext", "xessVKBuildPipelines", "xessVKInit", "xessVKExecute"})) return (void)(loaded = false);
             break;
 #    endif
 #    ifdef ENABLE_DX12
         case GraphicsAPI::DX12:
-            xessD3D12CreateContext  = reinterpret_cast<decltype(xessD3D12CreateContext)>(GetProcAddress(library, "xessD3D12CreateContext"));
-            xessD3D12BuildPipelines = reinterpret_cast<decltype(xessD3D12BuildPipelines)>(GetProcAddress(library, "xessD3D12BuildPipelines"));
-            xessD3D12Init           = reinterpret_cast<decltype(xessD3D12Init)>(GetProcAddress(library, "xessD3D12Init"));
-            xessD3D12Execute        = reinterpret_cast<decltype(xessD3D12Execute)>(GetProcAddress(library, "xessD3D12Execute"));
-            if (xessD3D12CreateContext == nullptr || xessD3D12BuildPipelines == nullptr || xessD3D12Init == nullptr || xessD3D12Execute == nullptr) return (void)(loaded = false);
+            if (!library.resolve(dx12Api, std::array{"xessD3D12CreateContext", "xessD3D12BuildPipelines", "xessD3D12Init", "xessD3D12Execute"})) return (void)(loaded = false);
             break;
 #    endif
 #    ifdef ENABLE_DX11
         case GraphicsAPI::DX11:
-            dx11library = LoadLibrary((Plugin::path / "libxess_dx11.dll").string().c_str());
-            if (dx11library == nullptr) return (void)(loaded = false);
-            xessD3D11CreateContext = reinterpret_cast<decltype(xessD3D11CreateContext)>(GetProcAddress(dx11library, "xessD3D11CreateContext"));
-            xessD3D11Init          = reinterpret_cast<decltype(xessD3D11Init)>(GetProcAddress(dx11library, "xessD3D11Init"));
-            xessD3D11Execute       = reinterpret_cast<decltype(xessD3D11Execute)>(GetProcAddress(dx11library, "xessD3D11Execute"));
-            if (xessD3D11CreateContext == nullptr || xessD3D11Init == nullptr || xessD3D11Execute == nullptr) return (void)(loaded = false);
+            if (!dx11library.load(Plugin::path / Library::fileName("libxess_dx11"))) return (void)(loaded = false);
+            if (!dx11library.resolve(dx11Api, std::array{"xessD3D11CreateContext", "xessD3D11Init", "xessD3D11Execute"})) return (void)(loaded = false);
             break;
 #    endif
         default: return (void)(loaded = false);
@@ -289,71 +287,79 @@ void XeSS_Upscaler::load(const GraphicsAPI::Type type, void* /*unused*/) {
 }
 
 void XeSS_Upscaler::unload() {
-    xessGetOptimalInputResolution = nullptr;
-    xessDestroyContext            = nullptr;
-    xessSetVelocityScale          = nullptr;
-    xessSetLoggingCallback        = nullptr;
+    cache.clear();
+    api = {};
 #    ifdef ENABLE_VULKAN
-    xessVKCreateContext  = nullptr;
-    xessVKBuildPipelines = nullptr;
-    xessVKInit           = nullptr;
-    xessVKExecute        = nullptr;
+    vulkanApi = {};
 #    endif
 #    ifdef ENABLE_DX12
-    xessD3D12CreateContext  = nullptr;
-    xessD3D12BuildPipelines = nullptr;
-    xessD3D12Init           = nullptr;
-    xessD3D12Execute        = nullptr;
+    dx12Api = {};
 #    endif
 #    ifdef ENABLE_DX11
-    xessD3D11CreateContext = nullptr;
-    xessD3D11Init          = nullptr;
-    xessD3D11Execute       = nullptr;
-    if (dx11library != nullptr) FreeLibrary(dx11library);
-    dx11library = nullptr;
+    dx11Api = {};
+    dx11library.unload();
 #    endif
-    if (library != nullptr) FreeLibrary(library);
-    library = nullptr;
+    library.unload();
+    loaded    = false;
+    attempted = false;
+}
+
+void XeSS_Upscaler::unloadUnused() {
+    const std::lock_guard lock{lifetime};
+    if (users == 0) unload();
 }
 
 void XeSS_Upscaler::useGraphicsAPI(const GraphicsAPI::Type type) {
     switch (type) {
 #    ifdef ENABLE_VULKAN
         case GraphicsAPI::VULKAN: {
-            fpCreate    = &XeSS_Upscaler::VulkanCreate;
-            fpSetImages = &XeSS_Upscaler::VulkanSetImages;
-            fpEvaluate  = &XeSS_Upscaler::VulkanEvaluate;
+            fpCreate           = &XeSS_Upscaler::VulkanCreate;
+            fpSetImages        = &XeSS_Upscaler::VulkanSetImages;
+            fpEvaluate         = &XeSS_Upscaler::VulkanEvaluate;
+            fpGetCommandBuffer = &XeSS_Upscaler::VulkanGetCommandBuffer;
             break;
         }
 #    endif
 #    ifdef ENABLE_DX12
         case GraphicsAPI::DX12: {
-            fpCreate    = &XeSS_Upscaler::DX12Create;
-            fpSetImages = &XeSS_Upscaler::DX12SetImages;
-            fpEvaluate  = &XeSS_Upscaler::DX12Evaluate;
+            fpCreate           = &XeSS_Upscaler::DX12Create;
+            fpSetImages        = &XeSS_Upscaler::DX12SetImages;
+            fpEvaluate         = &XeSS_Upscaler::DX12Evaluate;
+            fpGetCommandBuffer = &XeSS_Upscaler::DX12GetCommandBuffer;
             break;
         }
 #    endif
 #    ifdef ENABLE_DX11
         case GraphicsAPI::DX11: {
-            fpCreate    = &XeSS_Upscaler::DX11Create;
-            fpSetImages = &XeSS_Upscaler::DX11SetImages;
-            fpEvaluate  = &XeSS_Upscaler::DX11Evaluate;
+            fpCreate           = &XeSS_Upscaler::DX11Create;
+            fpSetImages        = &XeSS_Upscaler::DX11SetImages;
+            fpEvaluate         = &XeSS_Upscaler::DX11Evaluate;
+            fpGetCommandBuffer = &staticSafeFail<Success>;
             break;
         }
 #    endif
         default: {
-            fpCreate    = &XeSS_Upscaler::safeFail<UnsupportedGraphicsApi>;
-            fpSetImages = &XeSS_Upscaler::safeFail<UnsupportedGraphicsApi>;
-            fpEvaluate  = &XeSS_Upscaler::safeFail<UnsupportedGraphicsApi>;
+            fpCreate           = &XeSS_Upscaler::safeFail<UnsupportedGraphicsApi>;
+            fpSetImages        = &XeSS_Upscaler::safeFail<UnsupportedGraphicsApi>;
+            fpEvaluate         = &XeSS_Upscaler::safeFail<UnsupportedGraphicsApi>;
+            fpGetCommandBuffer = &staticSafeFail<UnsupportedGraphicsApi>;
             break;
         }
     }
 }
 
+XeSS_Upscaler::XeSS_Upscaler() {
+    const std::lock_guard lock{lifetime};
+    ++users;
+}
+
 XeSS_Upscaler::~XeSS_Upscaler() {
-    if (context != nullptr) RETURN_VOID_WITH_MESSAGE_IF(setStatus(xessDestroyContext(context)), "Failed to destroy the Intel Xe Super Sampling context.");
+    const std::lock_guard lock{lifetime};
+    // The replacement of this instance may want its context back. Contexts that do not fit are destroyed through the
+    // library, so this instance only stops counting once that is done.
+    cache.put(settings, context, contextBytes);
     context = nullptr;
+    --users;
 }
 
 Upscaler::Status XeSS_Upscaler::useSettings(const Resolution resolution, const enum Quality mode, const Flags flags) {
@@ -367,15 +373,25 @@ Upscaler::Status XeSS_Upscaler::useSettings(const Resolution resolution, const e
         ((flags & OutputResolutionMotionVectors) == OutputResolutionMotionVectors ? XESS_INIT_FLAG_HIGH_RES_MV : XESS_INIT_FLAG_NONE) |
         ((flags & EnableHDR) == EnableHDR ? XESS_INIT_FLAG_LDR_INPUT_COLOR : XESS_INIT_FLAG_NONE)
     };
-    if (context != nullptr) RETURN_WITH_MESSAGE_IF(setStatus(xessDestroyContext(context)), "Failed to destroy the Intel Xe Super Sampling context.");
-    context = nullptr;
-    RETURN_IF((this->*fpCreate)(&params));
+    const xess_2d_t         dstRes{outputResolution.width, outputResolution.height};
+    const ContextCache::Key key{outputResolution, mode, flags, Default};
+    if (context == nullptr || !(key == settings)) {
+        cache.put(settings, context, contextBytes);
+        settings = key;
+        context  = static_cast<xess_context_handle_t>(cache.take(settings, contextBytes));
+        if (context != nullptr) historyStale = true;
+        else {
+            RETURN_IF((this->*fpCreate)(&params));
+            Stats::add(Stats::XeSuperSamplingContextCreations);
 #    ifndef NDEBUG
-    RETURN_WITH_MESSAGE_IF(setStatus(xessSetLoggingCallback(context, XESS_LOGGING_LEVEL_DEBUG, &XeSS_Upscaler::log)), "Failed to set logging callback.");
+            RETURN_WITH_MESSAGE_IF(setStatus(api.xessSetLoggingCallback(context, LogQueue::enabled(LogQueue::Verbose) ? XESS_LOGGING_LEVEL_DEBUG : XESS_LOGGING_LEVEL_INFO, &XeSS_Upscaler::log)), "Failed to set logging callback.");
 #    endif
-    const xess_2d_t dstRes{outputResolution.width, outputResolution.height};
+            xess_properties_t properties{};
+            contextBytes = api.xessGetProperties(context, &dstRes, &properties) == XESS_RESULT_SUCCESS ? properties.tempBufferHeapSize + properties.tempTextureHeapSize : 0U;
+        }
+    }
     xess_2d_t       optimal, min, max;
-    RETURN_WITH_MESSAGE_IF(setStatus(xessGetOptimalInputResolution(context, &dstRes, params.qualitySetting, &optimal, &min, &max)), "Failed to get dynamic resolution parameters.");
+    RETURN_WITH_MESSAGE_IF(setStatus(api.xessGetOptimalInputResolution(context, &dstRes, params.qualitySetting, &optimal, &min, &max)), "Failed to get dynamic resolution parameters.");
     recommendedInputResolution    = Resolution{optimal.x, optimal.y};
     dynamicMinimumInputResolution = Resolution{min.x, min.y};
     dynamicMaximumInputResolution = Resolution{max.x, max.y};
@@ -383,10 +399,28 @@ Upscaler::Status XeSS_Upscaler::useSettings(const Resolution resolution, const e
 }
 
 Upscaler::Status XeSS_Upscaler::useImages(const std::array<void*, 4>& images) {
+    Stats::add(Stats::ImageRebinds);
     return (this->*fpSetImages)(images);
 }
 
 Upscaler::Status XeSS_Upscaler::evaluate(const Resolution inputResolution) {
-    return (this->*fpEvaluate)(inputResolution);
+    const std::array views {View<XeSS_Upscaler>{this, inputResolution}};
+    return evaluate(views);
+}
+
+Upscaler::Status XeSS_Upscaler::evaluate(const std::span<const View<XeSS_Upscaler>> views) {
+    void* commandBuffer {};
+    RETURN_IF(fpGetCommandBuffer(commandBuffer));
+    Status result = Success;
+    for (const auto& [upscaler, inputResolution] : views) {
+        upscaler->resetHistory |= std::exchange(upscaler->historyStale, false);
+        if (upscaler->resetHistory) Stats::add(Stats::HistoryResets);
+        upscaler->beginTiming(commandBuffer);
+        const Status status = (upscaler->*fpEvaluate)(inputResolution, commandBuffer);
+        upscaler->endTiming(commandBuffer);
+        if (status != Success) Stats::add(Stats::FailedDispatches);
+        if (result == Success) result = status;
+    }
+    return result;
 }
 #endif
\ No newline at end of file
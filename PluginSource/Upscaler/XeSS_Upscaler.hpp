@@ -3,6 +3,8 @@
 #    include "GraphicsAPI/GraphicsAPI.hpp"
 #    include "Upscaler.hpp"
 #    include "Plugin.hpp"
+#    include "Utilities/ContextCache.hpp"
+#    include "Utilities/Library.hpp"
 
 #    ifdef ENABLE_VULKAN
 #        define NOMINMAX
@@ -17,10 +19,10 @@
 #        include <xess/xess_d3d11.h>
 #    endif
 
-#    define NOMINMAX
-#    include <Windows.h>
-
 #    include <array>
+#    include <atomic>
+#    include <mutex>
+#    include <span>
 
 class XeSS_Upscaler final : public Upscaler {
     union XeSSResource {
@@ -29,56 +31,79 @@ class XeSS_Upscaler final : public Upscaler {
         ID3D11Texture2D*        dx11;
     };
 
-    static HMODULE library;
-    static HMODULE dx11library;
-    static bool    loaded;
+    static Library               library;
+    static Library               dx11library;
+    static bool                  loaded;
+    static bool                  attempted;
+    /// The number of live instances. They are created on the game thread and destroyed on the render thread, so
+    /// `lifetime` keeps `unloadUnused` from unloading the library under a destructor's SDK calls.
+    static std::atomic<uint32_t> users;
+    static std::mutex            lifetime;
+    /// Shared by every instance, so that a context built by an instance that has since been replaced (for example by an
+    /// asynchronous context update) can still be swapped back in.
+    static ContextCache          cache;
 
     static Status (XeSS_Upscaler::*fpCreate)(const void*);
     static Status (XeSS_Upscaler::*fpSetImages)(const std::array<void*, 4>&);
-    static Status (XeSS_Upscaler::*fpEvaluate)(Resolution) const;
+    static Status (XeSS_Upscaler::*fpEvaluate)(Resolution, void*) const;
+    static Status (*fpGetCommandBuffer)(void*&);
 
     xess_context_handle_t       context{nullptr};
     std::array<XeSSResource, 4> resources{};
+    ContextCache::Key           settings{};
+    uint64_t                    contextBytes{};
 
-    static decltype(&xessGetOptimalInputResolution) xessGetOptimalInputResolution;
-    static decltype(&xessDestroyContext)            xessDestroyContext;
-    static decltype(&xessSetVelocityScale)          xessSetVelocityScale;
-    static decltype(&xessSetLoggingCallback)        xessSetLoggingCallback;
+    static struct Api {
+        decltype(&::xessGetOptimalInputResolution) xessGetOptimalInputResolution;
+        decltype(&::xessDestroyContext)            xessDestroyContext;
+        decltype(&::xessSetVelocityScale)          xessSetVelocityScale;
+        decltype(&::xessSetLoggingCallback)        xessSetLoggingCallback;
+        decltype(&::xessGetProperties)             xessGetProperties;
+    } api;
 #    ifdef ENABLE_VULKAN
-    static decltype(&xessVKGetRequiredInstanceExtensions) xessVKGetRequiredInstanceExtensions;
-    static decltype(&xessVKCreateContext)                 xessVKCreateContext;
-    static decltype(&xessVKBuildPipelines)                xessVKBuildPipelines;
-    static decltype(&xessVKInit)                          xessVKInit;
-    static decltype(&xessVKExecute)                       xessVKExecute;
+    static struct VulkanApi {
+        decltype(&::xessVKGetRequiredInstanceExtensions) xessVKGetRequiredInstanceExtensions;
+        decltype(&::xessVKCreateContext)                 xessVKCreateContext;
+        decltype(&::xessVKBuildPipelines)                xessVKBuildPipelines;
+        decltype(&::xessVKInit)                          xessVKInit;
+        decltype(&::xessVKExecute)                       xessVKExecute;
+    } vulkanApi;
 #    endif
 #    ifdef ENABLE_DX12
-    static decltype(&xessD3D12CreateContext)  xessD3D12CreateContext;
-    static decltype(&xessD3D12BuildPipelines) xessD3D12BuildPipelines;
-    static decltype(&xessD3D12Init)           xessD3D12Init;
-    static decltype(&xessD3D12Execute)        xessD3D12Execute;
+    static struct DX12Api {
+        decltype(&::xessD3D12CreateContext)  xessD3D12CreateContext;
+        decltype(&::xessD3D12BuildPipelines) xessD3D12BuildPipelines;
+        decltype(&::xessD3D12Init)           xessD3D12Init;
+        decltype(&::xessD3D12Execute)        xessD3D12Execute;
+    } dx12Api;
 #    endif
 #    ifdef ENABLE_DX11
-    static decltype(&xessD3D11CreateContext) xessD3D11CreateContext;
-    static decltype(&xessD3D11Init)          xessD3D11Init;
-    static decltype(&xessD3D11Execute)       xessD3D11Execute;
+    static struct DX11Api {
+        decltype(&::xessD3D11CreateContext) xessD3D11CreateContext;
+        decltype(&::xessD3D11Init)          xessD3D11Init;
+        decltype(&::xessD3D11Execute)       xessD3D11Execute;
+    } dx11Api;
 #    endif
 
 #    ifdef ENABLE_VULKAN
     Status               VulkanCreate(const void*);
     Status               VulkanSetImages(const std::array<void*, 4>&);
-    [[nodiscard]] Status VulkanEvaluate(Resolution inputResolution) const;
+    [[nodiscard]] Status VulkanEvaluate(Resolution inputResolution, void* commandBuffer) const;
+    static Status        VulkanGetCommandBuffer(void*& commandBuffer);
 #    endif
 #    ifdef ENABLE_DX12
     Status               DX12Create(const void*);
     Status               DX12SetImages(const std::array<void*, 4>&);
-    [[nodiscard]] Status DX12Evaluate(Resolution inputResolution) const;
+    [[nodiscard]] Status DX12Evaluate(Resolution inputResolution, void* commandBuffer) const;
+    static Status        DX12GetCommandBuffer(void*& commandBuffer);
 #    endif
 #    ifdef ENABLE_DX11
     Status               DX11Create(const void*);
     Status               DX11SetImages(const std::array<void*, 4>&);
-    [[nodiscard]] Status DX11Evaluate(Resolution inputResolution) const;
+    [[nodiscard]] Status DX11Evaluate(Resolution inputResolution, void* commandBuffer) const;
 #    endif
 
+    static void   destroyContext(void* context);
     static Status setStatus(xess_result_t t_error);
     static void log(const char* msg, xess_logging_level_t type);
 
@@ -88,9 +113,10 @@ public:
     static bool loadedCorrectly();
     static void load(GraphicsAPI::Type type, void*);
     static void unload();
+    static void unloadUnused();
     static void useGraphicsAPI(GraphicsAPI::Type type);
 
-    XeSS_Upscaler()                                = default;
+    XeSS_Upscaler();
     XeSS_Upscaler(const XeSS_Upscaler&)            = delete;
     XeSS_Upscaler(XeSS_Upscaler&&)                 = delete;
     XeSS_Upscaler& operator=(const XeSS_Upscaler&) = delete;
@@ -100,5 +126,7 @@ public:
     Status useSettings(Resolution resolution, enum Quality mode, Flags flags);
     Status useImages(const std::array<void*, 4>& images);
     Status evaluate(Resolution inputResolution);
+    /// Evaluates every view into one command buffer.
+    static Status evaluate(std::span<const View<XeSS_Upscaler>> views);
 };
 #endif
@@ -0,0 +1,58 @@
+#include "ContextCache.hpp"
+
+#include <algorithm>
+
+std::list<ContextCache::Entry> ContextCache::entries{};
+uint64_t                       ContextCache::budget{256ULL * 1024ULL * 1024ULL};
+uint64_t                       ContextCache::used{0};
+std::mutex                     ContextCache::mutex{};
+
+bool ContextCache::Key::operator==(const Key& other) const {
+    return resolution.width == other.resolution.width && resolution.height == other.resolution.height && quality == other.quality && flags == other.flags && preset == other.preset;
+}
+
+void ContextCache::evict(const std::list<Entry>::iterator entry) {
+    used -= entry->bytes;
+    entry->owner->destroy(entry->context);
+    entries.erase(entry);
+}
+
+void ContextCache::trim() {
+    while (used > budget && !entries.empty()) evict(std::prev(entries.end()));
+}
+
+ContextCache::ContextCache(void (*destroy)(void*)) : destroy(destroy) {}
+
+void* ContextCache::take(const Key& key, uint64_t& bytes) {
+    const std::lock_guard lock(mutex);
+    const auto entry = std::ranges::find_if(entries, [this, &key](const Entry& e) { return e.owner == this && e.key == key; });
+    if (entry == entries.end()) return nullptr;
+    void* context = entry->context;
+    bytes         = entry->bytes;
+    used -= entry->bytes;
+    entries.erase(entry);
+    return context;
+}
+
+void ContextCache::put(const Key& key, void* context, const uint64_t bytes) {
+    if (context == nullptr) return;
+    const std::lock_guard lock(mutex);
+    entries.emplace_front(this, key, context, bytes);
+    used += bytes;
+    trim();
+}
+
+void ContextCache::clear() {
+    const std::lock_guard lock(mutex);
+    for (auto entry = entries.begin(); entry != entries.end();) {
+        const auto next = std::next(entry);
+        if (entry->owner == this) evict(entry);
+        entry = next;
+    }
+}
+
+void ContextCache::setBudget(const uint64_t bytes) {
+    const std::lock_guard lock(mutex);
+    budget = bytes;
+    trim();
+}
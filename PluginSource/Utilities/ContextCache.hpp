@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Upscaler/Upscaler.hpp"
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+
+/// Keeps recently used upscaler contexts alive so that switching back to a previous configuration is a pointer swap
+/// rather than a full SDK context (and pipeline) rebuild. Every cache shares one least-recently-used list and one VRAM
+/// budget; contexts are evicted from the tail of that list until the cached contexts fit in the budget again.
+/// Only the context that an upscaler is not currently using lives in the cache. Calls come from the game thread and from
+/// the workers that apply asynchronous context updates, so the shared list is guarded by a lock.
+/// Each upscaler provider owns a single static cache, shared by all of its instances, and clears it before unloading the
+/// library that its contexts are destroyed through. A cache does not clear itself on destruction, since the shared list
+/// may already be gone by the time static destructors run.
+class ContextCache {
+public:
+    struct Key {
+        Upscaler::Resolution  resolution;
+        enum Upscaler::Quality quality;
+        Upscaler::Flags       flags;
+        Upscaler::Preset      preset;
+
+        bool operator==(const Key& other) const;
+    };
+
+private:
+    struct Entry {
+        const ContextCache* owner;
+        Key                 key;
+        void*               context;
+        uint64_t            bytes;
+    };
+
+    static std::list<Entry> entries;
+    static uint64_t         budget;
+    static uint64_t         used;
+    static std::mutex       mutex;
+
+    void (*destroy)(void*);
+
+    static void evict(std::list<Entry>::iterator entry);
+    static void trim();
+
+public:
+    explicit ContextCache(void (*destroy)(void*));
+    ContextCache(const ContextCache&)            = delete;
+    ContextCache(ContextCache&&)                 = delete;
+    ContextCache& operator=(const ContextCache&) = delete;
+    ContextCache& operator=(ContextCache&&)      = delete;
+    ~ContextCache()                              = default;
+
+    /// Removes and returns the context cached for `key` along with its size, or `nullptr` if there is none.
+    void* take(const Key& key, uint64_t& bytes);
+    /// Hands an idle context to the cache. It may be destroyed immediately if it does not fit in the budget.
+    void put(const Key& key, void* context, uint64_t bytes);
+    /// Destroys every context this cache holds.
+    void clear();
+
+    static void setBudget(uint64_t bytes);
+};
@@ -0,0 +1,58 @@
+#include "ContextUpdate.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+std::vector<std::unique_ptr<ContextUpdate>>      ContextUpdate::abandoned{};
+std::vector<std::shared_future<Upscaler::Status>> ContextUpdate::running{};
+std::mutex                                        ContextUpdate::mutex{};
+
+bool ContextUpdate::ready() const {
+    return result.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+}
+
+void ContextUpdate::track(const std::shared_future<Upscaler::Status>& worker) {
+    const std::lock_guard lock{mutex};
+    std::erase_if(running, [](const std::shared_future<Upscaler::Status>& other) { return other.wait_for(std::chrono::seconds::zero()) == std::future_status::ready; });
+    running.push_back(worker);
+}
+
+bool ContextUpdate::poll(Upscaler::Status& status) const {
+    if (!ready()) return false;
+    status = result.get();
+    return true;
+}
+
+Upscaler* ContextUpdate::finish() {
+    if (result.get() != Upscaler::Success) return nullptr;
+    return replacement.release();
+}
+
+void ContextUpdate::cancel(ContextUpdate* update) {
+    {
+        const std::lock_guard lock{mutex};
+        abandoned.emplace_back(update);
+    }
+    reap();
+}
+
+void ContextUpdate::reap(const bool wait) {
+    // Updates are destroyed and waited on outside the lock, so that `start` and `cancel` never block on a worker.
+    std::vector<std::unique_ptr<ContextUpdate>>      finished;
+    std::vector<std::shared_future<Upscaler::Status>> workers;
+    {
+        const std::lock_guard lock{mutex};
+        if (wait) {
+            finished = std::move(abandoned);
+            workers  = std::move(running);
+            abandoned.clear();
+            running.clear();
+        } else {
+            const auto done = std::ranges::partition(abandoned, [](const std::unique_ptr<ContextUpdate>& update) { return !update->ready(); });
+            finished.insert(finished.end(), std::make_move_iterator(done.begin()), std::make_move_iterator(done.end()));
+            abandoned.erase(done.begin(), done.end());
+        }
+    }
+    for (const std::shared_future<Upscaler::Status>& worker : workers) worker.wait();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Upscaler/Upscaler.hpp"
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// A settings change that is being applied to a fresh upscaler on a worker thread, so that SDK context creation never
+/// blocks the game thread. The upscaler that is currently in use keeps rendering until the game thread sees the update
+/// finish and swaps the replacement in. The old upscaler must then be destroyed on the render thread, after the last
+/// evaluation that references it.
+class ContextUpdate {
+    std::unique_ptr<Upscaler>            replacement;
+    std::shared_future<Upscaler::Status> result;
+
+    static std::vector<std::unique_ptr<ContextUpdate>>      abandoned;
+    /// The workers of every update that has been started, whether or not its update was cancelled since.
+    static std::vector<std::shared_future<Upscaler::Status>> running;
+    static std::mutex                                        mutex;
+
+    [[nodiscard]] bool ready() const;
+
+    static void track(const std::shared_future<Upscaler::Status>& worker);
+
+    explicit ContextUpdate(std::unique_ptr<Upscaler>&& upscaler) : replacement(std::move(upscaler)) {}
+
+public:
+    ContextUpdate(const ContextUpdate&)            = delete;
+    ContextUpdate(ContextUpdate&&)                 = delete;
+    ContextUpdate& operator=(const ContextUpdate&) = delete;
+    ContextUpdate& operator=(ContextUpdate&&)      = delete;
+    /// Waits for the worker if it is still running (`result` is destroyed first), then discards the replacement.
+    ~ContextUpdate()                               = default;
+
+    /// Creates a new `T` and starts applying `settings` to it on a worker thread.
+    template<typename T, typename... Settings>
+    static ContextUpdate* start(Settings... settings) {
+        reap();
+        auto* update   = new ContextUpdate(std::make_unique<T>());
+        update->result = std::async(std::launch::async, [upscaler = static_cast<T*>(update->replacement.get()), settings...] { return upscaler->useSettings(settings...); });
+        track(update->result);
+        return update;
+    }
+
+    /// Returns `true` once the worker has finished, storing the result of applying the settings in `status`.
+    bool poll(Upscaler::Status& status) const;
+    /// Waits for the worker and hands over the replacement, or returns `nullptr` if applying the settings failed.
+    Upscaler* finish();
+
+    /// Drops `update` without waiting on the game thread; it is destroyed once its worker finishes.
+    static void cancel(ContextUpdate* update);
+    /// Destroys cancelled updates whose workers have finished. If `wait` is set, blocks until every worker has finished,
+    /// including those of updates that have not been finished or cancelled yet.
+    static void reap(bool wait = false);
+};
@@ -0,0 +1,60 @@
+#include "FrameGenerationGovernor.hpp"
+
+#include "Stats.hpp"
+
+void FrameGenerationGovernor::configure(const Settings& newSettings) {
+    const std::lock_guard lock(mutex);
+    settings = newSettings;
+    started  = false;
+    pending  = false;
+    active.store(true, std::memory_order_relaxed);
+}
+
+void FrameGenerationGovernor::record() {
+    const Clock::time_point now = Clock::now();
+    const std::lock_guard   lock(mutex);
+    if (!settings.enabled) return;
+    const double elapsed = std::chrono::duration<double, std::milli>(now - last).count();
+    last                 = now;
+    if (!started || elapsed > MaximumInterval || elapsed <= 0.0) {
+        if (!started) interval = 0.0;
+        started = true;
+        pending = false;
+        return;
+    }
+    interval = interval == 0.0 ? elapsed : interval + (elapsed - interval) * Smoothing;
+
+    const double rate    = 1000.0 / interval;
+    const double floor   = settings.minimumBaseRate * settings.refreshRate;
+    const double ceiling = settings.maximumBaseRate * settings.refreshRate;
+    const double band    = settings.hysteresis * settings.refreshRate;
+    const bool   on      = active.load(std::memory_order_relaxed);
+    const bool   change  = on ? rate < floor || rate >= ceiling : rate >= floor + band && rate < ceiling - band;
+    if (!change) {
+        pending = false;
+        return;
+    }
+    if (!pending) {
+        pending      = true;
+        pendingSince = now;
+    }
+    if (std::chrono::duration<double, std::milli>(now - pendingSince).count() < settings.holdTime) return;
+    pending = false;
+    active.store(!on, std::memory_order_relaxed);
+    Stats::add(on ? Stats::FrameGenerationGovernorDisables : Stats::FrameGenerationGovernorEnables);
+}
+
+void FrameGenerationGovernor::reset() {
+    const std::lock_guard lock(mutex);
+    started = false;
+    pending = false;
+}
+
+bool FrameGenerationGovernor::decide(const bool enable) const {
+    return enable && active.load(std::memory_order_relaxed);
+}
+
+FrameGenerationGovernor::State FrameGenerationGovernor::state() const {
+    const std::lock_guard lock(mutex);
+    return {active.load(std::memory_order_relaxed), settings.enabled && started && interval > 0.0 ? static_cast<float>(1000.0 / interval) : 0.0F};
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+/// Decides whether frame generation is worth running from the rate at which the application presents real frames.
+/// Below a floor relative to the display's refresh rate, interpolation adds more latency and artifacts than it removes
+/// judder; at or above a ceiling, the display cannot show the extra frames and the interpolation is wasted GPU time.
+/// Turning frame generation back on needs the base rate to clear the thresholds by a hysteresis band, and every change
+/// must stay warranted for a hold time, so a rate hovering near a threshold does not toggle frame generation.
+class FrameGenerationGovernor {
+public:
+    struct Settings {
+        /// While unset, frame generation follows the application's `enable` flag exactly.
+        bool enabled;
+        /// The display's refresh rate in hertz.
+        float refreshRate;
+        /// Frame generation turns off when the base rate falls below this fraction of the refresh rate.
+        float minimumBaseRate;
+        /// Frame generation turns off when the base rate reaches this fraction of the refresh rate. While generating
+        /// under vertical sync the base rate cannot exceed half the refresh rate, so only ceilings up to `0.5` can trip.
+        float maximumBaseRate;
+        /// How far inside both thresholds, as a fraction of the refresh rate, the base rate must be to turn frame
+        /// generation back on.
+        float hysteresis;
+        /// How long, in milliseconds, a change must stay warranted before it is made.
+        float holdTime;
+    };
+
+    struct State {
+        /// Whether the governor currently lets frame generation run.
+        bool active;
+        /// The smoothed rate at which the application presents, in frames per second.
+        float baseRate;
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// The weight of each new interval in the smoothed interval.
+    static constexpr double Smoothing{0.1};
+    /// Longer intervals are stalls (loading, a minimized window) rather than a frame rate, and restart the measurement.
+    static constexpr double MaximumInterval{1000.0};
+
+    Settings          settings{false, 60.0F, 0.5F, 0.95F, 0.05F, 500.0F};
+    Clock::time_point last{};
+    Clock::time_point pendingSince{};
+    double            interval{};
+    bool              started{false};
+    bool              pending{false};
+    std::atomic<bool> active{true};
+    mutable std::mutex mutex;
+
+public:
+    void configure(const Settings& newSettings);
+    /// Records an application present and, once enough of them agree, changes the decision.
+    void record();
+    /// Forgets the measured rate, for when presents are about to go to a new swapchain.
+    void reset();
+    /// Whether to generate a frame this frame when the application asks for `enable`.
+    [[nodiscard]] bool decide(bool enable) const;
+    [[nodiscard]] State state() const;
+};
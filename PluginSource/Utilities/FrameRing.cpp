@@ -0,0 +1,36 @@
+#include "FrameRing.hpp"
+
+#include <memory>
+#include <new>
+
+FrameRing::Header* FrameRing::header(const uint32_t slot) const {
+    return std::launder(reinterpret_cast<Header*>(storage + static_cast<size_t>(slot) * stride));
+}
+
+FrameRing::FrameRing(const size_t size, const uint32_t slots) : stride(sizeof(Header) + (size + CacheLine - 1U) / CacheLine * CacheLine), slots(std::max(slots, MinSlots)) {
+    storage = static_cast<std::byte*>(::operator new(stride * this->slots, std::align_val_t{CacheLine}));
+    for (uint32_t slot{}; slot < this->slots; ++slot) {
+        Header* created = std::construct_at(reinterpret_cast<Header*>(storage + static_cast<size_t>(slot) * stride));
+        created->size   = size;
+    }
+}
+
+FrameRing::~FrameRing() {
+    for (uint32_t slot{}; slot < slots; ++slot) std::destroy_at(header(slot));
+    ::operator delete(storage, std::align_val_t{CacheLine});
+}
+
+void* FrameRing::begin() {
+    writing = header(cursor++ % slots);
+    writing->sequence.fetch_add(1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    writing->publish = ++published;
+    return reinterpret_cast<std::byte*>(writing) + sizeof(Header);
+}
+
+uint32_t FrameRing::end() {
+    if (writing == nullptr) return published;
+    writing->sequence.fetch_add(1U, std::memory_order_release);
+    writing = nullptr;
+    return published;
+}
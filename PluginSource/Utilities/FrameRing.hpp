@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// A small ring of cache-line-aligned slots that carries per-frame constants from the game thread to the render thread.
+/// The game thread fills a slot between `begin` and `end`, then hands the slot's address and the publish number that
+/// `end` returned to `IssuePluginEventAndData`. Each slot is guarded by its own sequence counter (odd while being
+/// written), so the render thread never reads a half-written slot, even if it lags far enough behind for the game thread
+/// to wrap around onto it. When that happens the slot holds a later publish than the event that reads it was issued
+/// for, which `read` reports so the event can be skipped. Publishes are counted per ring rather than per engine frame, so
+/// a camera that renders several times in one frame gets a slot for each. Size the ring to cover the render thread's
+/// lag so that lapping stays the exception.
+class FrameRing {
+public:
+    static constexpr uint32_t MinSlots{2U};
+    static constexpr size_t   CacheLine{64U};
+
+private:
+    struct alignas(CacheLine) Header {
+        std::atomic<uint64_t> sequence{0};
+        uint32_t              publish{0};
+        size_t                size{0};
+    };
+
+    std::byte* storage;
+    size_t     stride;
+    uint32_t   slots;
+    uint32_t   cursor{0};
+    /// The number of the last publish. Wraps around, which is harmless as `read` only compares for equality.
+    uint32_t   published{0};
+    Header*    writing{nullptr};
+
+    [[nodiscard]] Header* header(uint32_t slot) const;
+
+public:
+    FrameRing(size_t size, uint32_t slots);
+    FrameRing(const FrameRing&)            = delete;
+    FrameRing(FrameRing&&)                 = delete;
+    FrameRing& operator=(const FrameRing&) = delete;
+    FrameRing& operator=(FrameRing&&)      = delete;
+    ~FrameRing();
+
+    /// Claims the next slot and returns its payload. Game thread only.
+    void* begin();
+    /// Publishes the slot claimed by the last call to `begin` and returns its publish number. Game thread only.
+    uint32_t end();
+
+    /// Copies the payload published at `slot` into `out`. Returns false if the slot no longer holds `publish`; the game
+    /// thread lapped the render thread and the data the event was issued for is gone. Render thread only.
+    template<typename T>
+    [[nodiscard]] static bool read(const void* slot, const uint32_t publish, T& out) {
+        const auto* header = reinterpret_cast<const Header*>(static_cast<const std::byte*>(slot) - sizeof(Header));
+        uint64_t    sequence{};
+        uint32_t    found{};
+        do {
+            while (((sequence = header->sequence.load(std::memory_order_acquire)) & 1U) != 0U) {}
+            found = header->publish;
+            std::memcpy(&out, slot, std::min(sizeof(T), header->size));
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while (header->sequence.load(std::memory_order_relaxed) != sequence);
+        return found == publish;
+    }
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+/// A fixed-capacity map from API handles (`HWND`, `VkSurfaceKHR`, `VkSwapchainKHR`, ...) to small values, stored inline
+/// in one open-addressed table. Lookups hash the handle and probe linearly, so the common case touches a single cache
+/// line and nothing is ever allocated. The null handle marks an empty slot and cannot be used as a key. Erasing shifts
+/// the rest of the probe run back instead of leaving tombstones, so the table never degrades however often swapchains
+/// are recreated.
+template<typename Key, typename Value, uint32_t Capacity = 32U>
+class HandleMap {
+    static_assert(std::has_single_bit(Capacity), "The capacity must be a power of two.");
+
+    struct Entry {
+        Key   key{};
+        Value value{};
+    };
+
+    std::array<Entry, Capacity> entries{};
+    uint32_t                    count{};
+
+    static uint64_t bits(const Key key) {
+        if constexpr (std::is_pointer_v<Key>) return reinterpret_cast<uintptr_t>(key);
+        else return static_cast<uint64_t>(key);
+    }
+
+    /// Fibonacci hashing; handles are usually aligned pointers whose low bits carry no information.
+    static uint32_t home(const Key key) { return static_cast<uint32_t>((bits(key) * 0x9E3779B97F4A7C15ULL) >> (64U - std::countr_zero(Capacity))) & (Capacity - 1U); }
+
+    [[nodiscard]] uint32_t locate(const Key key) const {
+        if (bits(key) == 0U) return Capacity;
+        for (uint32_t probe{}, slot{home(key)}; probe < Capacity; ++probe, slot = (slot + 1U) & (Capacity - 1U)) {
+            if (entries[slot].key == key) return slot;
+            if (bits(entries[slot].key) == 0U) return Capacity;
+        }
+        return Capacity;
+    }
+
+    void eraseAt(uint32_t slot) {
+        entries[slot] = Entry{};
+        --count;
+        for (uint32_t next{(slot + 1U) & (Capacity - 1U)}; bits(entries[next].key) != 0U; next = (next + 1U) & (Capacity - 1U)) {
+            // Move the entry back into the hole unless its home slot lies cyclically in (slot, next].
+            const uint32_t target = home(entries[next].key);
+            if (((next - target) & (Capacity - 1U)) < ((next - slot) & (Capacity - 1U))) continue;
+            entries[slot] = entries[next];
+            entries[next] = Entry{};
+            slot          = next;
+        }
+    }
+
+public:
+    static constexpr uint32_t capacity() { return Capacity; }
+    [[nodiscard]] uint32_t    size() const { return count; }
+
+    [[nodiscard]] Value* find(const Key key) {
+        const uint32_t slot = locate(key);
+        return slot == Capacity ? nullptr : &entries[slot].value;
+    }
+
+    [[nodiscard]] const Value* find(const Key key) const {
+        const uint32_t slot = locate(key);
+        return slot == Capacity ? nullptr : &entries[slot].value;
+    }
+
+    /// Returns the value stored for `key`, inserting a value-initialized one if there is none. Returns `nullptr` if the
+    /// key is the null handle or the table is full.
+    Value* insert(const Key key) {
+        if (bits(key) == 0U) return nullptr;
+        if (Value* value = find(key); value != nullptr) return value;
+        if (count == Capacity) return nullptr;
+        uint32_t slot{home(key)};
+        while (bits(entries[slot].key) != 0U) slot = (slot + 1U) & (Capacity - 1U);
+        entries[slot].key   = key;
+        entries[slot].value = Value{};
+        ++count;
+        return &entries[slot].value;
+    }
+
+    void erase(const Key key) {
+        if (const uint32_t slot = locate(key); slot != Capacity) eraseAt(slot);
+    }
+
+    /// Erases every entry for which `predicate(key, value)` holds.
+    template<typename Predicate> void eraseIf(Predicate&& predicate) {
+        for (uint32_t slot{}; slot < Capacity;) {
+            // Erasing may shift a later entry into this slot, so only advance once the slot holds a keeper.
+            if (bits(entries[slot].key) != 0U && predicate(entries[slot].key, entries[slot].value)) eraseAt(slot);
+            else ++slot;
+        }
+    }
+};
@@ -0,0 +1,35 @@
+#include "JitterSequence.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+constexpr float halton(uint32_t index, const uint32_t base) {
+    float result{};
+    float fraction{1.0F / static_cast<float>(base)};
+    for (; index > 0U; index /= base, fraction /= static_cast<float>(base)) result += static_cast<float>(index % base) * fraction;
+    return result;
+}
+
+/// Offsets from the pixel center. Index 0 of the Halton sequence is skipped, as it sits on the pixel corner.
+constexpr std::array<JitterSequence::Offset, JitterSequence::MaxPhaseCount> Table = [] {
+    std::array<JitterSequence::Offset, JitterSequence::MaxPhaseCount> table{};
+    for (uint32_t index{}; index < JitterSequence::MaxPhaseCount; ++index) table.at(index) = {halton(index + 1U, 2U) - 0.5F, halton(index + 1U, 3U) - 0.5F};
+    return table;
+}();
+}  // namespace
+
+uint32_t JitterSequence::phaseCount(const uint32_t renderWidth, const uint32_t displayWidth) {
+    if (renderWidth == 0U) return BasePhaseCount;
+    const float ratio = static_cast<float>(displayWidth) / static_cast<float>(renderWidth);
+    return std::clamp(static_cast<uint32_t>(std::ceil(static_cast<float>(BasePhaseCount) * ratio * ratio)), 1U, MaxPhaseCount);
+}
+
+JitterSequence::Offset JitterSequence::offset(const uint32_t index, const uint32_t phaseCount) {
+    return Table.at(index % std::clamp(phaseCount, 1U, MaxPhaseCount));
+}
+
+JitterSequence::Offset JitterSequence::next(const uint32_t phaseCount) {
+    return offset(++index, phaseCount);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+/// The sub-pixel offsets that a temporal upscaler's camera is jittered by, from the Halton (2, 3) sequence. The sequence
+/// restarts after a number of phases that grows with the square of the upscaling ratio, so that every display pixel is
+/// covered by a few samples before it repeats. Every phase count reads a prefix of the same table, which is built at
+/// compile time.
+class JitterSequence {
+public:
+    struct Offset {
+        float x;
+        float y;
+    };
+
+    /// The longest sequence that is used, reached at an upscaling ratio of about 5.7.
+    static constexpr uint32_t MaxPhaseCount{256U};
+    /// The phase count at an upscaling ratio of 1.
+    static constexpr uint32_t BasePhaseCount{8U};
+
+private:
+    uint32_t index{};
+
+public:
+    /// `8 * (displayWidth / renderWidth)^2`, the phase count that FSR, DLSS, and XeSS all recommend.
+    static uint32_t phaseCount(uint32_t renderWidth, uint32_t displayWidth);
+    /// The offset, in render pixels, of phase `index` of a sequence `phaseCount` phases long.
+    static Offset offset(uint32_t index, uint32_t phaseCount);
+
+    /// Moves to the next phase of a sequence `phaseCount` phases long and returns its offset. The position is kept when
+    /// the phase count changes, so a changing render resolution does not restart the sequence.
+    Offset next(uint32_t phaseCount);
+};
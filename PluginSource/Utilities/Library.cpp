@@ -0,0 +1,50 @@
+#include "Library.hpp"
+
+#ifdef _WIN32
+#    define NOMINMAX
+#    include <Windows.h>
+#else
+#    include <dlfcn.h>
+#endif
+
+std::filesystem::path Library::fileName(const std::string_view name) {
+#ifdef _WIN32
+    return std::filesystem::path(name).concat(".dll");
+#else
+    if (name.starts_with("lib")) return std::filesystem::path(name).concat(".so");
+    return std::filesystem::path("lib").concat(name).concat(".so");
+#endif
+}
+
+bool Library::load(const std::filesystem::path& path) {
+    unload();
+#ifdef _WIN32
+    handle = LoadLibraryW(path.c_str());
+#else
+    handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+    return handle != nullptr;
+}
+
+void Library::unload() {
+    if (handle == nullptr) return;
+#ifdef _WIN32
+    FreeLibrary(static_cast<HMODULE>(handle));
+#else
+    dlclose(handle);
+#endif
+    handle = nullptr;
+}
+
+bool Library::isLoaded() const {
+    return handle != nullptr;
+}
+
+void* Library::getSymbol(const char* name) const {
+    if (handle == nullptr) return nullptr;
+#ifdef _WIN32
+    return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(handle), name));
+#else
+    return dlsym(handle, name);
+#endif
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+
+/// A thin wrapper around the platform's dynamic loader (`LoadLibrary` / `dlopen`).
+/// Symbols are resolved once into a dispatch table: a struct that holds nothing but function pointers, declared in the
+/// same order as the list of names that is used to resolve it.
+class Library {
+    void* handle{nullptr};
+
+public:
+    Library()                          = default;
+    Library(const Library&)            = delete;
+    Library(Library&&)                 = delete;
+    Library& operator=(const Library&) = delete;
+    Library& operator=(Library&&)      = delete;
+    ~Library()                         = default;
+
+    /// Builds the platform specific file name for `name`, i.e. `name.dll` on Windows and `libname.so` elsewhere.
+    /// Names that already carry the `lib` prefix (such as `libxess`) are not prefixed again.
+    static std::filesystem::path fileName(std::string_view name);
+
+    bool                load(const std::filesystem::path& path);
+    void                unload();
+    [[nodiscard]] bool  isLoaded() const;
+    [[nodiscard]] void* getSymbol(const char* name) const;
+
+    template<typename Table, std::size_t N>
+    bool resolve(Table& table, const std::array<const char*, N>& names) const {
+        static_assert(sizeof(Table) == N * sizeof(void*), "Dispatch tables must contain exactly one function pointer per symbol name.");
+        std::array<void*, N> symbols{};
+        bool complete = isLoaded();
+        for (std::size_t i{}; complete && i < N; ++i) complete = (symbols[i] = getSymbol(names[i])) != nullptr;
+        if (!complete) symbols = {};
+        std::memcpy(&table, symbols.data(), sizeof(Table));
+        return complete;
+    }
+};
@@ -0,0 +1,181 @@
+#include "LogQueue.hpp"
+
+#include "Plugin.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace {
+constexpr std::array<std::string_view, LogQueue::CategoryCount> CategoryNames{
+  "the plugin",
+  "DLSS",
+  "FSR",
+  "XeSS",
+  "frame generation",
+};
+}  // namespace
+
+LogQueue::Ring                        LogQueue::ring{};
+std::atomic<LogQueue::Level>          LogQueue::level{Warning};
+std::atomic<uint32_t>                 LogQueue::dropped{0};
+std::thread                           LogQueue::worker{};
+std::mutex                            LogQueue::mutex{};
+std::condition_variable               LogQueue::wake{};
+bool                                  LogQueue::stopping{false};
+LogQueue::Message                     LogQueue::last{};
+bool                                  LogQueue::lastShown{false};
+uint32_t                              LogQueue::repeats{0};
+std::chrono::steady_clock::time_point LogQueue::repeatsSince{};
+std::array<LogQueue::Bucket, LogQueue::CategoryCount> LogQueue::buckets{};
+std::chrono::steady_clock::time_point LogQueue::refilled{};
+
+LogQueue::Ring::Ring() {
+    for (uint32_t i{}; i < Capacity; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool LogQueue::Message::operator==(const Message& other) const {
+    return level == other.level && category == other.category && view() == other.view();
+}
+
+bool LogQueue::pop(Message& message) {
+    Slot& slot = ring.slots[ring.dequeue % Capacity];
+    if (slot.sequence.load(std::memory_order_acquire) != ring.dequeue + 1U) return false;
+    message = slot.message;
+    slot.sequence.store(ring.dequeue + Capacity, std::memory_order_release);
+    ++ring.dequeue;
+    return true;
+}
+
+void LogQueue::drain() {
+    const auto now = std::chrono::steady_clock::now();
+    const float elapsed = std::chrono::duration<float>(now - refilled).count();
+    refilled = now;
+    for (uint32_t category{}; category < CategoryCount; ++category) {
+        Bucket& bucket = buckets[category];
+        bucket.tokens  = std::min(bucket.tokens + elapsed * Rate, Burst);
+        if (bucket.suppressed == 0 || bucket.tokens < 1.0F) continue;
+        write(Warning, "Suppressed " + std::to_string(bucket.suppressed) + " messages from " + std::string(CategoryNames[category]) + ".");
+        bucket.suppressed = 0;
+    }
+
+    Message message;
+    while (pop(message)) {
+        if (message == last) {
+            if (repeats++ == 0) repeatsSince = now;
+            continue;
+        }
+        flushRepeats();
+        last      = message;
+        lastShown = emit(message.level, message.category, message.view());
+    }
+    if (repeats != 0 && now - repeatsSince >= std::chrono::seconds(1)) flushRepeats();
+
+    if (const uint32_t lost = dropped.exchange(0, std::memory_order_relaxed); lost != 0)
+        write(Warning, "Dropped " + std::to_string(lost) + " messages because the log queue was full.");
+}
+
+void LogQueue::flushRepeats() {
+    if (repeats == 0) return;
+    if (lastShown) write(last.level, "The previous message was repeated " + std::to_string(repeats) + " times.");
+    else buckets[last.category].suppressed += repeats;
+    repeats = 0;
+}
+
+bool LogQueue::emit(const Level messageLevel, const Category category, const std::string_view text) {
+    Bucket& bucket = buckets[category];
+    if (bucket.tokens < 1.0F) {
+        ++bucket.suppressed;
+        return false;
+    }
+    bucket.tokens -= 1.0F;
+    write(messageLevel, text);
+    return true;
+}
+
+void LogQueue::write(const Level messageLevel, const std::string_view text) {
+    if (Plugin::Unity::logInterface == nullptr) return;
+    UnityLogType type{kUnityLogTypeLog};
+    switch (messageLevel) {
+        case Error: type = kUnityLogTypeError; break;
+        case Warning: type = kUnityLogTypeWarning; break;
+        case Info:
+        case Verbose: type = kUnityLogTypeLog; break;
+    }
+    // Every string handed to this function is null-terminated: either a `std::string` or a message slot.
+    Plugin::Unity::logInterface->Log(type, text.data(), "Upscaler native library: 'GfxPluginUpscaler.dll'", 0);
+}
+
+LogQueue::Level LogQueue::toLevel(const UnityLogType type) {
+    switch (type) {
+        case kUnityLogTypeError:
+        case kUnityLogTypeAssert:
+        case kUnityLogTypeException: return Error;
+        case kUnityLogTypeWarning: return Warning;
+        case kUnityLogTypeLog: return Info;
+    }
+    return Info;
+}
+
+void LogQueue::setLevel(const Level newLevel) {
+    level.store(newLevel, std::memory_order_relaxed);
+}
+
+LogQueue::Level LogQueue::getLevel() {
+    return level.load(std::memory_order_relaxed);
+}
+
+void LogQueue::push(const Level messageLevel, const Category category, const std::string_view text) {
+    if (!enabled(messageLevel)) return;
+    uint64_t position = ring.enqueue.load(std::memory_order_relaxed);
+    Slot*    slot;
+    while (true) {
+        slot = &ring.slots[position % Capacity];
+        const auto difference = static_cast<int64_t>(slot->sequence.load(std::memory_order_acquire) - position);
+        if (difference == 0) {
+            if (ring.enqueue.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed)) break;
+        } else if (difference < 0) {
+            dropped.fetch_add(1U, std::memory_order_relaxed);
+            return;
+        } else position = ring.enqueue.load(std::memory_order_relaxed);
+    }
+    slot->message.level    = messageLevel;
+    slot->message.category = category;
+    slot->message.length   = static_cast<uint16_t>(std::min<size_t>(text.size(), MaxLength - 1U));
+    std::copy_n(text.data(), slot->message.length, slot->message.text.data());
+    slot->message.text[slot->message.length] = '\0';
+    slot->sequence.store(position + 1U, std::memory_order_release);
+}
+
+void LogQueue::push(const Level messageLevel, const Category category, const std::wstring_view text) {
+    if (!enabled(messageLevel)) return;
+    std::array<char, MaxLength> narrow;
+    const size_t                length = std::min<size_t>(text.size(), MaxLength - 1U);
+    std::ranges::transform(text.substr(0, length), narrow.begin(), [](const wchar_t c) { return c < 0x80 ? static_cast<char>(c) : '?'; });
+    push(messageLevel, category, std::string_view{narrow.data(), length});
+}
+
+void LogQueue::start() {
+    if (worker.joinable()) return;
+    refilled = std::chrono::steady_clock::now();
+    stopping = false;
+    worker   = std::thread([] {
+        while (true) {
+            std::unique_lock lock(mutex);
+            const bool       stop = wake.wait_for(lock, Interval, [] { return stopping; });
+            lock.unlock();
+            drain();
+            if (stop) return;
+        }
+    });
+}
+
+void LogQueue::stop() {
+    if (!worker.joinable()) return;
+    {
+        const std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+    flushRepeats();
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <IUnityLog.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+/// Carries log messages from whichever thread produces them to a worker thread that hands them to Unity. Producers copy
+/// the message into a preallocated slot of a bounded lock-free queue and return; they never allocate, lock, or wait on
+/// Unity. The worker collapses runs of identical messages into a repeat count and limits how many messages each
+/// category may log per second, so that a failure that repeats every frame cannot flood the console.
+class LogQueue {
+public:
+    enum Level : uint8_t {
+        Error,
+        Warning,
+        Info,
+        Verbose,
+    };
+
+    enum Category : uint8_t {
+        Plugin,
+        DeepLearningSuperSampling,
+        FidelityFXSuperResolution,
+        XeSuperSampling,
+        FrameGeneration,
+        CategoryCount
+    };
+
+private:
+    static constexpr uint32_t Capacity{256U};
+    static constexpr uint32_t MaxLength{512U};
+    /// How often the worker drains the queue.
+    static constexpr std::chrono::milliseconds Interval{50};
+    /// Each category may log up to `Burst` messages at once, refilled at `Rate` messages per second.
+    static constexpr float Burst{10.0F};
+    static constexpr float Rate{2.0F};
+
+    struct Message {
+        Level                       level;
+        Category                    category;
+        uint16_t                    length;
+        std::array<char, MaxLength> text;
+
+        [[nodiscard]] std::string_view view() const { return {text.data(), length}; }
+        bool operator==(const Message& other) const;
+    };
+
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        Message               message;
+    };
+
+    /// A bounded multi-producer queue after Dmitry Vyukov's design: each slot's sequence tells producers whether the
+    /// slot is free for their position and tells the consumer whether it has been filled.
+    struct Ring {
+        std::array<Slot, Capacity> slots;
+        std::atomic<uint64_t>      enqueue{0};
+        uint64_t                   dequeue{0};
+
+        Ring();
+    };
+
+    struct Bucket {
+        float    tokens{Burst};
+        uint32_t suppressed{};
+    };
+
+    static Ring                    ring;
+    static std::atomic<Level>      level;
+    static std::atomic<uint32_t>   dropped;
+    static std::thread             worker;
+    static std::mutex              mutex;
+    static std::condition_variable wake;
+    static bool                    stopping;
+
+    /// Worker-thread state.
+    static Message                               last;
+    static bool                                  lastShown;
+    static uint32_t                              repeats;
+    static std::chrono::steady_clock::time_point repeatsSince;
+    static std::array<Bucket, CategoryCount>     buckets;
+    static std::chrono::steady_clock::time_point refilled;
+
+    static bool pop(Message& message);
+    static void drain();
+    static void flushRepeats();
+    /// Logs `text` unless its category has run out of tokens. Returns whether it was logged.
+    static bool emit(Level messageLevel, Category category, std::string_view text);
+    static void write(Level messageLevel, std::string_view text);
+
+public:
+    LogQueue()                           = delete;
+    LogQueue(const LogQueue&)            = delete;
+    LogQueue(LogQueue&&)                 = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+    LogQueue& operator=(LogQueue&&)      = delete;
+    ~LogQueue()                          = delete;
+
+    static Level toLevel(UnityLogType type);
+
+    /// Whether a message at `messageLevel` would be logged. Lets callers skip formatting a message that would be dropped.
+    static bool enabled(const Level messageLevel) { return messageLevel <= level.load(std::memory_order_relaxed); }
+    static void setLevel(Level newLevel);
+    static Level getLevel();
+
+    /// Queues `text`, truncated to `MaxLength` characters. Messages are dropped and counted if the queue is full.
+    static void push(Level messageLevel, Category category, std::string_view text);
+    /// Queues a wide string, replacing every character outside of ASCII with '?'.
+    static void push(Level messageLevel, Category category, std::wstring_view text);
+
+    /// Starts the worker. Messages pushed before this wait in the queue.
+    static void start();
+    /// Logs everything still queued and stops the worker.
+    static void stop();
+};
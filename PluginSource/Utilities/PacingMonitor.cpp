@@ -0,0 +1,69 @@
+#include "PacingMonitor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void PacingMonitor::expect(const uint32_t frames) {
+    expected.store(frames, std::memory_order_relaxed);
+}
+
+void PacingMonitor::record(const uint64_t presentCount) {
+    const Clock::time_point now = Clock::now();
+    const std::lock_guard   lock(mutex);
+    // A count that went backwards belongs to a new swapchain; start measuring from it.
+    if (!started || presentCount < lastCount) {
+        if (!started) first = now;
+        started   = true;
+        last      = now;
+        lastCount = presentCount;
+        return;
+    }
+    const double   interval = std::chrono::duration<double, std::milli>(now - last).count();
+    const uint64_t frames   = presentCount - lastCount;
+    const uint64_t wanted   = expected.load(std::memory_order_relaxed);
+    ++presents;
+    displayed += frames;
+    if (frames < wanted) dropped += wanted - frames;
+    sum += interval;
+    sumOfSquares += interval * interval;
+    ++histogram.at(std::min(static_cast<uint32_t>(interval / BinWidth), Bins - 1U));
+    last      = now;
+    lastCount = presentCount;
+}
+
+void PacingMonitor::reset() {
+    const std::lock_guard lock(mutex);
+    started      = false;
+    presents     = 0U;
+    displayed    = 0U;
+    dropped      = 0U;
+    sum          = 0.0;
+    sumOfSquares = 0.0;
+    histogram    = {};
+}
+
+PacingMonitor::Report PacingMonitor::report() const {
+    const std::lock_guard lock(mutex);
+    if (presents == 0U) return {};
+    Report result{};
+    result.presents         = presents;
+    result.displayed        = displayed;
+    result.droppedGenerated = dropped;
+    result.histogram        = histogram;
+    const double mean       = sum / static_cast<double>(presents);
+    result.meanInterval     = static_cast<float>(mean);
+    result.jitter           = static_cast<float>(std::sqrt(std::max(sumOfSquares / static_cast<double>(presents) - mean * mean, 0.0)));
+    const double seconds    = std::chrono::duration<double>(last - first).count();
+    result.outputRate       = seconds > 0.0 ? static_cast<float>(static_cast<double>(displayed) / seconds) : 0.0F;
+    // Nearest-rank percentiles, reported at the middle of the bin they fall in.
+    const auto percentile = [&](const uint64_t percent) {
+        const uint64_t rank = (presents * percent + 99U) / 100U;
+        uint64_t       seen{};
+        for (uint32_t bin{}; bin < Bins; ++bin)
+            if ((seen += histogram.at(bin)) >= rank) return (static_cast<float>(bin) + 0.5F) * BinWidth;
+        return static_cast<float>(Bins) * BinWidth;
+    };
+    result.p50Interval = percentile(50U);
+    result.p99Interval = percentile(99U);
+    return result;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+/// Watches what frame generation actually puts on screen. The present hook records the CPU time of every application
+/// present together with the swapchain's running present count, which includes the interpolated frames. From those it
+/// derives a histogram of the intervals between application presents, their jitter, how many generated frames were
+/// expected but never presented, and the rate at which frames reached the display.
+class PacingMonitor {
+public:
+    static constexpr uint32_t Bins{64U};
+    /// The width of one histogram bin. The last bin also collects every longer interval.
+    static constexpr float BinWidth{0.5F};
+
+    struct Report {
+        /// Application presents recorded.
+        uint64_t presents;
+        /// Frames the swapchain presented, real and interpolated.
+        uint64_t displayed;
+        /// Interpolated frames that were expected but not presented.
+        uint64_t droppedGenerated;
+        float    meanInterval;
+        /// The standard deviation of the interval between application presents.
+        float jitter;
+        float p50Interval;
+        float p99Interval;
+        /// Frames presented per second.
+        float                      outputRate;
+        std::array<uint32_t, Bins> histogram;
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<uint32_t> expected{1U};
+    Clock::time_point     first{};
+    Clock::time_point     last{};
+    uint64_t              lastCount{};
+    bool                  started{false};
+    uint64_t              presents{};
+    uint64_t              displayed{};
+    uint64_t              dropped{};
+    double                sum{};
+    double                sumOfSquares{};
+    std::array<uint32_t, Bins> histogram{};
+    mutable std::mutex         mutex;
+
+public:
+    /// Sets how many frames each application present should produce: two while interpolating, otherwise one.
+    void expect(uint32_t frames);
+    /// Records an application present after which the swapchain reports `presentCount` presents since its creation.
+    void record(uint64_t presentCount);
+    void reset();
+    /// Everything recorded since the last `reset`; all zeros if nothing was.
+    [[nodiscard]] Report report() const;
+};
@@ -0,0 +1,48 @@
+#include "PipelineCache.hpp"
+
+#include <fstream>
+#include <system_error>
+
+std::filesystem::path PipelineCache::directory{};
+std::thread           PipelineCache::writer{};
+
+std::filesystem::path PipelineCache::fileName(const std::string_view key) {
+    return directory / std::filesystem::path("UpscalerPipelineCache-").concat(key).concat(".bin");
+}
+
+void PipelineCache::setDirectory(const std::filesystem::path& path) {
+    wait();
+    directory = path;
+}
+
+std::vector<char> PipelineCache::read(const std::string_view key) {
+    if (directory.empty()) return {};
+    wait();
+    std::ifstream file(fileName(key), std::ios::binary | std::ios::ate);
+    if (!file) return {};
+    std::vector<char> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) return {};
+    return data;
+}
+
+void PipelineCache::write(const std::string& key, std::vector<char>&& data) {
+    if (directory.empty() || data.empty()) return;
+    wait();
+    writer = std::thread([path = fileName(key), data = std::move(data)] {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+        // Write next to the destination and rename over it, so that a crash mid-write never leaves a truncated blob.
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.write(data.data(), static_cast<std::streamsize>(data.size()))) return;
+        }
+        std::filesystem::rename(temporary, path, error);
+    });
+}
+
+void PipelineCache::wait() {
+    if (writer.joinable()) writer.join();
+}
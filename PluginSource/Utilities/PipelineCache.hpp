@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// On-disk storage for the graphics API pipeline caches that the plugin owns (a `VkPipelineCache` on Vulkan and an
+/// `ID3D12PipelineLibrary` on DX12). Blobs are stored per key, where the key identifies the device and driver that
+/// produced them, so a driver update or a different GPU never gets handed a stale blob. Writes happen on a background
+/// thread so that device shutdown does not wait on the disk.
+class PipelineCache {
+    static std::filesystem::path directory;
+    static std::thread           writer;
+
+    static std::filesystem::path fileName(std::string_view key);
+
+public:
+    PipelineCache()                                = delete;
+    PipelineCache(const PipelineCache&)            = delete;
+    PipelineCache(PipelineCache&&)                 = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+    PipelineCache& operator=(PipelineCache&&)      = delete;
+    ~PipelineCache()                               = delete;
+
+    /// Builds a key by hex-encoding each of `parts`, i.e. the device UUID and driver version.
+    template<typename... Parts>
+    static std::string key(const Parts&... parts) {
+        constexpr std::string_view digits{"0123456789abcdef"};
+        std::string                result;
+        const auto                 append = [&](const auto& part) {
+            if (!result.empty()) result += '-';
+            for (const std::byte byte : std::as_bytes(std::span(&part, 1))) {
+                result += digits[static_cast<uint8_t>(byte) >> 4U];
+                result += digits[static_cast<uint8_t>(byte) & 0xFU];
+            }
+        };
+        (append(parts), ...);
+        return result;
+    }
+
+    /// Sets where blobs are kept. An empty path disables persistence.
+    static void setDirectory(const std::filesystem::path& path);
+
+    /// Returns the blob stored for `key`, or nothing if there is none.
+    static std::vector<char> read(std::string_view key);
+    /// Queues `data` to be stored for `key` on the writer thread.
+    static void write(const std::string& key, std::vector<char>&& data);
+    /// Blocks until the last queued write has finished.
+    static void wait();
+};
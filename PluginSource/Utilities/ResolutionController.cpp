@@ -0,0 +1,85 @@
+#include "ResolutionController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+float ResolutionController::minimumFraction() const {
+    if (maximum.width == 0U || maximum.height == 0U) return 1.0F;
+    return std::min(static_cast<float>(minimum.width) / static_cast<float>(maximum.width) * (static_cast<float>(minimum.height) / static_cast<float>(maximum.height)), 1.0F);
+}
+
+void ResolutionController::apply(const float fraction) {
+    applied                   = fraction;
+    const float scale         = std::sqrt(fraction);
+    current.scale             = scale;
+    current.resolution.width  = std::clamp(static_cast<uint32_t>(std::lround(static_cast<float>(maximum.width) * scale)), minimum.width, maximum.width);
+    current.resolution.height = std::clamp(static_cast<uint32_t>(std::lround(static_cast<float>(maximum.height) * scale)), minimum.height, maximum.height);
+}
+
+ResolutionController::ResolutionController(const uint32_t latency) : latency(std::min(latency, MaxLatency)) {
+    history.fill(1.0F);
+}
+
+void ResolutionController::configure(const Settings& newSettings) {
+    const std::lock_guard lock(mutex);
+    settings              = newSettings;
+    previousError         = 0.0F;
+    previousPreviousError = 0.0F;
+}
+
+void ResolutionController::setBounds(const Resolution newMinimum, const Resolution newMaximum) {
+    const std::lock_guard lock(mutex);
+    if (newMinimum == minimum && newMaximum == maximum) return;
+    minimum = {std::min(newMinimum.width, newMaximum.width), std::min(newMinimum.height, newMaximum.height)};
+    maximum = newMaximum;
+    target  = 1.0F;
+    history.fill(1.0F);
+    previousError         = 0.0F;
+    previousPreviousError = 0.0F;
+    apply(1.0F);
+}
+
+ResolutionController::Resolution ResolutionController::update(const float frameTime) {
+    const std::lock_guard lock(mutex);
+    if (frameTime > 0.0F && settings.targetFrameTime > 0.0F) {
+        const float then      = history.at((frame + history.size() - latency) % history.size());
+        const float predicted = frameTime * applied / std::max(then, 1e-3F);
+        const float deviation = (settings.targetFrameTime - predicted) / settings.targetFrameTime;
+        const float error     = std::abs(deviation) < settings.tolerance ? 0.0F : deviation;
+        // Velocity form: each gain contributes a change to the fraction rather than the fraction itself. The change is
+        // relative, so that the same error moves a small render size as quickly as a large one.
+        const float change    = settings.proportional * (error - previousError) + settings.integral * error + settings.derivative * (error - 2.0F * previousError + previousPreviousError);
+        const float lowest    = minimumFraction();
+        target                = std::clamp(target * std::max(1.0F + change, 0.5F), lowest, 1.0F);
+        previousPreviousError = previousError;
+        previousError         = error;
+        if (std::abs(std::sqrt(target) - std::sqrt(applied)) >= settings.step || (target != applied && (target == 1.0F || target == lowest))) apply(target);
+        current.frameTime          = frameTime;
+        current.predictedFrameTime = predicted;
+        current.error              = error;
+    }
+    history.at(++frame % history.size()) = applied;
+    return current.resolution;
+}
+
+ResolutionController::State ResolutionController::state() const {
+    const std::lock_guard lock(mutex);
+    return current;
+}
+
+uint32_t ResolutionController::replay(const std::span<const float> trace, const Settings& settings, const Resolution minimum, const Resolution maximum, const uint32_t latency, const float fixedShare, const std::span<State> states) {
+    ResolutionController controller{latency};
+    controller.configure(settings);
+    controller.setBounds(minimum, maximum);
+    std::array<float, MaxLatency + 1U> measured{};
+    uint32_t                           overruns{};
+    for (size_t index{}; index < trace.size(); ++index) {
+        // The GPU renders this frame at the fraction applied so far; its time only reaches the controller later.
+        const float time = trace[index] * (fixedShare + (1.0F - fixedShare) * controller.applied);
+        if (time > settings.targetFrameTime) ++overruns;
+        measured.at(index % measured.size()) = time;
+        controller.update(index >= controller.latency ? measured.at((index - controller.latency) % measured.size()) : 0.0F);
+        if (index < states.size()) states[index] = controller.state();
+    }
+    return overruns;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+/// Picks the render resolution that brings the GPU frame time to a budget, between the minimum and maximum input
+/// resolutions of the active upscaler. The controller works on the fraction of the maximum pixel count, which keeps its
+/// gains independent of the output resolution, and moves it with a velocity-form PID loop that cannot wind up while
+/// the fraction is pinned to a bound. Frame times arrive `latency` frames after the frame that they measure, so each
+/// one is first rescaled by how much the pixel count has changed since (a predictor that assumes GPU time scales with
+/// pixels), which keeps the loop from reacting twice to the same overrun.
+class ResolutionController {
+public:
+    static constexpr uint32_t MaxLatency{8U};
+
+    struct Resolution {
+        uint32_t width;
+        uint32_t height;
+
+        bool operator==(const Resolution& other) const = default;
+    };
+
+    struct Settings {
+        /// The GPU frame time to converge on, in milliseconds.
+        float targetFrameTime;
+        float proportional;
+        float integral;
+        float derivative;
+        /// The smallest change of the per-axis scale that is applied, so that the render size does not wander by a few
+        /// pixels every frame.
+        float step;
+        /// Errors smaller than this fraction of the budget are treated as none, so that noise alone does not steer.
+        float tolerance;
+    };
+
+    struct State {
+        Resolution resolution;
+        /// The per-axis scale of `resolution` relative to the maximum input resolution.
+        float scale;
+        /// The most recent GPU frame time, in milliseconds.
+        float frameTime;
+        /// `frameTime` as predicted for the pixel count that is now being rendered.
+        float predictedFrameTime;
+        /// The relative distance from the budget: positive with time to spare, negative when over budget.
+        float error;
+    };
+
+private:
+    Settings   settings{16.6F, 0.1F, 0.3F, 0.05F, 0.02F, 0.04F};
+    Resolution minimum{};
+    Resolution maximum{};
+    uint32_t   latency;
+    /// The pixel fraction that each of the most recent frames was rendered at, indexed by frame modulo the ring size.
+    std::array<float, MaxLatency + 1U> history{};
+    uint64_t                           frame{};
+    /// The pixel fraction that the loop steers, and the one that was last applied after quantization.
+    float              target{1.0F};
+    float              applied{1.0F};
+    float              previousError{};
+    float              previousPreviousError{};
+    State              current{};
+    mutable std::mutex mutex;
+
+    [[nodiscard]] float minimumFraction() const;
+    void                apply(float fraction);
+
+public:
+    /// `latency` is how many frames old a frame time is when it is handed to `update`, at most `MaxLatency`.
+    explicit ResolutionController(uint32_t latency);
+
+    void configure(const Settings& newSettings);
+    /// Sets the range that resolutions are picked from. Starts from the maximum when the range changes.
+    void setBounds(Resolution newMinimum, Resolution newMaximum);
+    /// Takes the GPU time of the frame `latency` frames ago and returns the resolution to render the next frame at.
+    Resolution update(float frameTime);
+    [[nodiscard]] State state() const;
+
+    /// Runs a fresh controller over `trace`, GPU frame times recorded at the maximum resolution, and writes the state
+    /// after every frame to `states`. The simulated GPU spends `fixedShare` of each traced time regardless of resolution
+    /// and scales the rest with the pixel count, and reports it `latency` frames late. Returns how many frames went over
+    /// budget.
+    static uint32_t replay(std::span<const float> trace, const Settings& settings, Resolution minimum, Resolution maximum, uint32_t latency, float fixedShare, std::span<State> states);
+};
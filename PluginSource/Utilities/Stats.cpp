@@ -0,0 +1,20 @@
+#include "Stats.hpp"
+
+std::array<std::atomic<uint64_t>, Stats::CounterCount> Stats::counters{};
+Stats::Snapshot                                        Stats::previous{};
+std::mutex                                             Stats::mutex{};
+
+Stats::Snapshot Stats::snapshot() {
+    Snapshot result{};
+    for (uint32_t counter{}; counter < CounterCount; ++counter) result.counters[counter] = counters[counter].load(std::memory_order_relaxed);
+    return result;
+}
+
+Stats::Snapshot Stats::delta() {
+    const Snapshot        current = snapshot();
+    const std::lock_guard lock(mutex);
+    Snapshot              result{};
+    for (uint32_t counter{}; counter < CounterCount; ++counter) result.counters[counter] = current.counters[counter] - previous.counters[counter];
+    previous = current;
+    return result;
+}
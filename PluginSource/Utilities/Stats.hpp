@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+/// Counts the operations that are expensive when they happen often: context and swapchain churn, history resets, image
+/// rebinds, swapchains forced out of date, and failed dispatches. It also counts the frame generation governor's
+/// decisions and the preprocessing dispatches that stand in for Unity's copies. Counters only ever grow and are updated
+/// with relaxed atomics from whichever thread performs the operation, so counting costs next to nothing on the render
+/// thread.
+class Stats {
+public:
+    enum Counter : uint8_t {
+        DeepLearningSuperSamplingContextCreations,
+        FidelityFXSuperResolutionContextCreations,
+        XeSuperSamplingContextCreations,
+        DeepLearningSuperSamplingContextDestructions,
+        FidelityFXSuperResolutionContextDestructions,
+        XeSuperSamplingContextDestructions,
+        HistoryResets,
+        ImageRebinds,
+        ForcedOutOfDateAcquires,
+        ForcedOutOfDatePresents,
+        FrameGenerationSwapchainCreations,
+        FailedDispatches,
+        FrameGenerationGovernorEnables,
+        FrameGenerationGovernorDisables,
+        PreprocessDispatches,
+        CounterCount
+    };
+
+    /// The value of every counter, in the order of `Counter`.
+    struct Snapshot {
+        std::array<uint64_t, CounterCount> counters;
+    };
+
+private:
+    static std::array<std::atomic<uint64_t>, CounterCount> counters;
+    static Snapshot                                        previous;
+    static std::mutex                                      mutex;
+
+public:
+    Stats()                        = delete;
+    Stats(const Stats&)            = delete;
+    Stats(Stats&&)                 = delete;
+    Stats& operator=(const Stats&) = delete;
+    Stats& operator=(Stats&&)      = delete;
+    ~Stats()                       = delete;
+
+    static void add(const Counter counter, const uint64_t count = 1U) { counters[counter].fetch_add(count, std::memory_order_relaxed); }
+
+    /// Returns the counters accumulated since the plugin was loaded.
+    static Snapshot snapshot();
+    /// Returns how much each counter has grown since the previous call to `delta`, or since the plugin was loaded.
+    static Snapshot delta();
+};
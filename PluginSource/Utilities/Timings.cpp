@@ -0,0 +1,40 @@
+#include "Timings.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <span>
+
+void Timings::add(const float milliseconds) {
+    const std::lock_guard lock(mutex);
+    samples.at(next) = milliseconds;
+    next             = (next + 1U) % Window;
+    count            = std::min(count + 1U, Window);
+    ++total;
+}
+
+uint64_t Timings::latest(float& milliseconds, const uint64_t seen) const {
+    const std::lock_guard lock(mutex);
+    if (total != seen) milliseconds = samples.at((next + Window - 1U) % Window);
+    return total;
+}
+
+Timings::Summary Timings::summarize() const {
+    std::array<float, Window> sorted{};
+    uint32_t                  size{};
+    {
+        const std::lock_guard lock(mutex);
+        sorted = samples;
+        size   = count;
+    }
+    if (size == 0U) return {};
+    const std::span window(sorted.data(), size);
+    // Nearest-rank percentile: the smallest sample that at least 99% of the window does not exceed.
+    const auto p99 = window.begin() + ((size * 99U + 99U) / 100U - 1U);
+    std::ranges::nth_element(window, p99);
+    return {
+        .minimum = std::ranges::min(window),
+        .average = std::accumulate(window.begin(), window.end(), 0.0F) / static_cast<float>(size),
+        .p99     = *p99,
+        .samples = size
+    };
+}
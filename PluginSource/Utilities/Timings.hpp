@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+/// Rolling statistics over the most recent GPU times of one context. The render thread adds a sample whenever one of
+/// the context's timestamp queries resolves; any thread may summarize the window.
+class Timings {
+public:
+    static constexpr uint32_t Window{256U};
+
+    struct Summary {
+        float    minimum;
+        float    average;
+        float    p99;
+        uint32_t samples;
+    };
+
+private:
+    std::array<float, Window> samples{};
+    uint32_t                  next{};
+    uint32_t                  count{};
+    uint64_t                  total{};
+    mutable std::mutex        mutex;
+
+public:
+    /// Records one dispatch that took `milliseconds` of GPU time, replacing the oldest sample once the window is full.
+    void add(float milliseconds);
+    /// Returns the minimum, mean, and 99th percentile of the window in milliseconds; all zeros if there are no samples.
+    [[nodiscard]] Summary summarize() const;
+    /// Stores the most recent sample in `milliseconds` if any sample was added since the call that returned `seen`.
+    /// Returns the number of samples added so far.
+    uint64_t latest(float& milliseconds, uint64_t seen) const;
+};
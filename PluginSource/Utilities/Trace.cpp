@@ -0,0 +1,44 @@
+#ifdef ENABLE_TRACING
+#    include "Trace.hpp"
+
+#    include <algorithm>
+#    include <fstream>
+#    include <iomanip>
+
+std::vector<std::unique_ptr<Trace::Buffer>> Trace::buffers{};
+std::mutex                                  Trace::mutex{};
+thread_local Trace::Buffer*                 Trace::local{nullptr};
+
+Trace::Buffer* Trace::create() {
+    // Buffers outlive their threads so that `dump` can still read them; there is one per thread that ever traced.
+    const std::lock_guard lock(mutex);
+    local = buffers.emplace_back(std::make_unique<Buffer>()).get();
+    return local;
+}
+
+bool Trace::dump(const std::filesystem::path& path) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) return false;
+    file << std::fixed << std::setprecision(3) << R"({"displayTimeUnit":"ns","traceEvents":[)";
+    bool first = true;
+    const std::lock_guard lock(mutex);
+    for (size_t thread{}; thread < buffers.size(); ++thread) {
+        const Buffer&  buffer  = *buffers[thread];
+        const uint64_t written = buffer.written.load(std::memory_order_acquire);
+        std::vector<Slice> slices;
+        slices.reserve(std::min<uint64_t>(written, Capacity));
+        for (uint64_t index = written > Capacity ? written - Capacity : 0U; index < written; ++index) slices.push_back(buffer.slices[index % Capacity]);
+        // The owning thread may have lapped the copy; drop every slice whose slot it could have reused since.
+        const uint64_t after = buffer.written.load(std::memory_order_acquire);
+        const uint64_t valid = after + 1U > Capacity ? after + 1U - Capacity : 0U;
+        const uint64_t start = written > Capacity ? written - Capacity : 0U;
+        for (size_t i = valid > start ? valid - start : 0U; i < slices.size(); ++i) {
+            const Slice& slice = slices[i];
+            file << (first ? "" : ",") << R"({"ph":"X","pid":1,"tid":)" << thread << R"(,"name":")" << slice.name << R"(","ts":)" << static_cast<double>(slice.begin) / 1000.0 << R"(,"dur":)" << static_cast<double>(slice.end - slice.begin) / 1000.0 << '}';
+            first = false;
+        }
+    }
+    file << "]}";
+    return static_cast<bool>(file);
+}
+#endif
@@ -10,9 +10,32 @@
 #include "Plugin.hpp"
 #include "Upscaler/Upscaler.hpp"
 #include "Upscaler/DLSS_Upscaler.hpp"
-#include "Upscaler/XeSS_UPscaler.hpp"
+#include "Upscaler/XeSS_Upscaler.hpp"
 #include "Upscaler/FSR_Upscaler.hpp"
+#include "Upscaler/UpscaleData.hpp"
+#include "Utilities/ContextCache.hpp"
+#include "Utilities/ContextUpdate.hpp"
+#include "Utilities/FrameRing.hpp"
+#include "Utilities/JitterSequence.hpp"
+#include "Utilities/LogQueue.hpp"
+#include "Utilities/PipelineCache.hpp"
+#include "Utilities/ResolutionController.hpp"
+#include "Utilities/Stats.hpp"
+#include "Utilities/Timings.hpp"
+#include "Utilities/Trace.hpp"
 
+#ifdef _WIN32
+#    define NOMINMAX
+#    include <Windows.h>
+#else
+#    include <dlfcn.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <span>
+#include <string_view>
 #include <vector>
 
 // Use 'handle SIGXCPU SIGPWR SIG35 SIG36 SIG37 nostop noprint' to prevent Unity's signals with GDB on Linux.
@@ -20,28 +43,30 @@
 
 extern "C" UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API LoadedCorrectlyPlugin() { return Plugin::loadedCorrectly; }
 
-#pragma region Deep Learning Super Sampling
-struct DeepLearningSuperSamplingUpscaleData
-{
-    DLSS_Upscaler* handle;
-    std::array<float, 16> viewToClip;
-    std::array<float, 16> clipToView;
-    std::array<float, 16> clipToPrevClip;
-    std::array<float, 16> prevClipToClip;
-    std::array<float, 3> position;
-    std::array<float, 3> up;
-    std::array<float, 3> right;
-    std::array<float, 3> forward;
-    float farPlane;
-    float nearPlane;
-    float verticalFOV;
-    Upscaler::Jitter jitter;
-    Upscaler::Resolution inputResolution;
-    bool resetHistory;
-};
+extern "C" UNITY_INTERFACE_EXPORT FrameRing* UNITY_INTERFACE_API CreateFrameRing(const uint32_t size, const uint32_t slots) { return new FrameRing(size, slots); }
+extern "C" UNITY_INTERFACE_EXPORT void* UNITY_INTERFACE_API BeginFrameData(FrameRing* ring) { return ring->begin(); }
+extern "C" UNITY_INTERFACE_EXPORT uint32_t UNITY_INTERFACE_API EndFrameData(FrameRing* ring) { return ring->end(); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API DestroyFrameRing(const FrameRing* ring) { delete ring; }
+
+/// Deletes a ring behind the render thread events that still read its slots.
+void UNITY_INTERFACE_API DestroyFrameRingCallback(const int /*unused*/, void* ring) { delete static_cast<FrameRing*>(ring); }
+
+extern "C" UNITY_INTERFACE_EXPORT UnityRenderingEventAndData UNITY_INTERFACE_API GetDestroyFrameRingCallback() { return DestroyFrameRingCallback; }
+
+/// Reads the data that the game thread published into `slot` as `publish`, logging the event instead if the slot was
+/// reused since. Events carry the publish number in their event id.
+template<typename T>
+bool readFrameData(const void* slot, const int publish, T& data) {
+    if (FrameRing::read(slot, static_cast<uint32_t>(publish), data)) return true;
+    Plugin::log(kUnityLogTypeWarning, "Skipped a plugin event whose frame data was overwritten before the render thread reached it.");
+    return false;
+}
 
-void UNITY_INTERFACE_API UpscaleCallbackDeepLearningSuperSampling(const int /*unused*/, void* d) {
-    const auto&    data = *static_cast<DeepLearningSuperSamplingUpscaleData*>(d);
+#pragma region Deep Learning Super Sampling
+#ifdef ENABLE_DLSS
+Upscaler::View<DLSS_Upscaler> UseUpscaleDataDeepLearningSuperSampling(const void* d, const int publish) {
+    DeepLearningSuperSamplingUpscaleData data{};
+    if (!readFrameData(d, publish, data)) return {nullptr, {}};
     DLSS_Upscaler& dlss = *data.handle;
     dlss.viewToClip     = data.viewToClip;
     dlss.clipToView     = data.clipToView;
@@ -56,34 +81,29 @@ void UNITY_INTERFACE_API UpscaleCallbackDeepLearningSuperSampling(const int /*un
     dlss.verticalFOV    = data.verticalFOV;
     dlss.resetHistory   = data.resetHistory;
     dlss.jitter         = data.jitter;
-    dlss.evaluate(data.inputResolution);
+    return {&dlss, data.inputResolution};
+}
+
+void UNITY_INTERFACE_API UpscaleCallbackDeepLearningSuperSampling(const int publish, void* d) {
+    TRACE_ZONE("UpscaleCallbackDeepLearningSuperSampling");
+    const auto [dlss, inputResolution] = UseUpscaleDataDeepLearningSuperSampling(d, publish);
+    if (dlss == nullptr) return;
+    dlss->evaluate(inputResolution);
 }
 
 extern "C" UNITY_INTERFACE_EXPORT UnityRenderingEventAndData UNITY_INTERFACE_API GetUpscaleCallbackDeepLearningSuperSampling() { return UpscaleCallbackDeepLearningSuperSampling; }
 extern "C" UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API LoadedCorrectlyDeepLearningSuperSampling() { return DLSS_Upscaler::loadedCorrectly(); }
-extern "C" UNITY_INTERFACE_EXPORT DLSS_Upscaler* UNITY_INTERFACE_API CreateContextDeepLearningSuperSampling() { return new DLSS_Upscaler; }
+extern "C" UNITY_INTERFACE_EXPORT DLSS_Upscaler* UNITY_INTERFACE_API CreateContextDeepLearningSuperSampling() { return DLSS_Upscaler::loadedCorrectly() ? new DLSS_Upscaler : nullptr; }
 extern "C" UNITY_INTERFACE_EXPORT Upscaler::Status UNITY_INTERFACE_API UpdateContextDeepLearningSuperSampling(DLSS_Upscaler* upscaler, const Upscaler::Resolution resolution, const Upscaler::Preset preset, const enum Upscaler::Quality mode, const Upscaler::Flags flags) { return upscaler->useSettings(resolution, preset, mode, flags); }
+extern "C" UNITY_INTERFACE_EXPORT ContextUpdate* UNITY_INTERFACE_API UpdateContextAsyncDeepLearningSuperSampling(const Upscaler::Resolution resolution, const Upscaler::Preset preset, const enum Upscaler::Quality mode, const Upscaler::Flags flags) { return DLSS_Upscaler::loadedCorrectly() ? ContextUpdate::start<DLSS_Upscaler>(resolution, preset, mode, flags) : nullptr; }
 extern "C" UNITY_INTERFACE_EXPORT Upscaler::Status UNITY_INTERFACE_API SetImagesDeepLearningSuperSampling(DLSS_Upscaler* upscaler, void* color, void* depth, void* motion, void* output) { return upscaler->useImages({color, depth, motion, output}); }
+#endif
 #pragma endregion
 #pragma region FidelityFX Super Resolution
-struct FidelityFXSuperResolutionUpscaleData
-{
-    FSR_Upscaler* handle;
-    float frameTime;
-    float sharpness;
-    float reactiveValue;
-    float reactiveScale;
-    float reactiveThreshold;
-    float farPlane;
-    float nearPlane;
-    float verticalFOV;
-    Upscaler::Jitter jitter;
-    Upscaler::Resolution inputResolution;
-    unsigned options;
-};
-
-void UNITY_INTERFACE_API UpscaleCallbackFidelityFXSuperResolution(const int /*unused*/, void* d) {
-    const auto&   data    = *static_cast<FidelityFXSuperResolutionUpscaleData*>(d);
+#ifdef ENABLE_FSR
+Upscaler::View<FSR_Upscaler> UseUpscaleDataFidelityFXSuperResolution(const void* d, const int publish) {
+    FidelityFXSuperResolutionUpscaleData data{};
+    if (!readFrameData(d, publish, data)) return {nullptr, {}};
     FSR_Upscaler& fsr     = *data.handle;
     fsr.farPlane          = data.farPlane;
     fsr.nearPlane         = data.nearPlane;
@@ -95,52 +115,227 @@ void UNITY_INTERFACE_API UpscaleCallbackFidelityFXSuperResolution(const int /*un
     fsr.reactiveThreshold = data.reactiveThreshold;
     fsr.debugView         = (data.options & 0x1U) != 0U;
     fsr.resetHistory      = (data.options & 0x2U) != 0U;
+    fsr.fixedAllocation   = (data.options & 0x4U) != 0U;
     fsr.jitter            = data.jitter;
-    fsr.evaluate(data.inputResolution);
+    fsr.depthSource       = data.depthSource;
+    fsr.motionSource      = data.motionSource;
+    fsr.opaqueSource      = data.opaqueSource;
+    return {&fsr, data.inputResolution};
+}
+
+void UNITY_INTERFACE_API UpscaleCallbackFidelityFXSuperResolution(const int publish, void* d) {
+    TRACE_ZONE("UpscaleCallbackFidelityFXSuperResolution");
+    const auto [fsr, inputResolution] = UseUpscaleDataFidelityFXSuperResolution(d, publish);
+    if (fsr == nullptr) return;
+    fsr->evaluate(inputResolution);
 }
 
 extern "C" UNITY_INTERFACE_EXPORT UnityRenderingEventAndData UNITY_INTERFACE_API GetUpscaleCallbackFidelityFXSuperResolution() { return UpscaleCallbackFidelityFXSuperResolution; }
 extern "C" UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API LoadedCorrectlyFidelityFXSuperResolution() { return FSR_Upscaler::loadedCorrectly(); }
-extern "C" UNITY_INTERFACE_EXPORT FSR_Upscaler* UNITY_INTERFACE_API CreateContextFidelityFXSuperResolution() { return new FSR_Upscaler; }
+extern "C" UNITY_INTERFACE_EXPORT FSR_Upscaler* UNITY_INTERFACE_API CreateContextFidelityFXSuperResolution() { return FSR_Upscaler::loadedCorrectly() ? new FSR_Upscaler : nullptr; }
 extern "C" UNITY_INTERFACE_EXPORT Upscaler::Status UNITY_INTERFACE_API UpdateContextFidelityFXSuperResolution(FSR_Upscaler* upscaler, const Upscaler::Resolution resolution, const enum Upscaler::Quality mode, const Upscaler::Flags flags) { return upscaler->useSettings(resolution, mode, flags); }
+extern "C" UNITY_INTERFACE_EXPORT ContextUpdate* UNITY_INTERFACE_API UpdateContextAsyncFidelityFXSuperResolution(const Upscaler::Resolution resolution, const enum Upscaler::Quality mode, const Upscaler::Flags flags) { return FSR_Upscaler::loadedCorrectly() ? ContextUpdate::start<FSR_Upscaler>(resolution, mode, flags) : nullptr; }
 extern "C" UNITY_INTERFACE_EXPORT Upscaler::Status UNITY_INTERFACE_API SetImagesFidelityFXSuperResolution(FSR_Upscaler* upscaler, void* color, void* depth, void* motion, void* output, void* reactive, void* opaque, const bool autoReactive) {
     upscaler->autoReactive = autoReactive;
     return upscaler->useImages({color, depth, motion, output, reactive, opaque});
 }
+#endif
 #pragma endregion
 #pragma region Xe Super Sampling
-struct XeSuperSamplingUpscaleData
-{
-    XeSS_Upscaler* handle;
-    Upscaler::Jitter jitter;
-    Upscaler::Resolution inputResolution;
-    bool resetHistory;
-};
-
-void UNITY_INTERFACE_API UpscaleCallbackXeSuperSampling(const int /*unused*/, void* d) {
-    const auto&    data = *static_cast<XeSuperSamplingUpscaleData*>(d);
+#ifdef ENABLE_XESS
+Upscaler::View<XeSS_Upscaler> UseUpscaleDataXeSuperSampling(const void* d, const int publish) {
+    XeSuperSamplingUpscaleData data{};
+    if (!readFrameData(d, publish, data)) return {nullptr, {}};
     XeSS_Upscaler& xess = *data.handle;
     xess.resetHistory   = data.resetHistory;
     xess.jitter         = data.jitter;
-    xess.evaluate(data.inputResolution);
+    return {&xess, data.inputResolution};
+}
+
+void UNITY_INTERFACE_API UpscaleCallbackXeSuperSampling(const int publish, void* d) {
+    TRACE_ZONE("UpscaleCallbackXeSuperSampling");
+    const auto [xess, inputResolution] = UseUpscaleDataXeSuperSampling(d, publish);
+    if (xess == nullptr) return;
+    xess->evaluate(inputResolution);
 }
 
 extern "C" UNITY_INTERFACE_EXPORT UnityRenderingEventAndData UNITY_INTERFACE_API GetUpscaleCallbackXeSuperSampling() { return UpscaleCallbackXeSuperSampling; }
 extern "C" UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API LoadedCorrectlyXeSuperSampling() { return XeSS_Upscaler::loadedCorrectly(); }
-extern "C" UNITY_INTERFACE_EXPORT XeSS_Upscaler* UNITY_INTERFACE_API CreateContextXeSuperSampling() { return new XeSS_Upscaler; }
+extern "C" UNITY_INTERFACE_EXPORT XeSS_Upscaler* UNITY_INTERFACE_API CreateContextXeSuperSampling() { return XeSS_Upscaler::loadedCorrectly() ? new XeSS_Upscaler : nullptr; }
 extern "C" UNITY_INTERFACE_EXPORT Upscaler::Status UNITY_INTERFACE_API UpdateContextXeSuperSampling(XeSS_Upscaler* upscaler, const Upscaler::Resolution resolution, const enum Upscaler::Quality mode, const Upscaler::Flags flags) { return upscaler->useSettings(resolution, mode, flags); }
+extern "C" UNITY_INTERFACE_EXPORT ContextUpdate* UNITY_INTERFACE_API UpdateContextAsyncXeSuperSampling(const Upscaler::Resolution resolution, const enum Upscaler::Quality mode, const Upscaler::Flags flags) { return XeSS_Upscaler::loadedCorrectly() ? ContextUpdate::start<XeSS_Upscaler>(resolution, mode, flags) : nullptr; }
 extern "C" UNITY_INTERFACE_EXPORT Upscaler::Status UNITY_INTERFACE_API SetImagesXeSuperSampling(XeSS_Upscaler* upscaler, void* color, void* depth, void* motion, void* output) { return upscaler->useImages({color, depth, motion, output}); }
+#endif
+#pragma endregion
+#pragma region Batched Evaluation
+enum BatchUpscaler : uint32_t {
+    DeepLearningSuperSampling,
+    FidelityFXSuperResolution,
+    XeSuperSampling,
+};
+
+/// One view of a batch: the slot that the view's backend published its usual upscale data into, the publish number that
+/// it was published as, and which backend that was.
+struct UpscaleBatchView
+{
+    BatchUpscaler upscaler;
+    uint32_t publish;
+    const void* slot;
+};
+
+struct UpscaleBatchData
+{
+    uint32_t count;
+    std::array<UpscaleBatchView, Upscaler::MaxBatchViews> views;
+};
+
+template<typename T>
+struct BatchedViews {
+    std::array<Upscaler::View<T>, Upscaler::MaxBatchViews> views{};
+    uint32_t count{};
+
+    void add(const Upscaler::View<T>& view) { if (view.upscaler != nullptr) views.at(count++) = view; }
+    void evaluate() const { if (count != 0) T::evaluate(std::span<const Upscaler::View<T>>(views.data(), count)); }
+};
+
+/// Evaluates several views (split-screen players, or the eyes of a stereo camera) in one plugin event. Views of the same
+/// upscaler share one command buffer lookup, and their commands are recorded back to back.
+void UNITY_INTERFACE_API UpscaleBatchCallback(const int publish, void* d) {
+    TRACE_ZONE("UpscaleBatchCallback");
+    UpscaleBatchData batch{};
+    if (!readFrameData(d, publish, batch)) return;
+#ifdef ENABLE_DLSS
+    BatchedViews<DLSS_Upscaler> dlss;
+#endif
+#ifdef ENABLE_FSR
+    BatchedViews<FSR_Upscaler> fsr;
+#endif
+#ifdef ENABLE_XESS
+    BatchedViews<XeSS_Upscaler> xess;
+#endif
+    for (uint32_t i{}; i < std::min(batch.count, Upscaler::MaxBatchViews); ++i) {
+        const auto& [upscaler, view, slot] = batch.views.at(i);
+        switch (upscaler) {
+#ifdef ENABLE_DLSS
+            case DeepLearningSuperSampling: dlss.add(UseUpscaleDataDeepLearningSuperSampling(slot, static_cast<int>(view))); break;
+#endif
+#ifdef ENABLE_FSR
+            case FidelityFXSuperResolution: fsr.add(UseUpscaleDataFidelityFXSuperResolution(slot, static_cast<int>(view))); break;
+#endif
+#ifdef ENABLE_XESS
+            case XeSuperSampling: xess.add(UseUpscaleDataXeSuperSampling(slot, static_cast<int>(view))); break;
+#endif
+            default: break;
+        }
+    }
+#ifdef ENABLE_DLSS
+    dlss.evaluate();
+#endif
+#ifdef ENABLE_FSR
+    fsr.evaluate();
+#endif
+#ifdef ENABLE_XESS
+    xess.evaluate();
+#endif
+}
+
+extern "C" UNITY_INTERFACE_EXPORT UnityRenderingEventAndData UNITY_INTERFACE_API GetUpscaleBatchCallback() { return UpscaleBatchCallback; }
+#pragma endregion
+#pragma region Dynamic Resolution
+/// A resolution controller and the timestamps that measure the GPU time it is driven by. The render thread brackets
+/// each frame of a camera with the two events of `FrameTimingCallback`.
+struct DynamicResolution {
+#ifdef ENABLE_VULKAN
+    // Timestamps resolve `TimestampLatency` frames late, and the game thread renders at the picked resolution a frame
+    // after the render thread picks it.
+    ResolutionController  controller{Vulkan::TimestampLatency + 1U};
+    Vulkan::TimestampRing timestamps;
+#else
+    ResolutionController controller{1U};
+#endif
+    Timings  timings;
+    uint64_t seen{};
+};
+
+void UNITY_INTERFACE_API FrameTimingCallback(const int event, void* data) {
+#ifdef ENABLE_VULKAN
+    if (GraphicsAPI::getType() != GraphicsAPI::VULKAN) return;
+    auto* dynamicResolution = static_cast<DynamicResolution*>(data);
+    Vulkan::getGraphicsInterface()->EnsureOutsideRenderPass();
+    UnityVulkanRecordingState state{};
+    if (!Vulkan::getGraphicsInterface()->CommandRecordingState(&state, kUnityVulkanGraphicsQueueAccess_DontCare)) return;
+    if (event == Plugin::EndFrameTiming) return dynamicResolution->timestamps.end(state.commandBuffer);
+    dynamicResolution->timestamps.begin(state.commandBuffer, dynamicResolution->timings);
+    float frameTime{};
+    const uint64_t seen = dynamicResolution->timings.latest(frameTime, dynamicResolution->seen);
+    if (seen != dynamicResolution->seen) dynamicResolution->controller.update(frameTime);
+    dynamicResolution->seen = seen;
+#endif
+}
+
+void UNITY_INTERFACE_API DestroyDynamicResolutionCallback(const int /*unused*/, void* data) {
+    auto* dynamicResolution = static_cast<DynamicResolution*>(data);
+#ifdef ENABLE_VULKAN
+    dynamicResolution->timestamps.release();
+#endif
+    delete dynamicResolution;
+}
+
+extern "C" UNITY_INTERFACE_EXPORT DynamicResolution* UNITY_INTERFACE_API CreateDynamicResolution() { return new DynamicResolution; }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API ConfigureDynamicResolution(DynamicResolution* dynamicResolution, const ResolutionController::Settings* const settings) { dynamicResolution->controller.configure(*settings); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetDynamicResolutionBounds(DynamicResolution* dynamicResolution, const ResolutionController::Resolution minimum, const ResolutionController::Resolution maximum) { dynamicResolution->controller.setBounds(minimum, maximum); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API GetDynamicResolutionState(const DynamicResolution* const dynamicResolution, ResolutionController::State* const state) { *state = dynamicResolution->controller.state(); }
+extern "C" UNITY_INTERFACE_EXPORT uint32_t UNITY_INTERFACE_API ReplayDynamicResolution(const float* const trace, const uint32_t count, const ResolutionController::Settings* const settings, const ResolutionController::Resolution minimum, const ResolutionController::Resolution maximum, const uint32_t latency, const float fixedShare, ResolutionController::State* const states) { return ResolutionController::replay(std::span(trace, count), *settings, minimum, maximum, latency, fixedShare, std::span(states, states == nullptr ? 0U : count)); }
+extern "C" UNITY_INTERFACE_EXPORT UnityRenderingEventAndData UNITY_INTERFACE_API GetFrameTimingCallback() { return FrameTimingCallback; }
+extern "C" UNITY_INTERFACE_EXPORT UnityRenderingEventAndData UNITY_INTERFACE_API GetDestroyDynamicResolutionCallback() { return DestroyDynamicResolutionCallback; }
+#pragma endregion
+#pragma region Jitter
+extern "C" UNITY_INTERFACE_EXPORT JitterSequence* UNITY_INTERFACE_API CreateJitterSequence() { return new JitterSequence; }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API DestroyJitterSequence(const JitterSequence* const sequence) { delete sequence; }
+/// Advances the camera's jitter for a frame rendered at `inputResolution`. The phase count comes from `upscaler`'s SDK
+/// when the active technique has a native context, and from the common recommendation otherwise.
+extern "C" UNITY_INTERFACE_EXPORT JitterSequence::Offset UNITY_INTERFACE_API NextJitter(JitterSequence* const sequence, const Upscaler* const upscaler, const Upscaler::Resolution inputResolution, const Upscaler::Resolution outputResolution) { return sequence->next(upscaler != nullptr ? upscaler->jitterPhaseCount(inputResolution) : JitterSequence::phaseCount(inputResolution.width, outputResolution.width)); }
 #pragma endregion
 
 extern "C" UNITY_INTERFACE_EXPORT Upscaler::Resolution UNITY_INTERFACE_API GetRecommendedResolution(const Upscaler* const upscaler) { return upscaler->recommendedInputResolution; }
 extern "C" UNITY_INTERFACE_EXPORT Upscaler::Resolution UNITY_INTERFACE_API GetMinimumResolution(const Upscaler* const upscaler) { return upscaler->dynamicMinimumInputResolution; }
 extern "C" UNITY_INTERFACE_EXPORT Upscaler::Resolution UNITY_INTERFACE_API GetMaximumResolution(const Upscaler* const upscaler) { return upscaler->dynamicMaximumInputResolution; }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API GetTimings(const Upscaler* const upscaler, Timings::Summary* const timings) { *timings = upscaler->timings.summarize(); }
 extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API DestroyContext(const Upscaler* upscaler) { delete upscaler; }
+extern "C" UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API PollContextUpdate(const ContextUpdate* update, Upscaler::Status* status) { return update->poll(*status); }
+extern "C" UNITY_INTERFACE_EXPORT Upscaler* UNITY_INTERFACE_API FinishContextUpdate(ContextUpdate* update) {
+    Upscaler* replacement = update->finish();
+    delete update;
+    return replacement;
+}
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API CancelContextUpdate(ContextUpdate* update) { ContextUpdate::cancel(update); }
+
+void UNITY_INTERFACE_API DestroyContextCallback(const int /*unused*/, void* upscaler) { delete static_cast<Upscaler*>(upscaler); }
+
+extern "C" UNITY_INTERFACE_EXPORT UnityRenderingEventAndData UNITY_INTERFACE_API GetDestroyContextCallback() { return DestroyContextCallback; }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UnloadUnusedUpscalers() { Upscaler::unloadUnused(); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetContextCacheBudget(const uint64_t bytes) { ContextCache::setBudget(bytes); }
+#ifdef ENABLE_VULKAN
+extern "C" UNITY_INTERFACE_EXPORT Vulkan::ImageViewCacheStats UNITY_INTERFACE_API GetImageViewCacheStats() { return Vulkan::getImageViewCacheStats(); }
+#endif
+#ifdef ENABLE_PREPROCESSING
+extern "C" UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API PreprocessingSupported() { return GraphicsAPI::getType() == GraphicsAPI::VULKAN && Vulkan::Preprocess::supported(); }
+#else
+extern "C" UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API PreprocessingSupported() { return false; }
+#endif
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetPipelineCacheDirectory(const char* const path) { PipelineCache::setDirectory(path == nullptr ? std::filesystem::path{} : std::filesystem::path(std::u8string_view(reinterpret_cast<const char8_t*>(path)))); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API GetPluginStats(Stats::Snapshot* const stats) { *stats = Stats::snapshot(); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API GetPluginStatsDelta(Stats::Snapshot* const stats) { *stats = Stats::delta(); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetLogLevel(const LogQueue::Level level) { LogQueue::setLevel(level); }
+#ifdef ENABLE_TRACING
+extern "C" UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API DumpTrace(const char* const path) { return path != nullptr && Trace::dump(std::filesystem::path(std::u8string_view(reinterpret_cast<const char8_t*>(path)))); }
+#endif
 
 #pragma region Frame Generation
 #ifdef ENABLE_FRAME_GENERATION
 #ifdef ENABLE_FSR
 struct alignas(128) FrameGenerateDataFidelityFXSuperResolution {
+    FSR_FrameGenerator* generator;
     std::array<float, 4> rect;
     float cameraPosition[3];
     float cameraUp[3];
@@ -152,14 +347,18 @@ struct alignas(128) FrameGenerateDataFidelityFXSuperResolution {
     float farPlane;
     float nearPlane;
     float verticalFOV;
-    unsigned index;
+    uint32_t ticket;
     unsigned options;
     bool enable;
+    void* depthSource;
+    void* motionSource;
 };
 
-void UNITY_INTERFACE_API GenerateCallbackFidelityFXSuperResolution(const int /*unused*/, void* d) {
-    const auto& data = *static_cast<FrameGenerateDataFidelityFXSuperResolution*>(d);
-    FSR_FrameGenerator::evaluate(
+void UNITY_INTERFACE_API GenerateCallbackFidelityFXSuperResolution(const int publish, void* d) {
+    TRACE_ZONE("GenerateCallbackFidelityFXSuperResolution");
+    FrameGenerateDataFidelityFXSuperResolution data{};
+    if (!readFrameData(d, publish, data) || data.generator == nullptr) return;
+    data.generator->evaluate(
       data.enable,
       FfxApiRect2D{static_cast<int32_t>(data.rect[0]), static_cast<int32_t>(data.rect[1]), static_cast<int32_t>(data.rect[2]), static_cast<int32_t>(data.rect[3])},
       &data.cameraPosition[0],
@@ -172,28 +371,50 @@ void UNITY_INTERFACE_API GenerateCallbackFidelityFXSuperResolution(const int /*u
       data.farPlane,
       data.nearPlane,
       data.verticalFOV,
-      data.index,
-      data.options
+      data.ticket,
+      data.options,
+      data.depthSource,
+      data.motionSource
     );
-#endif
 }
 
 extern "C" UNITY_INTERFACE_EXPORT UnityRenderingEventAndData UNITY_INTERFACE_API GetGenerateCallbackFidelityFXSuperResolution() { return GenerateCallbackFidelityFXSuperResolution; }
 
-extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetFrameGeneration(HWND hWnd) {
-    if (hWnd == nullptr) Plugin::frameGenerationProvider = Plugin::None;
-    else Plugin::frameGenerationProvider = Plugin::FSR;
-#ifdef ENABLE_VULKAN
-    Vulkan::setFrameGenerationHWND(hWnd);
-#endif
+/// Creates a frame generator for `hWnd`. Returns `nullptr` if FidelityFX is not available or if another frame generator
+/// already owns the window. The window's swapchain is recreated the next time it is acquired or presented.
+extern "C" UNITY_INTERFACE_EXPORT FSR_FrameGenerator* UNITY_INTERFACE_API CreateFrameGeneratorFidelityFXSuperResolution(HWND hWnd) {
+    // Frame generation dispatches through the FidelityFX library, which is otherwise only loaded on demand.
+    if (!FSR_Upscaler::loadedCorrectly()) return nullptr;
+    auto* generator = new FSR_FrameGenerator;
+    if (generator->setWindow(hWnd)) return generator;
+    // The generator was never handed out, so no render thread event can reference it yet.
+    FrameGenerator::release(generator);
+    return nullptr;
 }
 
-extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetFrameGenerationImages(void* color0, void* color1, void* depth, void* motion) {
-#ifdef ENABLE_FSR
-    FSR_FrameGenerator::useImages(static_cast<VkImage>(color0), static_cast<VkImage>(color1), static_cast<VkImage>(depth), static_cast<VkImage>(motion));
-#endif
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetFrameGenerationImages(FSR_FrameGenerator* generator, void* const* colors, const uint32_t colorCount, void* depth, void* motion) {
+    std::array<VkImage, FrameGenerator::HudlessRing::MaxDepth> images{};
+    const uint32_t count = std::min(colorCount, FrameGenerator::HudlessRing::MaxDepth);
+    for (uint32_t index{}; index < count; ++index) images.at(index) = static_cast<VkImage>(colors[index]);
+    generator->useImages(std::span(images.data(), count), static_cast<VkImage>(depth), static_cast<VkImage>(motion));
 }
 
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetFrameGenerationUiImage(FSR_FrameGenerator* generator, void* ui, const bool premultipliedAlpha) { generator->useUiImage(static_cast<VkImage>(ui), premultipliedAlpha); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API GetFrameGenerationTimings(const FSR_FrameGenerator* const generator, Timings::Summary* const timings) { *timings = generator->getTimings(); }
+extern "C" UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API SetFramePacingTuning(FSR_FrameGenerator* generator, const FfxApiSwapchainFramePacingTuning* const tuning) { return generator->setPacingTuning(*tuning); }
+#endif
+
+extern "C" UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API SetFrameGeneratorWindow(FrameGenerator* generator, HWND hWnd) { return generator->setWindow(hWnd); }
+extern "C" UNITY_INTERFACE_EXPORT uint32_t UNITY_INTERFACE_API AcquireFrameGenerationImage(FrameGenerator* generator, uint32_t* const ticket) { return generator->acquireHudless(*ticket); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API GetFramePacingReport(const FrameGenerator* const generator, PacingMonitor::Report* const report) { *report = generator->pacing.report(); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API ResetFramePacingReport(FrameGenerator* generator) { generator->pacing.reset(); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API SetFrameGenerationGovernor(FrameGenerator* generator, const FrameGenerationGovernor::Settings* const settings) { generator->governor.configure(*settings); }
+extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API GetFrameGenerationGovernorState(const FrameGenerator* const generator, FrameGenerationGovernor::State* const state) { *state = generator->governor.state(); }
+
+void UNITY_INTERFACE_API DestroyFrameGeneratorCallback(const int /*unused*/, void* generator) { FrameGenerator::release(static_cast<FrameGenerator*>(generator)); }
+
+extern "C" UNITY_INTERFACE_EXPORT UnityRenderingEventAndData UNITY_INTERFACE_API GetDestroyFrameGeneratorCallback() { return DestroyFrameGeneratorCallback; }
+
 extern "C" UNITY_INTERFACE_EXPORT UnityRenderingExtTextureFormat UNITY_INTERFACE_API GetBackBufferFormat(HWND hWnd) {
     return FrameGenerator::getBackBufferFormat(hWnd);
 }
@@ -219,21 +440,33 @@ extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UnityPluginLoad(IUnit
     Plugin::Unity::interfaces        = unityInterfaces;
     Plugin::Unity::logInterface      = unityInterfaces->Get<IUnityLog>();
     Plugin::Unity::graphicsInterface = unityInterfaces->Get<IUnityGraphics>();
+    LogQueue::start();
     Plugin::Unity::graphicsInterface->RegisterDeviceEventCallback(OnGraphicsDeviceEvent);
 }
 
 extern "C" UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UnityPluginUnload() {
     GraphicsAPI::unregisterUnityInterfaces();
     Plugin::Unity::graphicsInterface->UnregisterDeviceEventCallback(OnGraphicsDeviceEvent);
+    LogQueue::stop();
     Plugin::Unity::interfaces        = nullptr;
     Plugin::Unity::logInterface      = nullptr;
     Plugin::Unity::graphicsInterface = nullptr;
 }
 
+#ifdef _WIN32
 extern "C" BOOL WINAPI DllMain(HINSTANCE dllInstance, const DWORD reason, LPVOID reserved) {
     if (reason != DLL_PROCESS_ATTACH) return TRUE;
     char path[MAX_PATH + 1] {};
     GetModuleFileName(dllInstance, path, std::extent_v<decltype(path)>);
     Plugin::path = std::filesystem::path(path).parent_path();
     return TRUE;
-}
\ No newline at end of file
+}
+#else
+// There is no DllMain equivalent, so ask the dynamic linker which shared object this symbol was loaded from instead.
+[[maybe_unused]] static const bool pathInitialized = [] {
+    Dl_info info {};
+    if (dladdr(reinterpret_cast<const void*>(&UnityPluginLoad), &info) == 0 || info.dli_fname == nullptr) return false;
+    Plugin::path = std::filesystem::path(info.dli_fname).parent_path();
+    return true;
+}();
+#endif
\ No newline at end of file
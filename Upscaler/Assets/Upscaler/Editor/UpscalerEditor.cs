@@ -41,6 +41,11 @@ namespace Upscaler.Editor
         private SerializedProperty _useEdgeDirection;
 
         private SerializedProperty _useAsyncCompute;
+        private SerializedProperty _hudlessBufferCount;
+        private SerializedProperty _frameGenerationUiTexture;
+        private SerializedProperty _frameGenerationUiPremultipliedAlpha;
+        private SerializedProperty _asyncContextUpdates;
+        private SerializedProperty _fixedAllocation;
 
         private SerializedProperty _upscalingDebugView;
         private SerializedProperty _showRenderingAreaOverlay;
@@ -73,6 +78,11 @@ namespace Upscaler.Editor
             _useEdgeDirection = serializedObject.FindProperty("useEdgeDirection");
 
             _useAsyncCompute = serializedObject.FindProperty("useAsyncCompute");
+            _hudlessBufferCount = serializedObject.FindProperty("hudlessBufferCount");
+            _frameGenerationUiTexture = serializedObject.FindProperty("frameGenerationUiTexture");
+            _frameGenerationUiPremultipliedAlpha = serializedObject.FindProperty("frameGenerationUiPremultipliedAlpha");
+            _asyncContextUpdates = serializedObject.FindProperty("asyncContextUpdates");
+            _fixedAllocation = serializedObject.FindProperty("fixedAllocation");
 
             _upscalingDebugView = serializedObject.FindProperty("upscalingDebugView");
             _showRenderingAreaOverlay = serializedObject.FindProperty("showRenderingAreaOverlay");
@@ -273,6 +283,15 @@ namespace Upscaler.Editor
             betaSettingsFoldout = EditorGUILayout.Foldout(betaSettingsFoldout, "Beta Settings");
             if (betaSettingsFoldout)
             {
+                _asyncContextUpdates.boolValue = EditorGUILayout.Toggle(
+                    new GUIContent("Asynchronous Context Updates",
+                        "Rebuilds the upscaler's context on a background thread when its settings change instead of stalling the frame. The previous context is used until the new one is ready."),
+                    _asyncContextUpdates.boolValue);
+                _fixedAllocation.boolValue = EditorGUILayout.Toggle(
+                    new GUIContent("Fixed Allocation",
+                        "Allocates the upscaler's input images once at the maximum input resolution so that changing the input resolution never reallocates them. Uses more memory."),
+                    _fixedAllocation.boolValue);
+                EditorGUILayout.Separator();
 #if UNITY_6000_0_OR_NEWER
                 EditorGUILayout.HelpBox("Frame generation is currently unavailable in Unity 6000.", MessageType.Error);
                 _frameGeneration.boolValue = false;
@@ -287,6 +306,18 @@ namespace Upscaler.Editor
                 _frameGeneration.boolValue = EditorGUILayout.Toggle("FSR Frame Generation", _frameGeneration.boolValue);
                 GUI.enabled = _frameGeneration.boolValue;
                 _useAsyncCompute.boolValue = EditorGUILayout.Toggle("Use Async Compute", _useAsyncCompute.boolValue);
+                _hudlessBufferCount.intValue = EditorGUILayout.IntSlider(
+                    new GUIContent("HUD-less Buffers",
+                        "How many HUD-less images frame generation cycles through. More buffers let rendering run further ahead of interpolation. (Frame Generation only)"),
+                    _hudlessBufferCount.intValue, 2, 4);
+                _frameGenerationUiTexture.objectReferenceValue = EditorGUILayout.ObjectField(
+                    new GUIContent("UI Texture",
+                        "A texture that the UI is rendered into. Frame generation composites it over every frame instead of copying a HUD-less image. (Frame Generation only)"),
+                    _frameGenerationUiTexture.objectReferenceValue, typeof(RenderTexture), false);
+                _frameGenerationUiPremultipliedAlpha.boolValue = EditorGUILayout.Toggle(
+                    new GUIContent("Premultiplied UI Alpha",
+                        "Whether the UI texture holds premultiplied alpha. (Frame Generation only)"),
+                    _frameGenerationUiPremultipliedAlpha.boolValue);
                 EditorGUILayout.Separator();
                 _frameGenerationDebugView.boolValue = EditorGUILayout.Toggle(
                     new GUIContent("View Frame Generation Debug Images",
@@ -19,6 +19,9 @@ namespace Upscaler.Runtime.Backends
         [DllImport("GfxPluginUpscaler")]
         private static extern Upscaler.Status UpdateContextDeepLearningSuperSampling(IntPtr handle, Vector2Int resolution, Upscaler.Preset preset, Upscaler.Quality mode, Flags flags);
 
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr UpdateContextAsyncDeepLearningSuperSampling(Vector2Int resolution, Upscaler.Preset preset, Upscaler.Quality mode, Flags flags);
+
         [DllImport("GfxPluginUpscaler")]
         private static extern Upscaler.Status SetImagesDeepLearningSuperSampling(IntPtr handle, IntPtr color, IntPtr depth, IntPtr motion, IntPtr output, IntPtr reactive, IntPtr opaque, bool autoReactive);
 
@@ -45,6 +48,7 @@ namespace Upscaler.Runtime.Backends
         public static bool Supported { get; }
         private static readonly IntPtr EventCallback;
         private DeepLearningSuperSamplingUpscaleData _data;
+        protected override ref IntPtr Handle => ref _data.handle;
         private Matrix4x4 _lastViewToClip;
         private Matrix4x4 _lastWorldToCamera;
 
@@ -79,7 +83,7 @@ namespace Upscaler.Runtime.Backends
         public DeepLearningSuperSamplingBackend()
         {
             if (!Supported) return;
-            DataHandle = Marshal.AllocCoTaskMem(Marshal.SizeOf<DeepLearningSuperSamplingUpscaleData>());
+            DataRing = CreateDataRing<DeepLearningSuperSamplingUpscaleData>();
             _data = new DeepLearningSuperSamplingUpscaleData
             {
                 handle = CreateContextDeepLearningSuperSampling()
@@ -89,12 +93,8 @@ namespace Upscaler.Runtime.Backends
         public override Upscaler.Status ComputeInputResolutionConstraints(in Upscaler upscaler, Flags flags)
         {
             if (!Supported) return Upscaler.Status.FatalRuntimeError;
-            var status = UpdateContextDeepLearningSuperSampling(_data.handle, upscaler.OutputResolution, upscaler.preset, upscaler.quality, flags);
-            if (Upscaler.Failure(status)) return status;
-            upscaler.RecommendedInputResolution = GetRecommendedResolution(_data.handle);
-            upscaler.MinInputResolution = GetMinimumResolution(_data.handle);
-            upscaler.MaxInputResolution = GetMaximumResolution(_data.handle);
-            return status;
+            if (CanUpdateContextAsync(upscaler)) return BeginContextUpdate(upscaler, UpdateContextAsyncDeepLearningSuperSampling(upscaler.OutputResolution, upscaler.preset, upscaler.quality, flags));
+            return UseContextConstraints(upscaler, UpdateContextDeepLearningSuperSampling(_data.handle, upscaler.OutputResolution, upscaler.preset, upscaler.quality, flags));
         }
 
         public override Upscaler.Status Update(in Upscaler upscaler, in Texture input, in Texture output, Flags flags)
@@ -129,6 +129,7 @@ namespace Upscaler.Runtime.Backends
         public override void Upscale(in Upscaler upscaler, in CommandBuffer commandBuffer, in Texture depth, in Texture motion, in Texture opaque = null)
         {
             if (!Supported) return;
+            if (!PrepareUpscale(upscaler, commandBuffer)) return;
             var cam = upscaler.Camera;
             var nonJitteredProjectionMatrix = cam.nonJitteredProjectionMatrix;
             _data.viewToClip = GL.GetGPUProjectionMatrix(nonJitteredProjectionMatrix, true).inverse;
@@ -145,25 +146,23 @@ namespace Upscaler.Runtime.Backends
             _data.up = transform.up;
             _data.right = transform.right;
             _data.forward = transform.forward;
-            _data.jitter = upscaler.Jitter - new Vector2(0.5f, 0.5f);
+            _data.jitter = upscaler.Jitter;
             _data.inputResolution = upscaler.InputResolution;
             _data.resetHistory = upscaler.shouldHistoryResetThisFrame;
-            Marshal.StructureToPtr(_data, DataHandle, true);
+            var slot = PublishData(_data, out var publish);
 
             _lastViewToClip = _data.viewToClip;
             _lastWorldToCamera = cameraToWorld.inverse;
 
-            if (depth != Depth) commandBuffer.Blit(depth, Depth, CopyDepth, 0);
-            if (motion != Motion) commandBuffer.Blit(motion, Motion);
-            commandBuffer.IssuePluginEventAndData(EventCallback, 0, DataHandle);
+            CopyDepthAndMotion(upscaler, commandBuffer, depth, motion);
+            commandBuffer.IssuePluginEventAndData(EventCallback, publish, slot);
         }
 
         public override void Dispose()
         {
             Depth?.Release();
             Motion?.Release();
-            DestroyContext(_data.handle);
-            Marshal.FreeCoTaskMem(DataHandle);
+            DestroyContexts();
         }
     }
 }
\ No newline at end of file
@@ -20,6 +20,9 @@ namespace Upscaler.Runtime.Backends
         [DllImport("GfxPluginUpscaler")]
         private static extern Upscaler.Status UpdateContextFidelityFXSuperResolution(IntPtr handle, Vector2Int resolution, Upscaler.Quality mode, Flags flags);
 
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr UpdateContextAsyncFidelityFXSuperResolution(Vector2Int resolution, Upscaler.Quality mode, Flags flags);
+
         [DllImport("GfxPluginUpscaler")]
         private static extern Upscaler.Status SetImagesFidelityFXSuperResolution(IntPtr handle, IntPtr color, IntPtr depth, IntPtr motion, IntPtr output, IntPtr reactive, IntPtr opaque, bool autoReactive);
 
@@ -38,13 +41,25 @@ namespace Upscaler.Runtime.Backends
             internal Vector2 jitter;
             internal Vector2Int inputResolution;
             internal uint options;
+            internal IntPtr depthSource;
+            internal IntPtr motionSource;
+            internal IntPtr opaqueSource;
         }
 
         public static bool Supported { get; }
         private static readonly IntPtr EventCallback;
+        /// Whether the native plugin copies the depth, motion vectors, and opaque-only color itself in place of Unity.
+        private static readonly bool Preprocessing;
         private FidelityFXSuperResolutionUpscaleData _data;
+        protected override ref IntPtr Handle => ref _data.handle;
         private RenderTexture _reactive;
         private RenderTexture _opaque;
+        /// A storage copy of the camera's depth, written by the native preprocessing pass when the camera's depth can be
+        /// bound neither directly nor as <see cref="NativeAbstractBackend.Depth"/>.
+        private RenderTexture _preprocessedDepth;
+        /// The depth and motion images that the native context currently reads, either the copies or the camera's own.
+        private Texture _boundDepth;
+        private Texture _boundMotion;
 
         static FidelityFXSuperResolutionBackend()
         {
@@ -62,6 +77,7 @@ namespace Upscaler.Runtime.Backends
                     Supported = false;
                     return;
                 }
+                Preprocessing = PreprocessingSupported();
 
                 var backend = new FidelityFXSuperResolutionBackend();
                 var status = UpdateContextFidelityFXSuperResolution(backend._data.handle, new Vector2Int(32, 32), Upscaler.Quality.Auto, Flags.None);
@@ -77,7 +93,7 @@ namespace Upscaler.Runtime.Backends
         public FidelityFXSuperResolutionBackend()
         {
             if (!Supported) return;
-            DataHandle = Marshal.AllocCoTaskMem(Marshal.SizeOf<FidelityFXSuperResolutionUpscaleData>());
+            DataRing = CreateDataRing<FidelityFXSuperResolutionUpscaleData>();
             _data = new FidelityFXSuperResolutionUpscaleData
             {
                 handle = CreateContextFidelityFXSuperResolution()
@@ -87,12 +103,8 @@ namespace Upscaler.Runtime.Backends
         public override Upscaler.Status ComputeInputResolutionConstraints(in Upscaler upscaler, Flags flags)
         {
             if (!Supported) return Upscaler.Status.FatalRuntimeError;
-            var status = UpdateContextFidelityFXSuperResolution(_data.handle, upscaler.OutputResolution, upscaler.quality, flags);
-            if (Upscaler.Failure(status)) return status;
-            upscaler.RecommendedInputResolution = GetRecommendedResolution(_data.handle);
-            upscaler.MinInputResolution = GetMinimumResolution(_data.handle);
-            upscaler.MaxInputResolution = GetMaximumResolution(_data.handle);
-            return status;
+            if (CanUpdateContextAsync(upscaler)) return BeginContextUpdate(upscaler, UpdateContextAsyncFidelityFXSuperResolution(upscaler.OutputResolution, upscaler.quality, flags));
+            return UseContextConstraints(upscaler, UpdateContextFidelityFXSuperResolution(_data.handle, upscaler.OutputResolution, upscaler.quality, flags));
         }
 
         public override Upscaler.Status Update(in Upscaler upscaler, in Texture input, in Texture output, Flags flags)
@@ -115,8 +127,14 @@ namespace Upscaler.Runtime.Backends
                 Motion = (flags & Flags.OutputResolutionMotionVectors) == Flags.OutputResolutionMotionVectors ?
                     new RenderTexture(output.width, output.height, 0, RenderTextureFormat.RGHalf) :
                     new RenderTexture(input.width, input.height, 0, RenderTextureFormat.RGHalf);
+                Motion.enableRandomWrite = Preprocessing;
                 Motion.Create();
             }
+            if (!inputsMatch)
+            {
+                _preprocessedDepth?.Release();
+                _preprocessedDepth = null;
+            }
             if (upscaler.autoReactive && (!inputsMatch || _reactive == null))
             {
                 _reactive?.Release();
@@ -130,7 +148,9 @@ namespace Upscaler.Runtime.Backends
             {
                 needsImageRefresh = true;
                 _opaque?.Release();
-                _opaque = new RenderTexture(input.width, input.height, 0, input.graphicsFormat);
+                _opaque = Preprocessing ?
+                    new RenderTexture(input.width, input.height, 0, GraphicsFormat.R16G16B16A16_SFloat) { enableRandomWrite = true } :
+                    new RenderTexture(input.width, input.height, 0, input.graphicsFormat);
                 _opaque.Create();
             }
 
@@ -141,36 +161,82 @@ namespace Upscaler.Runtime.Backends
             _data.reactiveValue = upscaler.reactiveMax;
             _data.reactiveScale = upscaler.reactiveScale;
             _data.reactiveThreshold = upscaler.reactiveThreshold;
-            return needsImageRefresh ? SetImagesFidelityFXSuperResolution(_data.handle, input.GetNativeTexturePtr(), Depth.GetNativeTexturePtr(), Motion.GetNativeTexturePtr(), output.GetNativeTexturePtr(), _reactive?.GetNativeTexturePtr() ?? IntPtr.Zero, _opaque?.GetNativeTexturePtr() ?? IntPtr.Zero, upscaler.autoReactive) : Upscaler.Status.Success;
+            if (!needsImageRefresh) return Upscaler.Status.Success;
+            _boundDepth = Depth;
+            _boundMotion = Motion;
+            return SetImages(upscaler);
+        }
+
+        private Upscaler.Status SetImages(in Upscaler upscaler) => SetImagesFidelityFXSuperResolution(_data.handle, Input.GetNativeTexturePtr(), _boundDepth.GetNativeTexturePtr(), _boundMotion.GetNativeTexturePtr(), Output.GetNativeTexturePtr(), _reactive?.GetNativeTexturePtr() ?? IntPtr.Zero, _opaque?.GetNativeTexturePtr() ?? IntPtr.Zero, upscaler.autoReactive);
+
+        /// The image that the camera's depth is copied into. <see cref="NativeAbstractBackend.Depth"/> is a depth format
+        /// that the preprocessing pass cannot write, so that pass copies into a lazily allocated storage image instead.
+        /// When the camera renders into <see cref="NativeAbstractBackend.Depth"/> itself, as URP does, nothing is copied.
+        private Texture DepthCopy(in Texture depth)
+        {
+            if (!Preprocessing || depth == Depth) return Depth;
+            if (_preprocessedDepth != null) return _preprocessedDepth;
+            _preprocessedDepth = new RenderTexture(Depth.width, Depth.height, 0, GraphicsFormat.R32_SFloat)
+            {
+                enableRandomWrite = true
+            };
+            _preprocessedDepth.Create();
+            return _preprocessedDepth;
+        }
+
+        /// Points the native context at the camera's depth and motion vectors when FSR can read them as they are, and at
+        /// the copies otherwise. The images are only rebound when that choice or the camera's textures change.
+        private bool BindDepthAndMotion(in Upscaler upscaler, in Texture depth, in Texture motion)
+        {
+            var direct = CanBindDirectly(depth, motion);
+            Texture boundDepth = direct ? depth : DepthCopy(depth);
+            Texture boundMotion = direct ? motion : Motion;
+            if (boundDepth == _boundDepth && boundMotion == _boundMotion) return direct;
+            _boundDepth = boundDepth;
+            _boundMotion = boundMotion;
+            if (Upscaler.Success(SetImages(upscaler)) || !direct) return direct;
+            _boundDepth = DepthCopy(depth);
+            _boundMotion = Motion;
+            SetImages(upscaler);
+            return false;
         }
 
         public override void Upscale(in Upscaler upscaler, in CommandBuffer commandBuffer, in Texture depth, in Texture motion, in Texture opaque = null)
         {
             if (!Supported || Upscaler.Failure(upscaler.CurrentStatus)) return;
+            if (!PrepareUpscale(upscaler, commandBuffer)) return;
             var nonJitteredProjectionMatrix = upscaler.Camera.nonJitteredProjectionMatrix;
             var planes = nonJitteredProjectionMatrix.decomposeProjection;
             _data.frameTime = Time.deltaTime * 1000.0f;
             _data.farPlane = planes.zFar;
             _data.nearPlane = planes.zNear;
             _data.verticalFOV = 2.0f * (float)Math.Atan(1.0f / nonJitteredProjectionMatrix.m11) * 180.0f / (float)Math.PI;
-            _data.jitter = upscaler.Jitter - new Vector2(0.5f, 0.5f);
+            _data.jitter = upscaler.Jitter;
             _data.inputResolution = upscaler.InputResolution;
             _data.options = Convert.ToUInt32(upscaler.upscalingDebugView) << 0 |
-                            Convert.ToUInt32(upscaler.shouldHistoryResetThisFrame) << 1;
-            Marshal.StructureToPtr(_data, DataHandle, true);
-
-            if (depth != Depth) commandBuffer.Blit(depth, Depth, CopyDepth, 0);
-            if (motion != Motion) commandBuffer.Blit(motion, Motion);
-            if (upscaler.autoReactive && motion != null) commandBuffer.CopyTexture(opaque, _opaque);
-            commandBuffer.IssuePluginEventAndData(EventCallback, 0, DataHandle);
+                            Convert.ToUInt32(upscaler.shouldHistoryResetThisFrame) << 1 |
+                            Convert.ToUInt32(upscaler.UsesFixedAllocation) << 2;
+            var direct = BindDepthAndMotion(upscaler, depth, motion);
+            var copyOpaque = upscaler.autoReactive && motion != null;
+            _data.depthSource = Preprocessing && !direct && depth != Depth ? SourcePointer(depth) : IntPtr.Zero;
+            _data.motionSource = Preprocessing && !direct && motion != Motion ? SourcePointer(motion) : IntPtr.Zero;
+            _data.opaqueSource = Preprocessing && copyOpaque ? SourcePointer(opaque) : IntPtr.Zero;
+            var slot = PublishData(_data, out var publish);
+
+            if (!Preprocessing)
+            {
+                if (!direct) CopyDepthAndMotion(upscaler, commandBuffer, depth, motion);
+                if (copyOpaque) commandBuffer.CopyTexture(opaque, 0, 0, 0, 0, opaque.width, opaque.height, _opaque, 0, 0, 0, 0);
+            }
+            commandBuffer.IssuePluginEventAndData(EventCallback, publish, slot);
         }
 
         public override void Dispose()
         {
             Depth?.Release();
             Motion?.Release();
-            DestroyContext(_data.handle);
-            Marshal.FreeCoTaskMem(DataHandle);
+            _preprocessedDepth?.Release();
+            DestroyContexts();
         }
     }
 }
\ No newline at end of file
@@ -20,10 +20,43 @@ namespace Upscaler.Runtime.Backends
         private static extern bool LoadedCorrectlyFidelityFXSuperResolution();
 
         [DllImport("GfxPluginUpscaler")]
-        private static extern void SetFrameGeneration(IntPtr hWnd);
+        private static extern bool PreprocessingSupported();
 
         [DllImport("GfxPluginUpscaler")]
-        private static extern void SetFrameGenerationImages(IntPtr color0, IntPtr color1, IntPtr depth, IntPtr motion);
+        private static extern IntPtr CreateFrameGeneratorFidelityFXSuperResolution(IntPtr hWnd);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern bool SetFrameGeneratorWindow(IntPtr generator, IntPtr hWnd);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr GetDestroyFrameGeneratorCallback();
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void SetFrameGenerationImages(IntPtr generator, IntPtr[] colors, uint colorCount, IntPtr depth, IntPtr motion);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void SetFrameGenerationUiImage(IntPtr generator, IntPtr ui, bool premultipliedAlpha);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern uint AcquireFrameGenerationImage(IntPtr generator, out uint ticket);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern bool SetFramePacingTuning(IntPtr generator, in Upscaler.FramePacingTuning tuning);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void GetFramePacingReport(IntPtr generator, out Upscaler.FramePacingReport report);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void ResetFramePacingReport(IntPtr generator);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void SetFrameGenerationGovernor(IntPtr generator, in Upscaler.FrameGenerationGovernorSettings settings);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void GetFrameGenerationGovernorState(IntPtr generator, out Upscaler.FrameGenerationGovernorState state);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void GetFrameGenerationTimings(IntPtr generator, out Upscaler.GpuTimings timings);
 
         [DllImport("GfxPluginUpscaler")]
         private static extern GraphicsFormat GetBackBufferFormat(IntPtr hWnd);
@@ -31,8 +64,21 @@ namespace Upscaler.Runtime.Backends
         [DllImport("GfxPluginUpscaler")]
         private static extern IntPtr GetGenerateCallbackFidelityFXSuperResolution();
 
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr CreateFrameRing(uint size, uint slots);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr BeginFrameData(IntPtr ring);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern uint EndFrameData(IntPtr ring);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr GetDestroyFrameRingCallback();
+
         [StructLayout(LayoutKind.Sequential)]
         private struct FrameGenerateData {
+            internal IntPtr generator;
             internal Rect generationRect;
             internal Vector3 cameraPosition;
             internal Vector3 cameraUp;
@@ -44,14 +90,19 @@ namespace Upscaler.Runtime.Backends
             internal float farPlane;
             internal float nearPlane;
             internal float verticalFOV;
-            internal uint index;
+            internal uint ticket;
             internal uint options;
             internal bool enable;
+            internal IntPtr depthSource;
+            internal IntPtr motionSource;
         }
 
         public static bool Supported { get; }
-        private IntPtr DataHandle;
+        private IntPtr DataRing;
+        private IntPtr _handle;
         private static readonly IntPtr EventCallback;
+        /// Whether the native plugin flips the depth and motion vectors itself in place of Unity's blits.
+        private static readonly bool Preprocessing;
         private FrameGenerateData _data;
         private static readonly Material _depthBlitMaterial = new (Shader.Find("Hidden/Upscaler/BlitDepth"));
         private static readonly int BlitScaleBiasID = Shader.PropertyToID("_BlitScaleBias");
@@ -63,12 +114,17 @@ namespace Upscaler.Runtime.Backends
         private Vector2 _editorResolution;
 #endif
         private RenderTextureDescriptor _inputDescriptor;
-        private uint _hudlessBufferIndex;
         private IntPtr hWnd;
 
-        private readonly RTHandle[] _hudless = new RTHandle[2];
+        private const uint Unavailable = ~0U;
+        private readonly RTHandle[] _hudless;
+        private readonly IntPtr[] _hudlessPointers;
         private RTHandle _flippedDepth;
         private RTHandle _flippedMotion;
+        /// The native image of the UI texture last handed to the plugin. Compared by pointer, since a render texture that
+        /// is released and created again keeps its managed object but not its native image.
+        private IntPtr _ui;
+        private bool _uiPremultipliedAlpha;
 
         static FrameGeneratorBackend()
         {
@@ -90,9 +146,9 @@ namespace Upscaler.Runtime.Backends
                     Supported = false;
                     return;
                 }
-
-                var backend = new FrameGeneratorBackend();
-                backend.Dispose();
+                Preprocessing = PreprocessingSupported();
+                // Creating a generator would claim the window, so only check that the rest of the entry points resolve.
+                if (GetDestroyFrameGeneratorCallback() == IntPtr.Zero || GetDestroyFrameRingCallback() == IntPtr.Zero) Supported = false;
             }
             catch
             {
@@ -100,20 +156,25 @@ namespace Upscaler.Runtime.Backends
             }
         }
 
-        public FrameGeneratorBackend(int targetDisplay=0)
+        public FrameGeneratorBackend(int targetDisplay=0, int hudlessBufferCount=2)
         {
+            _hudless = new RTHandle[Mathf.Clamp(hudlessBufferCount, 2, 4)];
+            _hudlessPointers = new IntPtr[_hudless.Length];
             if (!Supported) return;
-            DataHandle = Marshal.AllocCoTaskMem(Marshal.SizeOf<FrameGenerateData>());
-            _data = new FrameGenerateData();
+            unsafe { DataRing = CreateFrameRing((uint)sizeof(FrameGenerateData), NativeAbstractBackend.FrameRingDepth); }
             hWnd = GetFrameGenerationTargetWindowHandle(targetDisplay);
-            SetFrameGeneration(hWnd);
+            _handle = CreateFrameGeneratorFidelityFXSuperResolution(hWnd);
+            if (_handle == IntPtr.Zero) Debug.LogWarning("Failed to create a frame generator. Another frame generator may already own the window.");
+            _data = new FrameGenerateData { generator = _handle };
         }
 
         public void Update(in Upscaler upscaler, RenderTextureDescriptor descriptor)
         {
             if (!Supported) return;
-            hWnd = GetFrameGenerationTargetWindowHandle(upscaler.Camera.targetDisplay);
-            SetFrameGeneration(hWnd);
+            if (_handle == IntPtr.Zero) return;
+            var window = GetFrameGenerationTargetWindowHandle(upscaler.Camera.targetDisplay);
+            // Another camera's frame generator may already own the window; keep the current one until it is released.
+            if (window != hWnd && SetFrameGeneratorWindow(_handle, window)) hWnd = window;
             _inputDescriptor = descriptor;
             // Frame generation expects the hudless image to be the size of the swapchain and contain only image data where the viewport is.
             descriptor.colorFormat = GraphicsFormatUtility.GetRenderTextureFormat(GetBackBufferFormat(hWnd));
@@ -122,8 +183,27 @@ namespace Upscaler.Runtime.Backends
             descriptor.width = (int)_editorResolution.x;
             descriptor.height = (int)_editorResolution.y;
 #endif
-            var needsUpdate = RenderingUtils.ReAllocateIfNeeded(ref _hudless[0], descriptor, name: "Upscaler_HUDLess0");
-            needsUpdate |= RenderingUtils.ReAllocateIfNeeded(ref _hudless[1], descriptor, name: "Upscaler_HUDLess1");
+            var needsUpdate = false;
+            var ui = upscaler.frameGenerationUiTexture;
+            // The swapchain composites the UI texture itself, so there is nothing to copy the back buffer into.
+            if (ui == null)
+                for (var i = 0; i < _hudless.Length; ++i)
+                    needsUpdate |= RenderingUtils.ReAllocateIfNeeded(ref _hudless[i], descriptor, name: "Upscaler_HUDLess" + i);
+            else
+                for (var i = 0; i < _hudless.Length; ++i)
+                {
+                    if (_hudless[i] == null) continue;
+                    _hudless[i].Release();
+                    _hudless[i] = null;
+                    needsUpdate = true;
+                }
+            var uiPointer = ui == null ? IntPtr.Zero : ui.GetNativeTexturePtr();
+            if (uiPointer != _ui || upscaler.frameGenerationUiPremultipliedAlpha != _uiPremultipliedAlpha)
+            {
+                _ui = uiPointer;
+                _uiPremultipliedAlpha = upscaler.frameGenerationUiPremultipliedAlpha;
+                SetFrameGenerationUiImage(_handle, _ui, _uiPremultipliedAlpha);
+            }
 
             // Frame generation expects the motion vector image to be the size of the swapchain but be entirely filled with motion vectors.
             descriptor = _inputDescriptor;
@@ -133,24 +213,45 @@ namespace Upscaler.Runtime.Backends
 #endif
             descriptor.graphicsFormat = GraphicsFormat.R16G16_SFloat;
             descriptor.depthStencilFormat = GraphicsFormat.None;
+            descriptor.enableRandomWrite = Preprocessing;
             needsUpdate |= RenderingUtils.ReAllocateIfNeeded(ref _flippedMotion, descriptor, name: "Upscaler_FlippedMotion");
 
             // Frame generation expects the depth image to be at render resolution (when upscaling).
             descriptor = _inputDescriptor;
             descriptor.width = upscaler.InputResolution.x;
             descriptor.height = upscaler.InputResolution.y;
-            descriptor.colorFormat = RenderTextureFormat.Depth;
-            needsUpdate |= RenderingUtils.ReAllocateIfNeeded(ref _flippedDepth, descriptor, isShadowMap: true, name: "Upscaler_FlippedDepth");
+            if (Preprocessing)
+            {
+                // The preprocessing pass can only write the depth as a storage image.
+                descriptor.graphicsFormat = GraphicsFormat.R32_SFloat;
+                descriptor.depthStencilFormat = GraphicsFormat.None;
+                descriptor.enableRandomWrite = true;
+                needsUpdate |= RenderingUtils.ReAllocateIfNeeded(ref _flippedDepth, descriptor, name: "Upscaler_FlippedDepth");
+            }
+            else
+            {
+                descriptor.colorFormat = RenderTextureFormat.Depth;
+                needsUpdate |= RenderingUtils.ReAllocateIfNeeded(ref _flippedDepth, descriptor, isShadowMap: true, name: "Upscaler_FlippedDepth");
+            }
 
             _inputDescriptor.depthStencilFormat = GraphicsFormat.None;
 
             if (!needsUpdate) return;
-            SetFrameGenerationImages(_hudless[0].rt.GetNativeTexturePtr(), _hudless[1].rt.GetNativeTexturePtr(), _flippedDepth.rt.GetNativeTexturePtr(), _flippedMotion.rt.GetNativeTexturePtr());
+            var count = ui == null ? _hudless.Length : 0;
+            for (var i = 0; i < count; ++i) _hudlessPointers[i] = _hudless[i].rt.GetNativeTexturePtr();
+            SetFrameGenerationImages(_handle, _hudlessPointers, (uint)count, _flippedDepth.rt.GetNativeTexturePtr(), _flippedMotion.rt.GetNativeTexturePtr());
         }
 
         public void Generate(in Upscaler upscaler, in CommandBuffer commandBuffer, in Texture depth, in Texture motion)
         {
-            if (!Supported) return;
+            if (!Supported || _handle == IntPtr.Zero) return;
+            // The plugin picks the HUD-less image that the GPU is done with; the ticket tells it which one was written.
+            // While composing a UI texture no HUD-less image is written at all. If every image is still in flight, the
+            // frame is sent without one, which skips generation for it but still lets the plugin see the GPU progress.
+            var composing = _ui != IntPtr.Zero;
+            var ticket = Unavailable;
+            var slot = composing ? 0 : AcquireFrameGenerationImage(_handle, out ticket);
+            var writeHudless = !composing && slot != Unavailable;
             var camera = upscaler.Camera;
             var projMat = camera.nonJitteredProjectionMatrix;
             var planes = projMat.decomposeProjection;
@@ -171,7 +272,7 @@ namespace Upscaler.Runtime.Backends
             _data.farPlane = planes.zFar;
             _data.nearPlane = planes.zNear;
             _data.verticalFOV = 2.0f * (float)Math.Atan(1.0f / projMat.m11) * 180.0f / (float)Math.PI;
-            _data.index = _hudlessBufferIndex;
+            _data.ticket = ticket;
             _data.options = Convert.ToUInt32(upscaler.frameGenerationDebugView)    << 0 |
                             Convert.ToUInt32(upscaler.showTearLines)               << 1 |
                             Convert.ToUInt32(upscaler.showResetIndicator)          << 2 |
@@ -180,25 +281,39 @@ namespace Upscaler.Runtime.Backends
                             Convert.ToUInt32(upscaler.useAsyncCompute)             << 5 |
                             Convert.ToUInt32(upscaler.shouldHistoryResetThisFrame) << 6;
             _data.enable = upscaler.frameGeneration;
-            Marshal.StructureToPtr(_data, DataHandle, true);
+            var flipDepth = depth != _flippedDepth.rt;
+            var flipMotion = motion != _flippedMotion.rt;
+            // The pointers are looked up every frame, as a render texture that is released and created again keeps its
+            // managed object but not its native image.
+            _data.depthSource = Preprocessing && flipDepth ? depth.GetNativeTexturePtr() : IntPtr.Zero;
+            _data.motionSource = Preprocessing && flipMotion ? motion.GetNativeTexturePtr() : IntPtr.Zero;
+            IntPtr frameData;
+            unsafe
+            {
+                frameData = BeginFrameData(DataRing);
+                *(FrameGenerateData*)frameData = _data;
+            }
+            var publish = unchecked((int)EndFrameData(DataRing));
 
+            if (writeHudless)
+            {
 #if UNITY_EDITOR
-            // Oddity of Unity requires the backbuffer to be blitted to another image before it can be blitted to the hudless image, otherwise the offset does not happen.
-            commandBuffer.GetTemporaryRT(TempColor, _inputDescriptor);
-            commandBuffer.Blit(null, TempColor);
-            commandBuffer.Blit(TempColor, _hudless[_hudlessBufferIndex], _editorResolution / upscaler.OutputResolution, -_editorOffset / _editorResolution);
-            commandBuffer.ReleaseTemporaryRT(TempColor);
+                // Oddity of Unity requires the backbuffer to be blitted to another image before it can be blitted to the hudless image, otherwise the offset does not happen.
+                commandBuffer.GetTemporaryRT(TempColor, _inputDescriptor);
+                commandBuffer.Blit(null, TempColor);
+                commandBuffer.Blit(TempColor, _hudless[slot], _editorResolution / upscaler.OutputResolution, -_editorOffset / _editorResolution);
+                commandBuffer.ReleaseTemporaryRT(TempColor);
 #else
-            commandBuffer.Blit(null, _hudless[_hudlessBufferIndex]);
+                commandBuffer.Blit(null, _hudless[slot]);
 #endif
-            if (depth != _flippedDepth.rt)
+            }
+            if (!Preprocessing && flipDepth)
             {
                 commandBuffer.SetGlobalVector(BlitScaleBiasID, new Vector4(1, -1, 0, 1));
                 commandBuffer.Blit(depth, _flippedDepth, _depthBlitMaterial, 0);
             }
-            if (motion != _flippedMotion.rt) commandBuffer.Blit(motion, _flippedMotion, new Vector2(1, -1), new Vector2(0, 1));
-            commandBuffer.IssuePluginEventAndData(EventCallback, 0, DataHandle);
-            _hudlessBufferIndex = (_hudlessBufferIndex + 1U) % (uint)_hudless.Length;
+            if (!Preprocessing && flipMotion) commandBuffer.Blit(motion, _flippedMotion, new Vector2(1, -1), new Vector2(0, 1));
+            commandBuffer.IssuePluginEventAndData(EventCallback, publish, frameData);
         }
 
 #if UNITY_EDITOR
@@ -291,10 +406,58 @@ namespace Upscaler.Runtime.Backends
 #endif
         }
 
+        internal Upscaler.GpuTimings GetGpuTimings()
+        {
+            // Timestamps are only written on Vulkan.
+            if (_handle == IntPtr.Zero || SystemInfo.graphicsDeviceType != GraphicsDeviceType.Vulkan) return default;
+            GetFrameGenerationTimings(_handle, out var timings);
+            return timings;
+        }
+
+        internal void SetFramePacingTuning(in Upscaler.FramePacingTuning tuning)
+        {
+            if (_handle != IntPtr.Zero && !SetFramePacingTuning(_handle, tuning)) Debug.LogWarning("Failed to apply the frame pacing tuning.");
+        }
+
+        internal Upscaler.FramePacingReport GetFramePacingReport()
+        {
+            if (_handle == IntPtr.Zero) return default;
+            GetFramePacingReport(_handle, out var report);
+            return report;
+        }
+
+        internal void ResetFramePacingReport()
+        {
+            if (_handle != IntPtr.Zero) ResetFramePacingReport(_handle);
+        }
+
+        internal void SetFrameGenerationGovernor(in Upscaler.FrameGenerationGovernorSettings settings)
+        {
+            if (_handle != IntPtr.Zero) SetFrameGenerationGovernor(_handle, settings);
+        }
+
+        internal Upscaler.FrameGenerationGovernorState GetFrameGenerationGovernorState()
+        {
+            if (_handle == IntPtr.Zero) return default;
+            GetFrameGenerationGovernorState(_handle, out var state);
+            return state;
+        }
+
+        /// Generate events that are still queued read both the generator and its frame data, so both are destroyed on the
+        /// render thread behind them. The native generator then lives on until the swapchain it created has been replaced.
+        /// The window is given up right away though, so that a replacement can claim it before the destroy event runs.
         public void Dispose()
         {
-            Marshal.FreeCoTaskMem(DataHandle);
-            SetFrameGeneration(IntPtr.Zero);
+            if (_handle == IntPtr.Zero && DataRing == IntPtr.Zero) return;
+            if (_handle != IntPtr.Zero) SetFrameGeneratorWindow(_handle, IntPtr.Zero);
+            var commandBuffer = new CommandBuffer();
+            commandBuffer.name = "Upscaler | Destroy Frame Generator";
+            if (_handle != IntPtr.Zero) commandBuffer.IssuePluginEventAndData(GetDestroyFrameGeneratorCallback(), 0, _handle);
+            if (DataRing != IntPtr.Zero) commandBuffer.IssuePluginEventAndData(GetDestroyFrameRingCallback(), 0, DataRing);
+            Graphics.ExecuteCommandBuffer(commandBuffer);
+            commandBuffer.Release();
+            _handle = IntPtr.Zero;
+            DataRing = IntPtr.Zero;
         }
     }
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Runtime.InteropServices;
 using UnityEngine;
+using UnityEngine.Experimental.Rendering;
+using UnityEngine.Rendering;
 
 namespace Upscaler.Runtime.Backends
 {
@@ -9,6 +12,9 @@ namespace Upscaler.Runtime.Backends
         [DllImport("GfxPluginUpscaler")]
         protected static extern bool LoadedCorrectlyPlugin();
 
+        [DllImport("GfxPluginUpscaler")]
+        protected static extern bool PreprocessingSupported();
+
         [DllImport("GfxPluginUpscaler")]
         protected static extern Vector2Int GetRecommendedResolution(IntPtr handle);
 
@@ -19,11 +25,174 @@ namespace Upscaler.Runtime.Backends
         protected static extern Vector2Int GetMaximumResolution(IntPtr handle);
 
         [DllImport("GfxPluginUpscaler")]
-        protected static extern void DestroyContext(IntPtr handle);
+        private static extern void GetTimings(IntPtr handle, out Upscaler.GpuTimings timings);
 
-        protected IntPtr DataHandle;
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr CreateFrameRing(uint size, uint slots);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr BeginFrameData(IntPtr ring);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern uint EndFrameData(IntPtr ring);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr GetDestroyFrameRingCallback();
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern bool PollContextUpdate(IntPtr update, out Upscaler.Status status);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr FinishContextUpdate(IntPtr update);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void CancelContextUpdate(IntPtr update);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr GetDestroyContextCallback();
+
+        private IntPtr _pendingUpdate;
+        private Vector2Int _pendingResolution;
+        /// Contexts that were swapped out since the last upscale. Evaluations that are still queued may use them, so they
+        /// are destroyed on the render thread behind those.
+        private readonly List<IntPtr> _retiredHandles = new();
+        /// The output resolution that the current native context was built for.
+        protected Vector2Int ContextResolution;
+
+        /// The native upscaler that the render thread evaluates.
+        protected abstract ref IntPtr Handle { get; }
+        internal IntPtr NativeHandle => Handle;
+
+        protected IntPtr DataRing;
         public RenderTexture Depth;
         public RenderTexture Motion;
         protected readonly Material CopyDepth = new (Shader.Find("Hidden/Upscaler/BlitDepth"));
+        private static readonly int BlitScaleBiasID = Shader.PropertyToID("_BlitScaleBias");
+
+        /// Ring slots for one frame per frame that Unity's render thread may trail the game thread by, plus the frame being
+        /// written and the one being read.
+        internal static uint FrameRingDepth => (uint)Math.Max(QualitySettings.maxQueuedFrames, 1) + 2;
+
+        protected static unsafe IntPtr CreateDataRing<T>() where T : unmanaged => CreateFrameRing((uint)sizeof(T), FrameRingDepth);
+
+        /// Writes this frame's data straight into the next native ring slot and returns the slot to hand to the render thread.
+        /// <paramref name="publish"/> is the event id to issue it with, which lets the render thread tell whether the slot
+        /// still holds this data. Every call publishes anew, so cameras that render several times a frame each get a slot.
+        protected unsafe IntPtr PublishData<T>(in T data, out int publish) where T : unmanaged
+        {
+            var slot = BeginFrameData(DataRing);
+            *(T*)slot = data;
+            publish = unchecked((int)EndFrameData(DataRing));
+            return slot;
+        }
+
+        /// Asynchronous updates only replace a context that already works; the first one is always built synchronously.
+        protected bool CanUpdateContextAsync(in Upscaler upscaler) => upscaler.asyncContextUpdates && ContextResolution != Vector2Int.zero;
+
+        /// Tracks a context update started on a native worker thread. The current context keeps being used until the
+        /// update finishes, so the constraints reported to <paramref name="upscaler"/> are left as they are.
+        protected Upscaler.Status BeginContextUpdate(in Upscaler upscaler, IntPtr update)
+        {
+            if (update == IntPtr.Zero) return Upscaler.Status.LibraryNotLoaded;
+            if (_pendingUpdate != IntPtr.Zero) CancelContextUpdate(_pendingUpdate);
+            _pendingUpdate = update;
+            _pendingResolution = upscaler.OutputResolution;
+            return Upscaler.Status.Success;
+        }
+
+        /// Reports the constraints of a context that was just updated synchronously, abandoning any pending update.
+        protected Upscaler.Status UseContextConstraints(in Upscaler upscaler, Upscaler.Status status)
+        {
+            if (_pendingUpdate != IntPtr.Zero) CancelContextUpdate(_pendingUpdate);
+            _pendingUpdate = IntPtr.Zero;
+            if (Upscaler.Failure(status)) return status;
+            ContextResolution = upscaler.OutputResolution;
+            upscaler.RecommendedInputResolution = GetRecommendedResolution(Handle);
+            upscaler.MinInputResolution = GetMinimumResolution(Handle);
+            upscaler.MaxInputResolution = GetMaximumResolution(Handle);
+            return status;
+        }
+
+        internal override bool CompleteContextUpdate(in Upscaler upscaler, out Upscaler.Status status)
+        {
+            status = Upscaler.Status.Success;
+            if (_pendingUpdate == IntPtr.Zero || !PollContextUpdate(_pendingUpdate, out status)) return false;
+            var replacement = FinishContextUpdate(_pendingUpdate);
+            _pendingUpdate = IntPtr.Zero;
+            if (Upscaler.Failure(status)) return true;
+            _retiredHandles.Add(Handle);
+            Handle = replacement;
+            ContextResolution = _pendingResolution;
+            upscaler.RecommendedInputResolution = GetRecommendedResolution(Handle);
+            upscaler.MinInputResolution = GetMinimumResolution(Handle);
+            upscaler.MaxInputResolution = GetMaximumResolution(Handle);
+            return true;
+        }
+
+        /// Destroys the contexts that were swapped out on the render thread, behind the last evaluation that used them.
+        /// Returns <c>false</c> after recording a plain bilinear upscale instead if the current context was built for a
+        /// different output resolution and its replacement is still being built.
+        protected bool PrepareUpscale(in Upscaler upscaler, in CommandBuffer commandBuffer)
+        {
+            foreach (var handle in _retiredHandles) commandBuffer.IssuePluginEventAndData(GetDestroyContextCallback(), 0, handle);
+            _retiredHandles.Clear();
+            if (upscaler.OutputResolution == ContextResolution) return true;
+            commandBuffer.Blit(Input, Output);
+            return false;
+        }
+
+        /// Copies the camera's depth and motion vectors into the images bound to the native context. Those images are
+        /// allocated for <see cref="Upscaler.MaxInputResolution"/> when <see cref="Upscaler.fixedAllocation"/> is set, so
+        /// the copy is then texel for texel from the origin rather than stretched; the context only reads the render rect.
+        protected void CopyDepthAndMotion(in Upscaler upscaler, in CommandBuffer commandBuffer, in Texture depth, in Texture motion)
+        {
+            var fixedAllocation = upscaler.UsesFixedAllocation;
+            if (depth != Depth)
+            {
+                commandBuffer.SetGlobalVector(BlitScaleBiasID, fixedAllocation ? new Vector4((float)Depth.width / depth.width, (float)Depth.height / depth.height, 0, 0) : new Vector4(1, 1, 0, 0));
+                commandBuffer.Blit(depth, Depth, CopyDepth, 0);
+            }
+            if (motion == Motion) return;
+            if (fixedAllocation) commandBuffer.Blit(motion, Motion, new Vector2((float)Motion.width / motion.width, (float)Motion.height / motion.height), Vector2.zero);
+            else commandBuffer.Blit(motion, Motion);
+        }
+
+        /// Whether the camera's own depth and motion vectors can be bound to the native context in place of
+        /// <see cref="Depth"/> and <see cref="Motion"/>, which saves copying them every frame. Both must be single-sampled,
+        /// the depth must be a depth texture, and the motion vectors must hold two float channels as the copies do.
+        protected static bool CanBindDirectly(in Texture depth, in Texture motion) =>
+            depth is RenderTexture { antiAliasing: 1, format: RenderTextureFormat.Depth or RenderTextureFormat.Shadowmap } &&
+            motion is RenderTexture { antiAliasing: 1, graphicsFormat: GraphicsFormat.R16G16_SFloat or GraphicsFormat.R32G32_SFloat };
+
+        /// The native pointer of a camera texture that the native preprocessing pass reads in place of a Unity copy. It is
+        /// looked up every frame, as a render texture that is released and created again keeps its managed object but not
+        /// its native image.
+        protected static IntPtr SourcePointer(in Texture texture) => texture == null ? IntPtr.Zero : texture.GetNativeTexturePtr();
+
+        /// The GPU time of the current context's dispatches.
+        internal Upscaler.GpuTimings GetGpuTimings()
+        {
+            if (Handle == IntPtr.Zero) return default;
+            GetTimings(Handle, out var timings);
+            return timings;
+        }
+
+        /// Destroys every context and the frame data on the render thread, behind the evaluations that may still use them.
+        protected void DestroyContexts()
+        {
+            if (_pendingUpdate != IntPtr.Zero) CancelContextUpdate(_pendingUpdate);
+            _pendingUpdate = IntPtr.Zero;
+            if (Handle != IntPtr.Zero) _retiredHandles.Add(Handle);
+            Handle = IntPtr.Zero;
+            if (_retiredHandles.Count == 0 && DataRing == IntPtr.Zero) return;
+            var commandBuffer = new CommandBuffer();
+            commandBuffer.name = "Upscaler | Destroy Contexts";
+            foreach (var handle in _retiredHandles) commandBuffer.IssuePluginEventAndData(GetDestroyContextCallback(), 0, handle);
+            _retiredHandles.Clear();
+            if (DataRing != IntPtr.Zero) commandBuffer.IssuePluginEventAndData(GetDestroyFrameRingCallback(), 0, DataRing);
+            DataRing = IntPtr.Zero;
+            Graphics.ExecuteCommandBuffer(commandBuffer);
+            commandBuffer.Release();
+        }
     }
 }
\ No newline at end of file
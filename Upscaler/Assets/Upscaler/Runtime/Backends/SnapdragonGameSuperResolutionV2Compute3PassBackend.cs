@@ -98,7 +98,7 @@ namespace Upscaler.Runtime.Backends
             _computeShader.SetFloat(MinLerpContributionID, cameraIsSame ? 0.3f : 0.0f);
             _computeShader.SetInt(SameCameraID, cameraIsSame ? 1 : 0);
             _computeShader.SetFloat(ResetID, Convert.ToSingle(upscaler.shouldHistoryResetThisFrame));
-            _computeShader.SetVector(JitterOffsetID, upscaler.Jitter - new Vector2(0.5f, 0.5f));
+            _computeShader.SetVector(JitterOffsetID, upscaler.Jitter);
             _computeShader.SetTexture(0, DepthID, depth ?? Texture2D.whiteTexture);
             _computeShader.SetTexture(0, MotionVectorID, motion ?? Texture2D.blackTexture);
             _computeShader.SetTexture(0, OpaqueID, opaque ?? Texture2D.blackTexture);
@@ -79,7 +79,7 @@ namespace Upscaler.Runtime.Backends
             _material.SetFloat(MinLerpContributionID, cameraIsSame ? 0.3f : 0.0f);
             _material.SetInt(SameCameraID, cameraIsSame ? 1 : 0);
             _material.SetFloat(ResetID, Convert.ToSingle(upscaler.shouldHistoryResetThisFrame));
-            _material.SetVector(JitterOffsetID, upscaler.Jitter - new Vector2(0.5f, 0.5f));
+            _material.SetVector(JitterOffsetID, upscaler.Jitter);
 
             commandBuffer.SetGlobalTexture(DepthID, depth, RenderTextureSubElement.Depth);
             commandBuffer.SetGlobalTexture(MotionVectorID, motion);
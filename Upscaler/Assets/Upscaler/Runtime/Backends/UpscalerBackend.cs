@@ -22,5 +22,13 @@ namespace Upscaler.Runtime.Backends
         public abstract Upscaler.Status Update([NotNull] in Upscaler upscaler, [NotNull] in Texture input, [NotNull] in Texture output, Flags flags);
         public abstract void Upscale([NotNull] in Upscaler upscaler, [NotNull] in CommandBuffer commandBuffer, in Texture depth, in Texture motion, in Texture opaque = null);
         public abstract void Dispose();
+
+        /// Swaps in a context that finished building in the background, if there is one. Returns <c>true</c> if the
+        /// pending update finished this frame, in which case <paramref name="status"/> holds its result.
+        internal virtual bool CompleteContextUpdate([NotNull] in Upscaler upscaler, out Upscaler.Status status)
+        {
+            status = Upscaler.Status.Success;
+            return false;
+        }
     }
 }
\ No newline at end of file
@@ -19,6 +19,9 @@ namespace Upscaler.Runtime.Backends
         [DllImport("GfxPluginUpscaler")]
         private static extern Upscaler.Status UpdateContextXeSuperSampling(IntPtr handle, Vector2Int resolution, Upscaler.Quality mode, Flags flags);
 
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr UpdateContextAsyncXeSuperSampling(Vector2Int resolution, Upscaler.Quality mode, Flags flags);
+
         [DllImport("GfxPluginUpscaler")]
         private static extern Upscaler.Status SetImagesXeSuperSampling(IntPtr handle, IntPtr color, IntPtr depth, IntPtr motion, IntPtr output, IntPtr reactive, IntPtr opaque, bool autoReactive);
 
@@ -34,6 +37,7 @@ namespace Upscaler.Runtime.Backends
         public static bool Supported { get; }
         private static readonly IntPtr EventCallback;
         private XeSuperSamplingUpscaleData _data;
+        protected override ref IntPtr Handle => ref _data.handle;
 
         static XeSuperSamplingBackend()
         {
@@ -67,7 +71,7 @@ namespace Upscaler.Runtime.Backends
         public XeSuperSamplingBackend()
         {
             if (!Supported) return;
-            DataHandle = Marshal.AllocCoTaskMem(Marshal.SizeOf<XeSuperSamplingUpscaleData>());
+            DataRing = CreateDataRing<XeSuperSamplingUpscaleData>();
             _data = new XeSuperSamplingUpscaleData
             {
                 handle = CreateContextXeSuperSampling()
@@ -77,12 +81,8 @@ namespace Upscaler.Runtime.Backends
         public override Upscaler.Status ComputeInputResolutionConstraints(in Upscaler upscaler, Flags flags)
         {
             if (!Supported) return Upscaler.Status.FatalRuntimeError;
-            var status = UpdateContextXeSuperSampling(_data.handle, upscaler.OutputResolution, upscaler.quality, flags);
-            if (Upscaler.Failure(status)) return status;
-            upscaler.RecommendedInputResolution = GetRecommendedResolution(_data.handle);
-            upscaler.MinInputResolution = GetMinimumResolution(_data.handle);
-            upscaler.MaxInputResolution = GetMaximumResolution(_data.handle);
-            return status;
+            if (CanUpdateContextAsync(upscaler)) return BeginContextUpdate(upscaler, UpdateContextAsyncXeSuperSampling(upscaler.OutputResolution, upscaler.quality, flags));
+            return UseContextConstraints(upscaler, UpdateContextXeSuperSampling(_data.handle, upscaler.OutputResolution, upscaler.quality, flags));
         }
 
         public override Upscaler.Status Update(in Upscaler upscaler, in Texture input, in Texture output, Flags flags)
@@ -117,22 +117,21 @@ namespace Upscaler.Runtime.Backends
         public override void Upscale(in Upscaler upscaler, in CommandBuffer commandBuffer, in Texture depth, in Texture motion, in Texture opaque = null)
         {
             if (!Supported) return;
-            _data.jitter = upscaler.Jitter - new Vector2(0.5f, 0.5f);
+            if (!PrepareUpscale(upscaler, commandBuffer)) return;
+            _data.jitter = upscaler.Jitter;
             _data.inputResolution = upscaler.InputResolution;
             _data.resetHistory = upscaler.shouldHistoryResetThisFrame;
-            Marshal.StructureToPtr(_data, DataHandle, true);
+            var slot = PublishData(_data, out var publish);
 
-            if (depth != Depth) commandBuffer.Blit(depth, Depth, CopyDepth, 0);
-            if (motion != Motion) commandBuffer.Blit(motion, Motion);
-            commandBuffer.IssuePluginEventAndData(EventCallback, 0, DataHandle);
+            CopyDepthAndMotion(upscaler, commandBuffer, depth, motion);
+            commandBuffer.IssuePluginEventAndData(EventCallback, publish, slot);
         }
 
         public override void Dispose()
         {
             Depth?.Release();
             Motion?.Release();
-            DestroyContext(_data.handle);
-            Marshal.FreeCoTaskMem(DataHandle);
+            DestroyContexts();
         }
     }
 }
\ No newline at end of file
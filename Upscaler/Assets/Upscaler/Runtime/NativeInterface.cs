@@ -16,6 +16,60 @@ namespace Upscaler.Runtime
         [DllImport("GfxPluginUpscaler")]
         private static extern bool LoadedCorrectlyPlugin();
 
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void UnloadUnusedUpscalers();
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void SetContextCacheBudget(ulong bytes);
+
+        [DllImport("GfxPluginUpscaler", EntryPoint = "GetImageViewCacheStats")]
+        private static extern Upscaler.ImageViewCacheStats GetNativeImageViewCacheStats();
+
+        [DllImport("GfxPluginUpscaler", EntryPoint = "GetPluginStats")]
+        private static extern void GetNativePluginStats(out Upscaler.PluginStats stats);
+
+        [DllImport("GfxPluginUpscaler", EntryPoint = "GetPluginStatsDelta")]
+        private static extern void GetNativePluginStatsDelta(out Upscaler.PluginStats stats);
+
+        [DllImport("GfxPluginUpscaler", EntryPoint = "SetLogLevel")]
+        private static extern void SetNativeLogLevel(Upscaler.NativeLogLevel level);
+
+        [DllImport("GfxPluginUpscaler", EntryPoint = "DumpTrace")]
+        private static extern bool DumpNativeTrace([MarshalAs(UnmanagedType.LPUTF8Str)] string path);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void SetPipelineCacheDirectory([MarshalAs(UnmanagedType.LPUTF8Str)] string path);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr CreateDynamicResolution();
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void ConfigureDynamicResolution(IntPtr dynamicResolution, in Upscaler.DynamicResolutionSettings settings);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern void SetDynamicResolutionBounds(IntPtr dynamicResolution, Vector2Int minimum, Vector2Int maximum);
+
+        [DllImport("GfxPluginUpscaler", EntryPoint = "GetDynamicResolutionState")]
+        private static extern void GetNativeDynamicResolutionState(IntPtr dynamicResolution, out Upscaler.DynamicResolutionState state);
+
+        [DllImport("GfxPluginUpscaler", EntryPoint = "ReplayDynamicResolution")]
+        private static extern uint ReplayNativeDynamicResolution(float[] trace, uint count, in Upscaler.DynamicResolutionSettings settings, Vector2Int minimum, Vector2Int maximum, uint latency, float fixedShare, [Out] Upscaler.DynamicResolutionState[] states);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr GetFrameTimingCallback();
+
+        [DllImport("GfxPluginUpscaler", EntryPoint = "CreateJitterSequence")]
+        private static extern IntPtr CreateNativeJitterSequence();
+
+        [DllImport("GfxPluginUpscaler", EntryPoint = "DestroyJitterSequence")]
+        private static extern void DestroyNativeJitterSequence(IntPtr sequence);
+
+        [DllImport("GfxPluginUpscaler", EntryPoint = "NextJitter")]
+        private static extern Vector2 NextNativeJitter(IntPtr sequence, IntPtr upscaler, Vector2Int inputResolution, Vector2Int outputResolution);
+
+        [DllImport("GfxPluginUpscaler")]
+        private static extern IntPtr GetDestroyDynamicResolutionCallback();
+
         private static bool WarnOnBadLoad()
         {
             try
@@ -31,5 +85,121 @@ namespace Upscaler.Runtime
         }
 
         internal static readonly bool Loaded = WarnOnBadLoad();
+
+        private static readonly IntPtr FrameTimingCallback = Loaded ? GetFrameTimingCallback() : IntPtr.Zero;
+
+        internal static void UnloadUnused()
+        {
+            if (Loaded) UnloadUnusedUpscalers();
+        }
+
+        internal static void SetCacheBudget(ulong bytes)
+        {
+            if (Loaded) SetContextCacheBudget(bytes);
+        }
+
+        internal static Upscaler.ImageViewCacheStats GetImageViewCacheStats()
+        {
+            // Image views are only cached on Vulkan; the other graphics APIs bind resources directly.
+            if (!Loaded || SystemInfo.graphicsDeviceType != GraphicsDeviceType.Vulkan) return default;
+            return GetNativeImageViewCacheStats();
+        }
+
+        internal static Upscaler.PluginStats GetPluginStats(bool delta)
+        {
+            if (!Loaded) return default;
+            Upscaler.PluginStats stats;
+            if (delta) GetNativePluginStatsDelta(out stats);
+            else GetNativePluginStats(out stats);
+            return stats;
+        }
+
+        internal static void SetLogLevel(Upscaler.NativeLogLevel level)
+        {
+            if (Loaded) SetNativeLogLevel(level);
+        }
+
+        internal static bool DumpTrace(string path)
+        {
+            // Only builds of the plugin configured with ENABLE_TRACING export the entry point.
+            if (!Loaded) return false;
+            try
+            {
+                return DumpNativeTrace(path);
+            }
+            catch (EntryPointNotFoundException)
+            {
+                return false;
+            }
+        }
+
+        internal static IntPtr CreateDynamicResolution(Upscaler.DynamicResolutionSettings settings)
+        {
+            if (!Loaded) return IntPtr.Zero;
+            var dynamicResolution = CreateDynamicResolution();
+            ConfigureDynamicResolution(dynamicResolution, settings);
+            return dynamicResolution;
+        }
+
+        internal static void ConfigureDynamicResolution(IntPtr dynamicResolution, Upscaler.DynamicResolutionSettings settings, Vector2Int minimum, Vector2Int maximum)
+        {
+            if (dynamicResolution == IntPtr.Zero) return;
+            ConfigureDynamicResolution(dynamicResolution, settings);
+            SetDynamicResolutionBounds(dynamicResolution, minimum, maximum);
+        }
+
+        internal static Upscaler.DynamicResolutionState GetDynamicResolutionState(IntPtr dynamicResolution, Vector2Int minimum, Vector2Int maximum)
+        {
+            if (dynamicResolution == IntPtr.Zero) return default;
+            SetDynamicResolutionBounds(dynamicResolution, minimum, maximum);
+            GetNativeDynamicResolutionState(dynamicResolution, out var state);
+            return state;
+        }
+
+        internal static uint ReplayDynamicResolution(float[] trace, Upscaler.DynamicResolutionSettings settings, Vector2Int minimum, Vector2Int maximum, uint latency, float fixedShare, Upscaler.DynamicResolutionState[] states)
+        {
+            if (!Loaded) return 0;
+            if (states != null && states.Length < trace.Length) throw new ArgumentException("There must be a state for every frame of the trace.", nameof(states));
+            return ReplayNativeDynamicResolution(trace, (uint)trace.Length, settings, minimum, maximum, latency, fixedShare, states);
+        }
+
+        /// Frame timing is measured with GPU timestamps, which the plugin only writes on Vulkan.
+        internal static void BeginFrameTiming(CommandBuffer commandBuffer, IntPtr dynamicResolution)
+        {
+            if (dynamicResolution != IntPtr.Zero && SystemInfo.graphicsDeviceType == GraphicsDeviceType.Vulkan) commandBuffer.IssuePluginEventAndData(FrameTimingCallback, 2, dynamicResolution);
+        }
+
+        internal static void EndFrameTiming(CommandBuffer commandBuffer, IntPtr dynamicResolution)
+        {
+            if (dynamicResolution != IntPtr.Zero && SystemInfo.graphicsDeviceType == GraphicsDeviceType.Vulkan) commandBuffer.IssuePluginEventAndData(FrameTimingCallback, 3, dynamicResolution);
+        }
+
+        /// The render thread may still be timing a frame with the controller, so it is deleted from there.
+        internal static void DestroyDynamicResolution(IntPtr dynamicResolution)
+        {
+            if (dynamicResolution == IntPtr.Zero) return;
+            var commandBuffer = new CommandBuffer();
+            commandBuffer.name = "Upscaler | Destroy Dynamic Resolution";
+            commandBuffer.IssuePluginEventAndData(GetDestroyDynamicResolutionCallback(), 0, dynamicResolution);
+            Graphics.ExecuteCommandBuffer(commandBuffer);
+            commandBuffer.Release();
+        }
+
+        internal static IntPtr CreateJitterSequence() => Loaded ? CreateNativeJitterSequence() : IntPtr.Zero;
+
+        internal static void DestroyJitterSequence(IntPtr sequence)
+        {
+            if (sequence != IntPtr.Zero) DestroyNativeJitterSequence(sequence);
+        }
+
+        /// The jitter of the next frame, or none if the plugin is unavailable.
+        internal static Vector2 NextJitter(IntPtr sequence, IntPtr upscaler, Vector2Int inputResolution, Vector2Int outputResolution) =>
+            sequence == IntPtr.Zero ? Vector2.zero : NextNativeJitter(sequence, upscaler, inputResolution, outputResolution);
+
+        [RuntimeInitializeOnLoadMethod(RuntimeInitializeLoadType.BeforeSceneLoad)]
+        private static void UsePersistentPipelineCache()
+        {
+            if (Loaded) SetPipelineCacheDirectory(Application.persistentDataPath);
+        }
     }
 }
\ No newline at end of file
@@ -29,14 +29,24 @@ namespace Upscaler.Runtime.URP
                 internal float MipBias;
             }
 
+            private class FrameTimingData
+            {
+                internal Upscaler Upscaler;
+            }
+
             public override void RecordRenderGraph(RenderGraph renderGraph, ContextContainer frameData)
             {
                 var cameraData = frameData.Get<UniversalCameraData>();
                 var upscaler = cameraData.camera.GetComponent<Upscaler>();
+                using (var builder = renderGraph.AddUnsafePass("Upscaler | Begin Frame Timing", out FrameTimingData data))
+                {
+                    data.Upscaler = upscaler;
+                    builder.AllowPassCulling(false);
+                    builder.SetRenderFunc((FrameTimingData passData, UnsafeGraphContext context) => passData.Upscaler.BeginFrameTiming(CommandBufferHelpers.GetNativeCommandBuffer(context.cmd)));
+                }
                 if (upscaler.IsTemporal())
                 {
-                    upscaler.Jitter = new Vector2(HaltonSequence.Get(upscaler.JitterIndex, 2), HaltonSequence.Get(upscaler.JitterIndex, 3));
-                    upscaler.JitterIndex = (upscaler.JitterIndex + 1) % (int)Math.Ceiling(7 * Math.Pow((float)upscaler.OutputResolution.x / upscaler.InputResolution.x, 2));
+                    upscaler.AdvanceJitter();
                     using var builder = renderGraph.AddComputePass<PassData>("Upscaler | Setup Upscaling", out var data);
                     data.CameraData = cameraData;
                     data.Jitter = upscaler.Jitter / upscaler.InputResolution * 2;
@@ -90,11 +100,16 @@ namespace Upscaler.Runtime.URP
             public override void Execute(ScriptableRenderContext context, ref RenderingData renderingData)
             {
                 var upscaler = renderingData.cameraData.camera.GetComponent<Upscaler>();
-                if (upscaler.IsSpatial()) return;
                 var cb = CommandBufferPool.Get("SetMipBias");
+                upscaler.BeginFrameTiming(cb);
+                if (upscaler.IsSpatial())
+                {
+                    context.ExecuteCommandBuffer(cb);
+                    CommandBufferPool.Release(cb);
+                    return;
+                }
                 cb.SetGlobalVector(GlobalMipBias, new Vector4(upscaler.MipBias, upscaler.MipBias * upscaler.MipBias));
-                upscaler.Jitter = new Vector2(HaltonSequence.Get(upscaler.JitterIndex, 2), HaltonSequence.Get(upscaler.JitterIndex, 3));
-                upscaler.JitterIndex = (upscaler.JitterIndex + 1) % (int)Math.Ceiling(7 * Math.Pow((float)upscaler.OutputResolution.x / upscaler.InputResolution.x, 2));
+                upscaler.AdvanceJitter();
                 var clipSpaceJitter = upscaler.Jitter / upscaler.InputResolution * 2;
 #if ENABLE_VR && ENABLE_XR_MODULE
                 if (renderingData.cameraData.xrRendering)
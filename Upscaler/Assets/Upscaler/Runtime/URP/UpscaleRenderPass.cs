@@ -35,6 +35,7 @@ namespace Upscaler.Runtime.URP
                 var cmd = CommandBufferHelpers.GetNativeCommandBuffer(context.cmd);
                 cmd.CopyTexture(passData.Color, 0, 0, 0, 0, passData.Upscaler.InputResolution.x, passData.Upscaler.InputResolution.y, passData.Upscaler.Backend.Input, 0, 0, 0, 0);
                 passData.Upscaler.Backend.Upscale(passData.Upscaler, cmd, passData.Depth, passData.MotionVectors, passData.Opaque);
+                passData.Upscaler.EndFrameTiming(cmd);
             }
 
             public override void RecordRenderGraph(RenderGraph renderGraph, ContextContainer frameData)
@@ -69,6 +70,7 @@ namespace Upscaler.Runtime.URP
                 var upscaler = renderingData.cameraData.camera.GetComponent<Upscaler>();
                 var commandBuffer = CommandBufferPool.Get("Upscale");
                 upscaler.Backend.Upscale(upscaler, commandBuffer, Depth, Shader.GetGlobalTexture(MotionID), Shader.GetGlobalTexture(OpaqueID));
+                upscaler.EndFrameTiming(commandBuffer);
                 commandBuffer.CopyTexture(Output, renderingData.cameraData.renderer.cameraColorTargetHandle);
                 context.ExecuteCommandBuffer(commandBuffer);
                 CommandBufferPool.Release(commandBuffer);
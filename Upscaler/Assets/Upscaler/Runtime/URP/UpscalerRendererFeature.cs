@@ -68,7 +68,7 @@ namespace Upscaler.Runtime.URP
 #if UNITY_6000_0_OR_NEWER
                 RenderingUtils.ReAllocateHandleIfNeeded(ref _upscale.Output, descriptor, name: "Upscaler_Destination");
                 if (compatibilityMode) RenderingUtils.ReAllocateHandleIfNeeded(ref _upscale.Color, new RenderTextureDescriptor(upscaler.OutputResolution.x, upscaler.OutputResolution.y, renderingData.cameraData.cameraTargetDescriptor.colorFormat), name: "Upscaler_Source");
-                else RenderingUtils.ReAllocateHandleIfNeeded(ref _upscale.Color, new RenderTextureDescriptor(upscaler.InputResolution.x, upscaler.InputResolution.y, renderingData.cameraData.cameraTargetDescriptor.colorFormat), name: "Upscaler_Source");
+                else RenderingUtils.ReAllocateHandleIfNeeded(ref _upscale.Color, new RenderTextureDescriptor(upscaler.AllocatedInputResolution.x, upscaler.AllocatedInputResolution.y, renderingData.cameraData.cameraTargetDescriptor.colorFormat), name: "Upscaler_Source");
 #else
                 RenderingUtils.ReAllocateIfNeeded(ref _upscale.Output, descriptor, name: "Upscaler_Destination");
                 RenderingUtils.ReAllocateIfNeeded(ref _upscale.Color, new RenderTextureDescriptor(upscaler.OutputResolution.x, upscaler.OutputResolution.y, renderingData.cameraData.cameraTargetDescriptor.colorFormat), name: "Upscaler_Source");
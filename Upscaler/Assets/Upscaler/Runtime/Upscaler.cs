@@ -4,6 +4,7 @@
  ***********************************************/
 
 using System;
+using System.Runtime.InteropServices;
 using UnityEditor;
 using UnityEngine;
 using UnityEngine.Rendering;
@@ -176,8 +177,42 @@ namespace Upscaler.Runtime
         public bool forceHistoryResetEveryFrame;
 
         internal Camera Camera;
+        /// This frame's sub-pixel camera offset in input pixels, from the pixel center.
         internal Vector2 Jitter = Vector2.zero;
-        internal int JitterIndex;
+        private IntPtr _jitterSequence;
+        /// The position in the managed jitter sequence, which stands in for the native one where the plugin is not loaded.
+        private uint _jitterIndex;
+
+        /// Moves <see cref="Jitter"/> to the next phase of the camera's jitter sequence, whose length the plugin picks for
+        /// the current <see cref="InputResolution"/>. Without the plugin (the managed techniques on platforms that it does
+        /// not support), the same sequence is computed here instead.
+        internal void AdvanceJitter()
+        {
+            if (_jitterSequence == IntPtr.Zero) _jitterSequence = NativeInterface.CreateJitterSequence();
+            if (_jitterSequence != IntPtr.Zero)
+            {
+                Jitter = NativeInterface.NextJitter(_jitterSequence, (Backend as NativeAbstractBackend)?.NativeHandle ?? IntPtr.Zero, InputResolution, OutputResolution);
+                return;
+            }
+            var ratio = (float)OutputResolution.x / InputResolution.x;
+            var phaseCount = (uint)Math.Clamp(Math.Ceiling(8 * ratio * ratio), 1, 256);
+            // Index 0 of the Halton sequence sits on the pixel corner, so it is skipped as the native table skips it.
+            var index = (int)(++_jitterIndex % phaseCount) + 1;
+            Jitter = new Vector2(HaltonSequence(index, 2) - 0.5f, HaltonSequence(index, 3) - 0.5f);
+        }
+
+        private static float HaltonSequence(int n, int b)
+        {
+            var result = 0f;
+            var f = 1f / b;
+            while (n > 0)
+            {
+                result += n % b * f;
+                n /= b;
+                f /= b;
+            }
+            return result;
+        }
 
         /// The current output resolution. Upscaler does not control the output resolution but rather adapts to whatever
         /// output resolution Unity requests.
@@ -195,6 +230,12 @@ namespace Upscaler.Runtime
         private Vector2Int _inputResolution;
         public Vector2Int PreviousInputResolution { get; private set; } = Vector2Int.zero;
 
+        /// Whether <see cref="fixedAllocation"/> applies to the active <see cref="Technique"/>.
+        internal bool UsesFixedAllocation => fixedAllocation && Backend is NativeAbstractBackend;
+
+        /// The resolution that the images holding the rendered frame are allocated at.
+        internal Vector2Int AllocatedInputResolution => UsesFixedAllocation ? MaxInputResolution : InputResolution;
+
         /// The recommended resolution for this <see cref="Quality"/> mode as given by the selected
         /// <see cref="Technique"/>. This value will only ever be <c>(0, 0)</c> when Upscaler has yet to be enabled.
         public Vector2Int RecommendedInputResolution { get; internal set; }
@@ -254,6 +295,18 @@ namespace Upscaler.Runtime
         /// BETA FEATURE: Enable computing <see cref="frameGeneration"/> on an asynchronous compute queue. This <em>may</em> increase performance on some systems. Only relevant when <see cref="frameGeneration"/> is enabled.
         public bool useAsyncCompute = true;
         public bool PreviousUseAsyncCompute { get; private set; }
+        /// BETA FEATURE: The number of HUD-less color images that frame generation cycles through, from <c>2</c> to <c>4</c>. More images let the CPU run further ahead of frame interpolation, at the cost of one output-sized image each. A frame that finds every image still in use by the GPU is presented without an interpolated frame. Only relevant when <see cref="frameGeneration"/> is enabled. Defaults to <c>2</c>.
+        [Range(2, 4)] public int hudlessBufferCount = 2;
+        public int PreviousHudlessBufferCount { get; private set; }
+        /// BETA FEATURE: A texture holding the UI, which frame generation composites over every real and interpolated frame. Render the UI into it instead of onto the camera's target. This saves copying the back buffer into a HUD-less image every frame, so <see cref="hudlessBufferCount"/> is ignored while it is set. Only relevant when <see cref="frameGeneration"/> is enabled. Defaults to <c>null</c>.
+        public RenderTexture frameGenerationUiTexture;
+        /// Whether <see cref="frameGenerationUiTexture"/> holds premultiplied alpha. Defaults to <c>false</c>.
+        public bool frameGenerationUiPremultipliedAlpha;
+        /// BETA FEATURE: Rebuild the <see cref="Technique"/>'s context on a background thread when <see cref="quality"/>, the output resolution, or HDR changes. The previous context keeps being used until the new one is ready; if the output resolution changed, a plain bilinear upscale is shown in the meantime. Only used by <see cref="Technique.DeepLearningSuperSampling"/>, <see cref="Technique.FidelityFXSuperResolution"/>, and <see cref="Technique.XeSuperSampling"/>. Defaults to <c>false</c>.
+        public bool asyncContextUpdates;
+        /// BETA FEATURE: Allocate the images that the <see cref="Technique"/> reads once, at <see cref="MaxInputResolution"/>, and render each frame into the <see cref="InputResolution"/> sized corner of them. Changing <see cref="InputResolution"/> then never reallocates or rebinds images, which suits dynamic resolution, at the cost of the memory for the largest input resolution. Only used by <see cref="Technique.DeepLearningSuperSampling"/>, <see cref="Technique.FidelityFXSuperResolution"/>, and <see cref="Technique.XeSuperSampling"/>. Defaults to <c>false</c>.
+        public bool fixedAllocation;
+        public bool PreviousFixedAllocation { get; private set; }
         /// Enables the use of Edge Direction. Disabling this increases performance at the cost of visual quality. Defaults to <c>true</c>. Only used when <see cref="technique"/> is <see cref="Technique.SnapdragonGameSuperResolution1"/>.
         public bool useEdgeDirection = true;
         public bool PreviousUseEdgeDirection { get; private set; }
@@ -474,6 +527,373 @@ namespace Upscaler.Runtime
          */
         public static bool NativePluginLoaded() => NativeInterface.Loaded;
 
+        /**
+         * <summary>Set how much VRAM idle upscaler contexts may keep alive.</summary>
+         * <param name="bytes">The budget in bytes shared by every camera. Use <c>0</c> to disable caching.</param>
+         * <remarks>Switching back to a recently used output resolution, <see cref="Quality"/> mode, or HDR setting reuses a
+         * cached context instead of rebuilding it. The least recently used contexts are destroyed first when the budget
+         * is exceeded. The default budget is 256 MiB.</remarks>
+         * <example><code>Upscaler.SetContextCacheBudget(512UL * 1024 * 1024);</code></example>
+         */
+        public static void SetContextCacheBudget(ulong bytes) => NativeInterface.SetCacheBudget(bytes);
+
+        /// Counters for the native Vulkan image view cache, which is shared by every <see cref="Technique"/>.
+        [StructLayout(LayoutKind.Sequential)]
+        public struct ImageViewCacheStats
+        {
+            /// Requests for a view that already existed.
+            public ulong Hits;
+            /// Requests that had to create a new view.
+            public ulong Misses;
+            /// Images that were destroyed by Unity while views of them were cached.
+            public ulong Invalidations;
+            /// Views currently alive.
+            public ulong Views;
+        }
+
+        /**
+         * <summary>Reads the counters of the image view cache that the native plugin uses on Vulkan.</summary>
+         * <returns>The current counters, or all zeros when not running on Vulkan.</returns>
+         * <remarks>A high miss count relative to hits usually means that the textures given to Upscaler are being
+         * reallocated every frame.</remarks>
+         * <example><code>var stats = Upscaler.GetImageViewCacheStats();</code></example>
+         */
+        public static ImageViewCacheStats GetImageViewCacheStats() => NativeInterface.GetImageViewCacheStats();
+
+        /// Counts of the native operations that are expensive when they happen often.
+        [StructLayout(LayoutKind.Sequential)]
+        public struct PluginStats
+        {
+            /// DLSS features that Streamline was asked to build, which happens whenever a camera's settings change.
+            public ulong DeepLearningSuperSamplingContextCreations;
+            /// FSR contexts that were created rather than taken from the context cache.
+            public ulong FidelityFXSuperResolutionContextCreations;
+            /// XeSS contexts that were created rather than taken from the context cache.
+            public ulong XeSuperSamplingContextCreations;
+            /// DLSS features that were released or replaced.
+            public ulong DeepLearningSuperSamplingContextDestructions;
+            /// FSR contexts that were destroyed, including those evicted from the context cache.
+            public ulong FidelityFXSuperResolutionContextDestructions;
+            /// XeSS contexts that were destroyed, including those evicted from the context cache.
+            public ulong XeSuperSamplingContextDestructions;
+            /// Evaluations that discarded the upscaler's history.
+            public ulong HistoryResets;
+            /// Times that new images were bound to an upscaler or to frame generation.
+            public ulong ImageRebinds;
+            /// Swapchain image acquisitions that were failed on purpose to make Unity recreate the swapchain.
+            public ulong ForcedOutOfDateAcquires;
+            /// Presents that were failed on purpose to make Unity recreate the swapchain.
+            public ulong ForcedOutOfDatePresents;
+            /// Swapchains that frame generation was attached to.
+            public ulong FrameGenerationSwapchainCreations;
+            /// Upscaling and frame generation dispatches that failed.
+            public ulong FailedDispatches;
+            /// Times that the frame generation governor turned frame generation back on.
+            public ulong FrameGenerationGovernorEnables;
+            /// Times that the frame generation governor turned frame generation off.
+            public ulong FrameGenerationGovernorDisables;
+            /// Dispatches of the native pass that copied depth, motion vectors, or opaque-only color in place of Unity.
+            public ulong PreprocessDispatches;
+        }
+
+        /**
+         * <summary>Reads the native plugin's counters as accumulated since it was loaded.</summary>
+         * <returns>The current counters, or all zeros when the native plugin is not loaded.</returns>
+         * <example><code>var stats = Upscaler.GetPluginStats();</code></example>
+         */
+        public static PluginStats GetPluginStats() => NativeInterface.GetPluginStats(false);
+
+        /**
+         * <summary>Reads how much each of the native plugin's counters has grown since this was last called.</summary>
+         * <returns>The growth of each counter, or all zeros when the native plugin is not loaded.</returns>
+         * <remarks>The baseline is shared by every caller, so only one system should poll the deltas.</remarks>
+         * <example><code>var stats = Upscaler.GetPluginStatsDelta();
+         * if (stats.ForcedOutOfDatePresents > 0) Debug.Log("The swapchain was recreated.");</code></example>
+         */
+        public static PluginStats GetPluginStatsDelta() => NativeInterface.GetPluginStats(true);
+
+        /// Rolling statistics over the GPU time of the most recent native dispatches, in milliseconds.
+        [StructLayout(LayoutKind.Sequential)]
+        public struct GpuTimings
+        {
+            /// The fastest dispatch in the window.
+            public float Minimum;
+            /// The mean over the window.
+            public float Average;
+            /// The time that 99% of the dispatches in the window did not exceed.
+            public float P99;
+            /// How many dispatches the window holds, up to 256.
+            public uint Samples;
+        }
+
+        /**
+         * <summary>Reads how much GPU time this camera's upscaler has been taking.</summary>
+         * <returns>The timings of the active <see cref="Technique"/>, or all zeros if it does not run in the native
+         * plugin, or when not running on Vulkan.</returns>
+         * <remarks>Timestamps are read back a few frames after they are written so that measuring never stalls the
+         * CPU; the first few frames after a context is created or replaced report no samples.</remarks>
+         * <example><code>var timings = upscaler.GetGpuTimings();</code></example>
+         */
+        public GpuTimings GetGpuTimings() => Backend is NativeAbstractBackend backend ? backend.GetGpuTimings() : default;
+
+        /**
+         * <summary>Reads how much GPU time this camera's frame generation preparation has been taking.</summary>
+         * <returns>The timings of the prepare dispatch, or all zeros when frame generation is off or unavailable.</returns>
+         * <remarks>Every window has its own frame generator, so each camera reports only its own work. The
+         * interpolation itself runs on the presentation path and is not included.</remarks>
+         * <example><code>var timings = upscaler.GetFrameGenerationGpuTimings();</code></example>
+         */
+        public GpuTimings GetFrameGenerationGpuTimings() => FgBackend?.GetGpuTimings() ?? default;
+
+        /// Parameters of FSR frame generation's frame pacer. Mirrors <c>FfxApiSwapchainFramePacingTuning</c>.
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FramePacingTuning
+        {
+            /// How early to present before the target time, in milliseconds. FSR's default is <c>0.1</c>.
+            public float SafetyMargin;
+            /// How strongly frame time variance widens the safety margin, from <c>0</c> to <c>1</c>. FSR's default is <c>0.1</c>.
+            public float VarianceFactor;
+            /// Lets the pacer sleep instead of spinning for most of the wait.
+            [MarshalAs(UnmanagedType.U1)] public bool AllowHybridSpin;
+            /// How long to spin before presenting when <see cref="AllowHybridSpin"/> is set, in timer resolution units. FSR's default is <c>2</c>.
+            public uint HybridSpinTime;
+            /// Lets the pacer block on fences instead of spinning on them.
+            [MarshalAs(UnmanagedType.U1)] public bool AllowWaitForSingleObjectOnFence;
+
+            /// FSR's own defaults.
+            public static FramePacingTuning Default => new() { SafetyMargin = 0.1f, VarianceFactor = 0.1f, HybridSpinTime = 2 };
+        }
+
+        /// What frame generation actually presented since the last reset.
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FramePacingReport
+        {
+            /// Application presents recorded.
+            public ulong Presents;
+            /// Frames that reached the swapchain, real and interpolated.
+            public ulong Displayed;
+            /// Interpolated frames that were expected but never presented.
+            public ulong DroppedGenerated;
+            /// The mean time between application presents, in milliseconds.
+            public float MeanInterval;
+            /// The standard deviation of the time between application presents, in milliseconds.
+            public float Jitter;
+            /// The median time between application presents, to the nearest half millisecond.
+            public float P50Interval;
+            /// The time that 99% of the intervals did not exceed, to the nearest half millisecond.
+            public float P99Interval;
+            /// Frames presented per second, real and interpolated.
+            public float OutputRate;
+            /// How many intervals fell into each half-millisecond bin. The last bin also holds every longer interval.
+            [MarshalAs(UnmanagedType.ByValArray, SizeConst = 64)] public uint[] Histogram;
+        }
+
+        private FramePacingTuning? _framePacingTuning;
+
+        /**
+         * <summary>Tunes how FSR frame generation paces the frames it presents for this camera's window.</summary>
+         * <param name="tuning">The new parameters. Start from <see cref="FramePacingTuning.Default"/>.</param>
+         * <remarks>The tuning is kept across swapchain and frame generator recreation.</remarks>
+         * <example><code>var tuning = Upscaler.FramePacingTuning.Default;
+         * tuning.AllowHybridSpin = true;
+         * upscaler.SetFramePacingTuning(tuning);</code></example>
+         */
+        public void SetFramePacingTuning(FramePacingTuning tuning)
+        {
+            _framePacingTuning = tuning;
+            FgBackend?.SetFramePacingTuning(tuning);
+        }
+
+        /**
+         * <summary>Reads what frame generation has presented for this camera's window since the last reset.</summary>
+         * <returns>The report, or all zeros when frame generation is off or unavailable.</returns>
+         * <remarks>Recording restarts whenever the window's swapchain is recreated.</remarks>
+         * <example><code>var report = upscaler.GetFramePacingReport();
+         * Debug.Log($"{report.OutputRate} fps, {report.DroppedGenerated} generated frames dropped");</code></example>
+         */
+        public FramePacingReport GetFramePacingReport() => FgBackend?.GetFramePacingReport() ?? default;
+
+        /// Starts a new <see cref="FramePacingReport"/>.
+        public void ResetFramePacingReport() => FgBackend?.ResetFramePacingReport();
+
+        /// When the frame generation governor turns frame generation off and back on, relative to the display's refresh rate.
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FrameGenerationGovernorSettings
+        {
+            /// While unset, frame generation follows <see cref="frameGeneration"/> exactly.
+            [MarshalAs(UnmanagedType.U1)] public bool Enabled;
+            /// The display's refresh rate in hertz.
+            public float RefreshRate;
+            /// Frame generation turns off when the base frame rate falls below this fraction of <see cref="RefreshRate"/>.
+            public float MinimumBaseRate;
+            /// Frame generation turns off when the base frame rate reaches this fraction of <see cref="RefreshRate"/>. With vertical sync the base frame rate cannot exceed half the refresh rate while generating, so only values up to <c>0.5</c> can take effect then.
+            public float MaximumBaseRate;
+            /// How far inside both thresholds, as a fraction of <see cref="RefreshRate"/>, the base frame rate must be to turn frame generation back on.
+            public float Hysteresis;
+            /// How long, in milliseconds, a change must stay warranted before it is made.
+            public float HoldTime;
+
+            /// Generates between half of and just under the refresh rate of the main display.
+            public static FrameGenerationGovernorSettings Default => new()
+            {
+                Enabled = true, RefreshRate = (float)Screen.currentResolution.refreshRateRatio.value, MinimumBaseRate = 0.5f,
+                MaximumBaseRate = 0.95f, Hysteresis = 0.05f, HoldTime = 500
+            };
+        }
+
+        /// What the frame generation governor has measured and decided.
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FrameGenerationGovernorState
+        {
+            /// Whether the governor currently lets frame generation run.
+            [MarshalAs(UnmanagedType.U1)] public bool Active;
+            /// The smoothed rate at which real frames are presented, in frames per second.
+            public float BaseRate;
+        }
+
+        private FrameGenerationGovernorSettings? _frameGenerationGovernor;
+
+        /**
+         * <summary>Lets the plugin turn frame generation off while the base frame rate is too low for it to help or
+         * high enough that the display cannot show the extra frames.</summary>
+         * <param name="settings">The thresholds. Start from <see cref="FrameGenerationGovernorSettings.Default"/>.</param>
+         * <remarks>The governor only ever withholds frame generation; it never generates while <see cref="frameGeneration"/>
+         * is off. Its decisions are counted in <see cref="PluginStats"/>. The settings are kept across frame generator
+         * recreation.</remarks>
+         * <example><code>upscaler.SetFrameGenerationGovernor(Upscaler.FrameGenerationGovernorSettings.Default);</code></example>
+         */
+        public void SetFrameGenerationGovernor(FrameGenerationGovernorSettings settings)
+        {
+            _frameGenerationGovernor = settings;
+            FgBackend?.SetFrameGenerationGovernor(settings);
+        }
+
+        /// Reads the frame generation governor's current decision, or all zeros when frame generation is off or unavailable.
+        public FrameGenerationGovernorState GetFrameGenerationGovernorState() => FgBackend?.GetFrameGenerationGovernorState() ?? default;
+
+        /// How the dynamic resolution controller steers the input resolution towards a GPU frame time budget.
+        [StructLayout(LayoutKind.Sequential)]
+        public struct DynamicResolutionSettings
+        {
+            /// The GPU time per frame to converge on, in milliseconds.
+            public float TargetFrameTime;
+            public float Proportional;
+            public float Integral;
+            public float Derivative;
+            /// The smallest change of the per-axis scale that is applied, so the input resolution does not wander by a few pixels every frame.
+            public float Step;
+            /// Errors smaller than this fraction of <see cref="TargetFrameTime"/> are ignored, so noise alone does not change the input resolution.
+            public float Tolerance;
+
+            /// Converges on one refresh interval of the main display.
+            public static DynamicResolutionSettings Default => new()
+            {
+                TargetFrameTime = 1000 / (float)Screen.currentResolution.refreshRateRatio.value, Proportional = 0.1f,
+                Integral = 0.3f, Derivative = 0.05f, Step = 0.02f, Tolerance = 0.04f
+            };
+        }
+
+        /// What the dynamic resolution controller has measured and picked.
+        [StructLayout(LayoutKind.Sequential)]
+        public struct DynamicResolutionState
+        {
+            /// The input resolution that the controller picked, or zero before it has been given bounds.
+            public Vector2Int Resolution;
+            /// The per-axis scale of <see cref="Resolution"/> relative to <see cref="MaxInputResolution"/>.
+            public float Scale;
+            /// The most recent GPU frame time, in milliseconds.
+            public float FrameTime;
+            /// <see cref="FrameTime"/> as predicted for the input resolution that is now being rendered.
+            public float PredictedFrameTime;
+            /// The relative distance from <see cref="DynamicResolutionSettings.TargetFrameTime"/>: positive with time to spare, negative when over budget.
+            public float Error;
+        }
+
+        private IntPtr _dynamicResolution;
+        private DynamicResolutionSettings? _dynamicResolutionSettings;
+
+        /**
+         * <summary>Lets the plugin pick <see cref="InputResolution"/> every frame, between
+         * <see cref="MinInputResolution"/> and <see cref="MaxInputResolution"/>, so that the camera's GPU time converges
+         * on a budget.</summary>
+         * <param name="settings">The budget and controller gains. Start from <see cref="DynamicResolutionSettings.Default"/>.</param>
+         * <remarks>GPU time is measured with timestamps from the start of the camera's rendering to the end of upscaling,
+         * which the plugin only records on Vulkan; elsewhere the input resolution stays at <see cref="MaxInputResolution"/>.
+         * Measurements arrive a few frames late and are corrected for the resolution changes made since. Changing the
+         * quality or the output resolution restarts the controller from <see cref="MaxInputResolution"/>. The settings are
+         * kept while this component is disabled.</remarks>
+         * <example><code>var settings = Upscaler.DynamicResolutionSettings.Default;
+         * settings.TargetFrameTime = 8.3f;
+         * upscaler.SetDynamicResolutionController(settings);</code></example>
+         */
+        public void SetDynamicResolutionController(DynamicResolutionSettings settings)
+        {
+            _dynamicResolutionSettings = settings;
+            if (_dynamicResolution == IntPtr.Zero) _dynamicResolution = NativeInterface.CreateDynamicResolution(settings);
+            else NativeInterface.ConfigureDynamicResolution(_dynamicResolution, settings, MinInputResolution, MaxInputResolution);
+        }
+
+        /// Hands <see cref="InputResolution"/> back to the application.
+        public void DisableDynamicResolutionController()
+        {
+            _dynamicResolutionSettings = null;
+            NativeInterface.DestroyDynamicResolution(_dynamicResolution);
+            _dynamicResolution = IntPtr.Zero;
+        }
+
+        /// Reads the dynamic resolution controller's latest measurement and decision, or all zeros when it is disabled.
+        public DynamicResolutionState GetDynamicResolutionState() => NativeInterface.GetDynamicResolutionState(_dynamicResolution, MinInputResolution, MaxInputResolution);
+
+        /**
+         * <summary>Runs a fresh dynamic resolution controller over a recorded trace of GPU frame times, for tuning its
+         * settings offline.</summary>
+         * <param name="trace">GPU frame times in milliseconds, recorded at <paramref name="maximum"/>.</param>
+         * <param name="settings">The settings to evaluate.</param>
+         * <param name="minimum">The smallest input resolution the controller may pick.</param>
+         * <param name="maximum">The input resolution that <paramref name="trace"/> was recorded at.</param>
+         * <param name="latency">How many frames late each frame time reaches the controller. The plugin measures with a latency of 5.</param>
+         * <param name="fixedShare">The share of each frame time that does not depend on the input resolution.</param>
+         * <param name="states">Receives the controller's state after every frame, or <c>null</c>.</param>
+         * <returns>How many frames of the simulated run went over <see cref="DynamicResolutionSettings.TargetFrameTime"/>.</returns>
+         * <example><code>var overruns = Upscaler.ReplayDynamicResolution(trace, settings, new Vector2Int(960, 540), new Vector2Int(1920, 1080), 5, 0.2f, null);</code></example>
+         */
+        public static uint ReplayDynamicResolution(float[] trace, DynamicResolutionSettings settings, Vector2Int minimum, Vector2Int maximum, uint latency, float fixedShare, DynamicResolutionState[] states) =>
+            NativeInterface.ReplayDynamicResolution(trace, settings, minimum, maximum, latency, fixedShare, states);
+
+        internal void BeginFrameTiming(CommandBuffer commandBuffer) => NativeInterface.BeginFrameTiming(commandBuffer, _dynamicResolution);
+
+        internal void EndFrameTiming(CommandBuffer commandBuffer) => NativeInterface.EndFrameTiming(commandBuffer, _dynamicResolution);
+
+        /**
+         * <summary>Writes the native plugin's CPU trace to a file.</summary>
+         * <param name="path">Where to write the trace, in the Chrome trace event format.</param>
+         * <returns><c>true</c> if the trace was written, or <c>false</c> if the native plugin was built without
+         * <c>ENABLE_TRACING</c> or the file could not be written.</returns>
+         * <remarks>The trace holds the most recent render thread callbacks and Vulkan swapchain hooks of every thread that
+         * entered them. Open it in <c>chrome://tracing</c> or <c>ui.perfetto.dev</c>.</remarks>
+         * <example><code>Upscaler.DumpNativeTrace(Path.Combine(Application.persistentDataPath, "Upscaler.json"));</code></example>
+         */
+        public static bool DumpNativeTrace(string path) => NativeInterface.DumpTrace(path);
+
+        /// The most detailed messages that the native plugin sends to the console.
+        public enum NativeLogLevel : byte
+        {
+            Error,
+            Warning,
+            Info,
+            Verbose
+        }
+
+        /**
+         * <summary>Sets which messages from the native plugin and the SDKs it loads reach the console.</summary>
+         * <param name="level">The most detailed level to log. Defaults to <see cref="NativeLogLevel.Warning"/>.</param>
+         * <remarks>Repeated messages are collapsed into a count and each SDK may only log a few messages per second, so
+         * some messages may be reported as suppressed. DLSS and XeSS only produce verbose messages when the level is
+         * <see cref="NativeLogLevel.Verbose"/> before their context is created.</remarks>
+         * <example><code>Upscaler.SetNativeLogLevel(Upscaler.NativeLogLevel.Verbose);</code></example>
+         */
+        public static void SetNativeLogLevel(NativeLogLevel level) => NativeInterface.SetLogLevel(level);
+
         public UpscalerBackend.Flags PreviousFlags;
 
         private bool InternalApplySettings(UpscalerBackend.Flags flags)
@@ -505,6 +925,7 @@ namespace Upscaler.Runtime
                     },
                     _ => throw new ArgumentOutOfRangeException(nameof(technique), technique, technique + " is not a valid " + nameof(technique) + " enum value.")
                 };
+                if (technique != PreviousTechnique) NativeInterface.UnloadUnused();
                 if (Backend == null && technique != Technique.None)
                 {
                     Debug.LogError("Attempted to use unsupported " + nameof(Technique) + ": " + technique);
@@ -518,11 +939,13 @@ namespace Upscaler.Runtime
 #endif
             frameGeneration &= FrameGeneratorBackend.Supported;
 #if !UNITY_6000_0_OR_NEWER
-            if (needsUpdate || frameGeneration != PreviousFrameGeneration)
+            if (needsUpdate || frameGeneration != PreviousFrameGeneration || (frameGeneration && hudlessBufferCount != PreviousHudlessBufferCount))
             {
                 needsUpdate = true;
                 FgBackend?.Dispose();
-                FgBackend = frameGeneration ? new FrameGeneratorBackend(Camera.targetDisplay) : null;
+                FgBackend = frameGeneration ? new FrameGeneratorBackend(Camera.targetDisplay, hudlessBufferCount) : null;
+                if (FgBackend != null && _framePacingTuning.HasValue) FgBackend.SetFramePacingTuning(_framePacingTuning.Value);
+                if (FgBackend != null && _frameGenerationGovernor.HasValue) FgBackend.SetFrameGenerationGovernor(_frameGenerationGovernor.Value);
                 if (FgBackend == null && frameGeneration)
                 {
                     Debug.LogError("Frame generation is not supported.");
@@ -532,14 +955,26 @@ namespace Upscaler.Runtime
             }
 #endif
 
-            needsUpdate |= quality != PreviousQuality || OutputResolution != PreviousOutputResolution || _hdr != Camera.allowHDR;
+            needsUpdate |= quality != PreviousQuality || OutputResolution != PreviousOutputResolution || _hdr != Camera.allowHDR || fixedAllocation != PreviousFixedAllocation;
             if (needsUpdate)
             {
                 if (Failure(CurrentStatus = Backend?.ComputeInputResolutionConstraints(this, flags) ?? Status.Success)) return false;
                 InputResolution = RecommendedInputResolution;
             }
+            else if (Backend?.CompleteContextUpdate(this, out var status) ?? false)
+            {
+                if (Failure(CurrentStatus = status)) return false;
+                InputResolution = RecommendedInputResolution;
+                shouldHistoryResetThisFrame = true;
+                needsUpdate = true;
+            }
+            if (_dynamicResolution != IntPtr.Zero && Backend != null)
+            {
+                var resolution = NativeInterface.GetDynamicResolutionState(_dynamicResolution, MinInputResolution, MaxInputResolution).Resolution;
+                if (resolution != Vector2Int.zero) InputResolution = resolution;
+            }
             return needsUpdate ||
-                   InputResolution != PreviousInputResolution ||
+                   (!UsesFixedAllocation && InputResolution != PreviousInputResolution) ||
                    (technique == Technique.DeepLearningSuperSampling && preset != PreviousPreset) ||
                    (technique == Technique.SnapdragonGameSuperResolution1 && useEdgeDirection != PreviousUseEdgeDirection) ||
                    (technique == Technique.FidelityFXSuperResolution && (
@@ -585,6 +1020,8 @@ namespace Upscaler.Runtime
             PreviousReactiveThreshold = reactiveThreshold;
             PreviousFrameGeneration = frameGeneration;
             PreviousUseAsyncCompute = useAsyncCompute;
+            PreviousHudlessBufferCount = hudlessBufferCount;
+            PreviousFixedAllocation = fixedAllocation;
             PreviousFlags = flags;
             _hdr = Camera.allowHDR;
 
@@ -601,11 +1038,16 @@ namespace Upscaler.Runtime
             if (SystemInfo.supportsMotionVectors) Camera.depthTextureMode |= DepthTextureMode.MotionVectors | DepthTextureMode.Depth;
             Camera.ResetProjectionMatrix();
             PreviousFrameGeneration = !frameGeneration;
+            if (_dynamicResolutionSettings.HasValue) _dynamicResolution = NativeInterface.CreateDynamicResolution(_dynamicResolutionSettings.Value);
             _stale = true;
         }
 
         private void OnDisable()
         {
+            NativeInterface.DestroyDynamicResolution(_dynamicResolution);
+            _dynamicResolution = IntPtr.Zero;
+            NativeInterface.DestroyJitterSequence(_jitterSequence);
+            _jitterSequence = IntPtr.Zero;
             Backend?.Dispose();
             Backend = null;
             if (_source != null && _source.IsCreated()) _source.Release();
@@ -634,22 +1076,10 @@ namespace Upscaler.Runtime
         private static readonly int MotionVectorsID = Shader.PropertyToID("_CameraMotionVectorsTexture");
         private CommandBuffer _generateOpaque;
         private CommandBuffer _cleanupOpaque;
+        private CommandBuffer _beginFrameTiming;
         private RenderTexture _source;
         private RenderTexture _destination;
 
-        private static float HaltonSequence(int n, int b)
-        {
-            var result = 0f;
-            var f = 1f / b;
-            while (n > 0)
-            {
-                result += n % b * f;
-                n /= b;
-                f /= b;
-            }
-            return result;
-        }
-
         private void OnPreCull()
         {
             var previousTechnique = PreviousTechnique;
@@ -674,7 +1104,7 @@ namespace Upscaler.Runtime
                 };
                 _destination.Create();
                 if (_source != null && _source.IsCreated()) _source.Release();
-                _source = new RenderTexture(InputResolution.x, InputResolution.y, 0, cameraTargetFormat);
+                _source = new RenderTexture(AllocatedInputResolution.x, AllocatedInputResolution.y, 0, cameraTargetFormat);
                 _source.Create();
                 if (Failure(CurrentStatus = Backend.Update(this, _source, _destination, UpscalerBackend.Flags.None))) return;
                 if ((previousTechnique == Technique.SnapdragonGameSuperResolution2 && previousMethod == Method.Compute3Pass) ||
@@ -692,7 +1122,7 @@ namespace Upscaler.Runtime
                     {
                         _generateOpaque = new CommandBuffer();
                         _generateOpaque.name = "Upscaler | Copy Opaque";
-                        _generateOpaque.GetTemporaryRT(OpaqueID, InputResolution.x, InputResolution.y, 0, FilterMode.Point, cameraTargetFormat);
+                        _generateOpaque.GetTemporaryRT(OpaqueID, -1, -1, 0, FilterMode.Point, cameraTargetFormat);
                         _generateOpaque.CopyTexture(BuiltinRenderTextureType.CurrentActive, OpaqueID);
                         Camera.AddCommandBuffer(CameraEvent.AfterSkybox, _generateOpaque);
                     }
@@ -707,9 +1137,16 @@ namespace Upscaler.Runtime
             }
             Camera.rect = new Rect(0, 0, (float)InputResolution.x / OutputResolution.x, (float)InputResolution.y / OutputResolution.y);
 
+            if (_dynamicResolution != IntPtr.Zero)
+            {
+                _beginFrameTiming ??= new CommandBuffer { name = "Upscaler | Begin Frame Timing" };
+                _beginFrameTiming.Clear();
+                BeginFrameTiming(_beginFrameTiming);
+                Graphics.ExecuteCommandBuffer(_beginFrameTiming);
+            }
+
             if (IsSpatial()) return;
-            Jitter = new Vector2(HaltonSequence(JitterIndex, 2), HaltonSequence(JitterIndex, 3));
-            JitterIndex = (JitterIndex + 1) % (int)Math.Ceiling(8 * Math.Pow((float)OutputResolution.x / InputResolution.x, 2));
+            AdvanceJitter();
             var clipSpaceJitter = Jitter / InputResolution * 2;
             Camera.ResetProjectionMatrix();
             Camera.nonJitteredProjectionMatrix = Camera.projectionMatrix;
@@ -733,9 +1170,12 @@ namespace Upscaler.Runtime
             if (Backend == null || technique == Technique.None) return;
             Camera.rect = new Rect(0, 0, 1, 1);
 
-            Graphics.Blit(Camera.activeTexture, _source);
+            var source = Camera.activeTexture;
+            if (UsesFixedAllocation) Graphics.Blit(source, _source, new Vector2((float)_source.width / source.width, (float)_source.height / source.height), Vector2.zero);
+            else Graphics.Blit(source, _source);
             var commandBuffer = new CommandBuffer();
             Backend.Upscale(this, commandBuffer, Shader.GetGlobalTexture(DepthID), Shader.GetGlobalTexture(MotionVectorsID), Shader.GetGlobalTexture(OpaqueID));
+            EndFrameTiming(commandBuffer);
             Graphics.ExecuteCommandBuffer(commandBuffer);
             commandBuffer.Release();
         }